@@ -221,7 +221,7 @@ typedef struct CyAllocator CyAllocator;
 #define U64_MIN 0U
 #define U64_MAX 0xFFFFFFFFFFFFFFFFULL
 #define I64_MIN (-0x7FFFFFFFFFFFFFFFLL - 1)
-#define I64_MAX 0x7FFFFFFFFFFFFFFFFLL
+#define I64_MAX 0x7FFFFFFFFFFFFFFFLL
 
 #define F32_MIN 1.17549435e-38F
 #define F32_MAX 3.40282347e+38F
@@ -255,12 +255,33 @@ typedef i32 Rune; // Unicode codepoint
 #define cy_internal static
 #define cy_persist static
 
+#if defined(CY_COMPILER_MSVC)
+    #define cy_thread_local __declspec(thread)
+#else
+    #define cy_thread_local __thread
+#endif
+
 // TODO(cya): force inline
 #define cy_inline inline
 
+// NOTE(cya): for cold paths that shouldn't get folded into hot loops
+#if defined(CY_COMPILER_MSVC)
+    #define cy_no_inline __declspec(noinline)
+#else
+    #define cy_no_inline __attribute__((noinline))
+#endif
+
 // NOTE(cya): so we don't have implicit changes in signedness
 #define cy_sizeof(x) (isize)(sizeof(x))
 
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define cy_alignof(type) (isize)(_Alignof(type))
+#elif defined(CY_COMPILER_MSVC)
+    #define cy_alignof(type) (isize)(__alignof(type))
+#else
+    #define cy_alignof(type) (isize)(__alignof__(type))
+#endif
+
 /* ================================= Runtime ================================ */
 #ifndef CY_OS_WINDOWS
     #include <stdarg.h>  // va_args
@@ -525,6 +546,10 @@ CY_DEF char *cy_aprintf_va(CyAllocator a, const char *fmt, va_list va);
  *     (lower/uppercase)
  *   %v: takes in a CyStringView, outputs its text
  *   %b: takes in an unsigned int, outputs it in base 2 (binary)
+ *   %r, %R: takes in a double, outputs the shortest representation that reads
+ *     back as the exact same value (%g's notation, up to 17 digits)
+ *   %{name}: takes in a pointer, passes it to the formatter registered for
+ *     `name` with cy_format_register (e.g.: %{ip}, %-12{dur})
  *
  * Explicit-sized integers:
  *   You can explicitly size any integer input flag by appending its size to it
@@ -572,6 +597,8 @@ typedef enum {
     CY_ALLOCATION_FREE,
     CY_ALLOCATION_FREE_ALL,
     CY_ALLOCATION_RESIZE,
+    // NOTE(cya): old_mem is a void*[old_size] that receives the allocations
+    CY_ALLOCATION_ALLOC_BATCH,
 } CyAllocationType;
 
 typedef enum {
@@ -603,8 +630,26 @@ struct CyAllocator {
     (new_count) * cy_sizeof(type) \
 )
 
+// NOTE(cya): typed allocations using the natural alignment of the type
+// (pools still need the chunk alignment, use cy_alloc_item on those)
+#define cy_push_struct(allocator, type) (type*)cy_alloc_align( \
+    allocator, cy_sizeof(type), cy_alignof(type) \
+)
+#define cy_push_array(allocator, type, count) (type*)cy_alloc_align( \
+    allocator, (count) * cy_sizeof(type), cy_alignof(type) \
+)
+/* Allocates `count` separate items (each one can be freed on its own) in a
+ * single call to the allocator proc, storing them in `ptrs` (a type*[count]) */
+#define cy_alloc_batch(allocator, type, ptrs, count) cy_alloc_batch_align( \
+    allocator, (void**)(ptrs), count, cy_sizeof(type), cy_alignof(type) \
+)
+
 CY_DEF void *cy_alloc_align(CyAllocator a, isize size, isize align);
 CY_DEF void *cy_alloc(CyAllocator a, isize size);
+// NOTE(cya): all-or-nothing, returns NULL if not every item fits
+CY_DEF void **cy_alloc_batch_align(
+    CyAllocator a, void **ptrs, isize count, isize size, isize align
+);
 CY_DEF void cy_free(CyAllocator a, void *ptr);
 CY_DEF void cy_free_all(CyAllocator a);
 CY_DEF void *cy_resize_align(
@@ -620,6 +665,11 @@ CY_DEF void *cy_default_resize_align(
 CY_DEF void *cy_default_resize(
     CyAllocator a, void *ptr, isize old_size, isize new_size
 );
+// NOTE(cya): batch allocation by looping over single ones (for procs that
+// don't have anything smarter to do)
+CY_DEF void **cy_default_alloc_batch_align(
+    CyAllocator a, void **ptrs, isize count, isize size, isize align
+);
 CY_DEF void *cy_alloc_copy_align(
     CyAllocator a, const void *src, isize size, isize align
 );
@@ -633,6 +683,17 @@ CY_DEF char *cy_alloc_string(CyAllocator a, const char *str);
 #define CY__HAS_ZERO_BYTE(n) \
     !!(((usize)(n) - CY__LO_ONES) & ~(usize)(n) & CY__HI_ONES)
 
+// NOTE(cya): same thing for 16-bit and 32-bit lanes (e.g.: wchar_t)
+#define CY__LO_ONES_16 ((usize)-1 / U16_MAX)
+#define CY__HI_ONES_16 (CY__LO_ONES_16 * (U16_MAX / 2 + 1))
+#define CY__HAS_ZERO_U16(n) \
+    !!(((usize)(n) - CY__LO_ONES_16) & ~(usize)(n) & CY__HI_ONES_16)
+
+#define CY__LO_ONES_32 ((usize)-1 / U32_MAX)
+#define CY__HI_ONES_32 (CY__LO_ONES_32 * (U32_MAX / 2 + 1))
+#define CY__HAS_ZERO_U32(n) \
+    !!(((usize)(n) - CY__LO_ONES_32) & ~(usize)(n) & CY__HI_ONES_32)
+
 #define CY_MIN(a, b) (a < b ? a : b)
 #define CY_MAX(a, b) (a > b ? a : b)
 
@@ -677,6 +738,7 @@ CY_DEF CyAllocator cy_virtual_memory_allocator(void);
 typedef struct {
     CyMemoryBlock *cur_block;
     CyAllocator backing;
+    isize temp_count;
 } CyArena;
 
 CY_DEF CyAllocatorProc cy_arena_allocator_proc;
@@ -686,17 +748,94 @@ CY_DEF CyMemoryBlock *cy_arena_insert_block(CyArena *arena, isize size);
 CY_DEF CyArena cy_arena_init(CyAllocator backing, isize initial_size);
 CY_DEF void cy_arena_deinit(CyArena *arena);
 
+// NOTE(cya): chains a new block big enough for the allocation (slow path)
+CY_DEF void *cy_arena_push_slow(CyArena *arena, isize size, isize align);
+
+/* Bump allocation straight from the arena's current block without going
+ * through the allocator proc (memory is NOT cleared, see cy_arena_push_zero),
+ * only falls back to an out-of-line call when the block runs out of space */
+cy_internal cy_inline void *cy_arena_push(
+    CyArena *arena, isize size, isize align
+) {
+    CyMemoryBlock *block = arena->cur_block;
+    uintptr start = (uintptr)block->start;
+    uintptr mask = (uintptr)align - 1;
+    uintptr aligned_end = (start + (uintptr)block->offset + mask) & ~mask;
+    isize aligned_offset = (isize)(aligned_end - start);
+    if (aligned_offset + size > block->size) {
+        return cy_arena_push_slow(arena, size, align);
+    }
+
+    block->prev_offset = aligned_offset;
+    block->offset = aligned_offset + size;
+    return (void*)aligned_end;
+}
+
+cy_internal cy_inline void *cy_arena_push_zero(
+    CyArena *arena, isize size, isize align
+) {
+    void *ptr = cy_arena_push(arena, size, align);
+    return (ptr == NULL) ? NULL : cy_mem_zero(ptr, size);
+}
+
+#define cy_arena_push_struct(arena, type) \
+    (type*)cy_arena_push_zero(arena, cy_sizeof(type), cy_alignof(type))
+#define cy_arena_push_array(arena, type, count) (type*)cy_arena_push_zero( \
+    arena, (count) * cy_sizeof(type), cy_alignof(type) \
+)
+
+/* Snapshot of an arena's position, everything allocated after
+ * cy_arena_temp_begin gets released by the matching cy_arena_temp_end
+ * (including any blocks chained to the arena in between) */
+typedef struct {
+    CyArena *arena;
+    CyMemoryBlock *block;
+    isize offset;
+    isize prev_offset;
+} CyArenaTemp;
+
+CY_DEF CyArenaTemp cy_arena_temp_begin(CyArena *arena);
+CY_DEF void cy_arena_temp_end(CyArenaTemp temp);
+
+/* Per-thread scratch arenas: pass the arenas you're already using (e.g. the
+ * one your caller gave you to return results in) as conflicts and you'll get
+ * a temp scope on a different one, so nested scratch usage never clobbers */
+#ifndef CY_ARENA_SCRATCH_COUNT
+    #define CY_ARENA_SCRATCH_COUNT 2
+#endif
+
+CY_DEF CyArenaTemp cy_arena_scratch_begin(
+    CyArena *const *conflicts, isize conflict_count
+);
+CY_DEF void cy_arena_scratch_end(CyArenaTemp temp);
+// NOTE(cya): releases the calling thread's scratch arenas
+CY_DEF void cy_arena_scratch_release(void);
+
 /* ----------------------------- Stack Allocator ---------------------------- */
 typedef struct CyStackNode {
     u8 *buf;
     isize size;
-    isize prev_offset;
     isize offset;
     struct CyStackNode *next;
 } CyStackNode;
 
+/* Usage stats for tuning the node sizes (e.g. CY_STACK_DEFAULT_SIZE),
+ * `reserved - used` is the slack left at the end of older nodes and
+ * `pending_free` the memory freed out of order that isn't reclaimed yet */
+typedef struct {
+    isize used; // NOTE(cya): including headers and padding
+    isize reserved;
+    isize pending_free;
+    isize nodes;
+    isize peak_used;
+    isize peak_reserved;
+    isize peak_nodes;
+} CyStackStats;
+
 typedef struct {
     CyStackNode *first_node;
+    void *top; // NOTE(cya): latest live allocation
+    CyStackStats stats;
 } CyStackState;
 
 typedef struct {
@@ -705,8 +844,11 @@ typedef struct {
 } CyStack;
 
 typedef struct {
+    CyStackNode *node; // NOTE(cya): node owning the allocation
+    void *prev; // NOTE(cya): allocation right below this one (in any node)
     isize prev_offset;
-    isize padding;
+    isize size;
+    b32 freed; // NOTE(cya): freed out of order, reclaimed once it's on top
 } CyStackHeader;
 
 CY_DEF CyAllocatorProc cy_stack_allocator_proc;
@@ -715,6 +857,7 @@ CY_DEF CyAllocator cy_stack_allocator(CyStack *stack);
 CY_DEF CyStackNode *cy_stack_insert_node(CyStack *stack, isize size);
 CY_DEF CyStack cy_stack_init(CyAllocator backing, isize initial_size);
 CY_DEF void cy_stack_deinit(CyStack *stack);
+CY_DEF CyStackStats cy_stack_stats(const CyStack *stack);
 
 /* ----------------------------- Pool Allocator ----------------------------- */
 typedef struct {
@@ -735,6 +878,80 @@ CY_DEF CyPool cy_pool_init_align(
 );
 CY_DEF void cy_pool_deinit(CyPool *pool);
 
+/* --------------------------- Tracking Allocator --------------------------- */
+/**
+ * Wraps any allocator and keeps count of the calls, the bytes in flight and
+ * their peak, both in total and per call site (source file and line)
+ *
+ * Call sites get captured by defining CY_TRACK_ALLOCATIONS before including
+ * this header, which turns cy_alloc, cy_alloc_align, cy_resize,
+ * cy_resize_align and cy_alloc_batch_align (and everything built on them,
+ * like cy_alloc_item) into macros that record __FILE__ and __LINE__ for the
+ * next allocation on the calling thread. Otherwise everything is reported
+ * under a single unknown site
+ *
+ * NOTE: not thread-safe, use one tracker per thread
+ */
+#ifndef CY_ALLOC_TRACKER_MAX_SITES
+    #define CY_ALLOC_TRACKER_MAX_SITES 256 // NOTE(cya): must be a power of 2
+#endif
+
+CY_STATIC_ASSERT(
+    (CY_ALLOC_TRACKER_MAX_SITES & (CY_ALLOC_TRACKER_MAX_SITES - 1)) == 0
+);
+
+typedef struct {
+    const char *file;
+    i32 line;
+    isize allocs;
+    isize resizes;
+    isize bytes_total;
+    isize bytes_in_flight;
+    isize peak_bytes;
+} CyAllocSite;
+
+typedef struct {
+    CyAllocator backing;
+    isize alloc_count;
+    isize free_count;
+    isize resize_count;
+    isize bytes_total;
+    isize bytes_in_flight;
+    isize peak_bytes;
+    // NOTE(cya): hash table (last slot is the overflow), lives on the heap so
+    // a free_all on the backing allocator can't reclaim it
+    CyAllocSite *sites;
+} CyAllocTracker;
+
+CY_DEF CyAllocatorProc cy_alloc_tracker_allocator_proc;
+CY_DEF CyAllocator cy_alloc_tracker_allocator(CyAllocTracker *tracker);
+
+CY_DEF CyAllocTracker cy_alloc_tracker_init(CyAllocator backing);
+CY_DEF void cy_alloc_tracker_deinit(CyAllocTracker *tracker);
+// NOTE(cya): prints the totals and every site (by bytes in flight)
+CY_DEF void cy_alloc_tracker_report(const CyAllocTracker *tracker);
+
+CY_DEF void cy__alloc_site_set(const char *file, i32 line);
+
+#if defined(CY_TRACK_ALLOCATIONS)
+    #define CY__WITH_ALLOC_SITE(call) \
+        (cy__alloc_site_set(__FILE__, (i32)__LINE__), call)
+
+    #define cy_alloc_align(a, size, align) \
+        CY__WITH_ALLOC_SITE((cy_alloc_align)(a, size, align))
+    #define cy_alloc(a, size) CY__WITH_ALLOC_SITE((cy_alloc)(a, size))
+    #define cy_resize_align(a, ptr, old_size, new_size, align) \
+        CY__WITH_ALLOC_SITE( \
+            (cy_resize_align)(a, ptr, old_size, new_size, align) \
+        )
+    #define cy_resize(a, ptr, old_size, new_size) \
+        CY__WITH_ALLOC_SITE((cy_resize)(a, ptr, old_size, new_size))
+    #define cy_alloc_batch_align(a, ptrs, count, size, align) \
+        CY__WITH_ALLOC_SITE( \
+            (cy_alloc_batch_align)(a, ptrs, count, size, align) \
+        )
+#endif
+
 // TODO(cya):
 // * discover a nice interace to implement different OOM handling behaviors to
 // * the basic allocators (static buf, linked list and pre-reserve/commit)
@@ -747,6 +964,104 @@ CY_DEF void cy_pool_deinit(CyPool *pool);
 // * general-purpose heap allocator composed of the basic ones to replace malloc
 //   (final boss i guess - maybe implement one like TCMalloc?)
 
+/* ===================== Format strings (pre-compiled) ====================== */
+/**
+ * Pre-compiled format strings: cy_format_compile parses a format string once
+ * into a list of ops (literal runs and conversion specs) that can then be run
+ * against the arguments with cy_sprintf_compiled, skipping all the parsing of
+ * flags, widths, length modifiers and extended specifiers on every call
+ *
+ * NOTE: the format string isn't copied, so it must outlive the CyFormat (this
+ * is meant for constant format strings anyway), and if the op list can't be
+ * allocated the format string is just parsed on every call as usual
+ */
+typedef struct CyPrivFmtOp CyPrivFmtOp;
+typedef struct {
+    CyAllocator alloc;
+    const char *fmt;
+    CyPrivFmtOp *ops;
+    isize op_count;
+} CyFormat;
+
+CY_DEF CyFormat cy_format_compile(const char *fmt);
+CY_DEF CyFormat cy_format_compile_alloc(CyAllocator a, const char *fmt);
+CY_DEF void cy_format_free(CyFormat *fmt);
+
+CY_DEF isize cy_sprintf_compiled(
+    char *buf, isize size, const CyFormat *fmt, ...
+);
+CY_DEF isize cy_sprintf_compiled_va(
+    char *buf, isize size, const CyFormat *fmt, va_list va
+);
+
+/*
+ * Custom format specifiers: cy_format_register binds a name to a formatter
+ * proc, and from then on every %{name} in a format string consumes a pointer
+ * argument and hands it to that proc, which writes its text straight into the
+ * output (the same writer the rest of the string goes to) with the
+ * cy_format_write* procs
+ *
+ * The proc gets the spec's width and precision (-1 when not specified) and
+ * takes care of any padding itself (cy_format_write_fill helps with that)
+ *
+ * NOTE: the name isn't copied, and registering isn't thread-safe, so do it at
+ * startup (registering a name again replaces its proc)
+ */
+typedef struct CyPrivFmtWriter CyFormatWriter;
+
+typedef struct {
+    i32 width;
+    i32 precision;
+    b32 left_align;
+} CyFormatOptions;
+
+#define CY_FORMAT_PROC(name) void name( \
+    CyFormatWriter *w, const void *arg, const CyFormatOptions *opts \
+)
+typedef CY_FORMAT_PROC(CyFormatProc);
+
+CY_DEF b32 cy_format_register(const char *name, CyFormatProc *proc);
+
+CY_DEF void cy_format_write(CyFormatWriter *w, const char *src, isize len);
+CY_DEF void cy_format_write_c(CyFormatWriter *w, const char *str);
+CY_DEF void cy_format_write_fill(CyFormatWriter *w, char c, isize count);
+CY_DEF b32 cy_format_writef(
+    CyFormatWriter *w, const char *fmt, ...
+) CY__FMT_ATTR(2);
+CY_DEF b32 cy_format_writef_va(CyFormatWriter *w, const char *fmt, va_list va);
+
+/* ============================ Deferred logging ============================ */
+/**
+ * Deferred logging: cy_log doesn't format anything, it just packs the format
+ * string pointer and the raw arguments into the calling thread's ring buffer
+ * (lock-free, one producer and one consumer), and the actual formatting is
+ * done by cy_log_drain, which renders everything logged so far to a file
+ * (call it from a background thread, at the end of each frame, etc.)
+ *
+ * Each thread that logs needs its own buffer from cy_log_thread_init; when a
+ * log doesn't fit in it (or the thread has none) it's dropped and counted
+ *
+ * NOTE: the format strings (and CyFormats) have to outlive the drain, so they
+ * should be constants. Strings passed to %s and %v are copied into the buffer
+ * but %{name} arguments are stored as pointers, so what they point to has to
+ * outlive the drain as well. %n specs are ignored, and only one thread should
+ * drain at a time
+ */
+#ifndef CY_LOG_MAX_ARGS
+    #define CY_LOG_MAX_ARGS 32
+#endif
+
+CY_DEF b32 cy_log_thread_init(CyAllocator a, isize size);
+CY_DEF void cy_log_thread_deinit(void);
+
+CY_DEF b32 cy_log(const char *fmt, ...) CY__FMT_ATTR(1);
+CY_DEF b32 cy_log_va(const char *fmt, va_list va);
+CY_DEF b32 cy_log_compiled(const CyFormat *fmt, ...);
+CY_DEF b32 cy_log_compiled_va(const CyFormat *fmt, va_list va);
+
+CY_DEF isize cy_log_drain(CyFile *f);
+CY_DEF u64 cy_log_dropped_count(void);
+
 /* ============================== Char procs ================================ */
 CY_DEF const char *cy_char_first_occurence(const char *str, char c);
 CY_DEF const char *cy_char_last_occurence(const char *str, char c);
@@ -760,6 +1075,24 @@ CY_DEF b32 cy_char_is_upper(char c);
 
 CY_DEF b32 cy_char_is_in_set(char c, const char *cut_set);
 
+/*
+ * Char sets: a bitmap of all 256 byte values, built once so that searching,
+ * spanning, trimming and tokenizing by a set of chars only has to look each
+ * byte up (16-32 bytes at a time with SSE2/AVX2) instead of going through the
+ * whole list of chars for every single one
+ */
+typedef struct {
+    u64 bits[4];
+    u8 nibbles[2][16]; // NOTE(cya): the same bitmap laid out for pshufb
+    u8 chars[16]; // NOTE(cya): for SSE2 compares (up to 16 chars)
+    i32 char_count;
+} CyCharSet;
+
+CY_DEF CyCharSet cy_char_set_create(const char *chars);
+CY_DEF CyCharSet cy_char_set_create_len(const char *chars, isize len);
+CY_DEF void cy_char_set_add(CyCharSet *set, u8 c);
+CY_DEF b32 cy_char_set_has(const CyCharSet *set, u8 c);
+
 CY_DEF char cy_char_to_lower(char c);
 CY_DEF char cy_char_to_upper(char c);
 
@@ -783,8 +1116,26 @@ CY_DEF char *cy_str_reverse_n(char *str, isize len);
 CY_DEF void cy_str_to_lower(char *str);
 CY_DEF void cy_str_to_upper(char *str);
 
+typedef enum {
+    CY_PARSE_ERROR_NONE,
+    CY_PARSE_ERROR_INVALID,
+    CY_PARSE_ERROR_OVERFLOW,
+} CyParseError;
+
+CY_DEF const char *cy_parse_error_as_str(CyParseError err);
+
+/*
+ * Base 0 picks 16 for numbers with a "0x" prefix and 10 otherwise. On overflow
+ * the value saturates (to U64_MAX, I64_MIN or I64_MAX)
+ */
 CY_DEF u64 cy_str_to_u64(const char *str, i32 base, isize *len_out);
 CY_DEF i64 cy_str_to_i64(const char *str, i32 base, isize *len_out);
+CY_DEF CyParseError cy_str_to_u64_report(
+    const char *str, i32 base, u64 *value, isize *len_out
+);
+CY_DEF CyParseError cy_str_to_i64_report(
+    const char *str, i32 base, i64 *value, isize *len_out
+);
 
 CY_DEF isize cy_str_parse_u64(u64 n, i32 base, char *dst);
 CY_DEF isize cy_str_parse_i64(i64 n, i32 base, char *dst);
@@ -834,6 +1185,9 @@ CY_DEF CyString cy_string_append_rune(CyString str, Rune r);
 CY_DEF CyString cy_string_append_fmt(
     CyString str, const char *fmt, ...
 ) CY__FMT_ATTR(2);
+CY_DEF CyString cy_string_append_fmt_va(
+    CyString str, const char *fmt, va_list va
+);
 CY_DEF CyString cy_string_append_view(CyString str, CyStringView view);
 CY_DEF CyString cy_string_prepend_len(
     CyString str, const char *other, isize len
@@ -844,6 +1198,9 @@ CY_DEF CyString cy_string_prepend_rune(CyString str, Rune r);
 CY_DEF CyString cy_string_prepend_fmt(
     CyString str, const char *fmt, ...
 ) CY__FMT_ATTR(2);
+CY_DEF CyString cy_string_prepend_fmt_va(
+    CyString str, const char *fmt, va_list va
+);
 CY_DEF CyString cy_string_prepend_view(CyString str, CyStringView view);
 CY_DEF CyString cy_string_pad_right(CyString str, isize width, Rune r);
 CY_DEF CyString cy_string_set(CyString str, const char *c_str);
@@ -875,6 +1232,163 @@ CY_DEF CyStringView cy_string_view_substring(
 CY_DEF b32 cy_string_view_are_equal(CyStringView a, CyStringView b);
 CY_DEF b32 cy_string_view_has_prefix(CyStringView str, const char *prefix);
 CY_DEF b32 cy_string_view_contains(CyStringView str, const char *char_set);
+// NOTE(cya): same as cy_str_to_u64_report, but bounded by the view's length
+CY_DEF CyParseError cy_string_view_to_u64(
+    CyStringView str, i32 base, u64 *value, isize *len_out
+);
+CY_DEF CyParseError cy_string_view_to_i64(
+    CyStringView str, i32 base, i64 *value, isize *len_out
+);
+
+// NOTE(cya): index of the first/last char that's in the set (or -1)
+CY_DEF isize cy_string_view_index_any(CyStringView str, const CyCharSet *set);
+CY_DEF isize cy_string_view_last_index_any(
+    CyStringView str, const CyCharSet *set
+);
+// NOTE(cya): length of the prefix made only of chars in/not in the set
+CY_DEF isize cy_string_view_span(CyStringView str, const CyCharSet *set);
+CY_DEF isize cy_string_view_span_not(CyStringView str, const CyCharSet *set);
+CY_DEF CyStringView cy_string_view_trim(CyStringView str, const CyCharSet *set);
+CY_DEF CyStringView cy_string_view_trim_leading(
+    CyStringView str, const CyCharSet *set
+);
+CY_DEF CyStringView cy_string_view_trim_trailing(
+    CyStringView str, const CyCharSet *set
+);
+// NOTE(cya): skips delimiters and cuts the next token off (empty at the end)
+CY_DEF CyStringView cy_string_view_next_token(
+    CyStringView *str, const CyCharSet *delims
+);
+
+/*
+ * Substring search: index of the first/last occurrence of `needle` (or -1) and
+ * the number of non-overlapping occurrences (an empty needle matches at every
+ * position). Candidates are filtered on the needle's first and last bytes with
+ * SIMD, and long needles switch to Two-Way with a bad-character skip when too
+ * many of them don't pan out (scalar builds use it for all but the shortest
+ * needles), so the worst case stays linear
+ */
+CY_DEF isize cy_string_view_index(CyStringView str, CyStringView needle);
+CY_DEF isize cy_string_view_last_index(CyStringView str, CyStringView needle);
+CY_DEF isize cy_string_view_count(CyStringView str, CyStringView needle);
+
+/*
+ * Precompiled needle for searching the same string over and over (it doesn't
+ * own or copy the needle's text, so that has to outlive the searcher)
+ */
+typedef struct {
+    isize critical_pos;
+    isize period;
+    isize memory; // NOTE(cya): prefix known to match after a period shift
+} CyPrivTwoWay;
+
+typedef struct {
+    CyStringView needle;
+    CyPrivTwoWay two_way;
+    u32 skip[256];
+} CyStringSearcher;
+
+CY_DEF CyStringSearcher cy_string_searcher_create(CyStringView needle);
+CY_DEF isize cy_string_searcher_index(
+    const CyStringSearcher *searcher, CyStringView str
+);
+CY_DEF isize cy_string_searcher_last_index(
+    const CyStringSearcher *searcher, CyStringView str
+);
+CY_DEF isize cy_string_searcher_count(
+    const CyStringSearcher *searcher, CyStringView str
+);
+
+/* ------------------------------- Splitting -------------------------------- */
+/*
+ * Zero-copy splitting: every delimiter ends a token, so "a,,b," splits into
+ * "a", "", "b" and "" (an empty string is a single empty token and an empty
+ * separator never matches). Delimiters are found a 64-byte block at a time and
+ * the positions cached, so short fields don't each pay for a fresh scan
+ */
+typedef enum {
+    CY__STRING_SPLIT_BYTE,
+    CY__STRING_SPLIT_SEPARATOR,
+    CY__STRING_SPLIT_SET,
+} CyPrivStringSplitKind;
+
+typedef struct {
+    const u8 *cur; // NOTE(cya): start of the next token
+    const u8 *end;
+    const u8 *block; // NOTE(cya): block `mask` has the delimiters of
+    u64 mask;
+    CyStringView separator;
+    CyCharSet set;
+    u8 delim;
+    u8 kind;
+    b8 done;
+} CyStringSplitIter;
+
+CY_DEF CyStringSplitIter cy_string_split_by_byte(CyStringView str, u8 delim);
+// NOTE(cya): the separator's text has to outlive the iterator
+CY_DEF CyStringSplitIter cy_string_split_by_separator(
+    CyStringView str, CyStringView separator
+);
+CY_DEF CyStringSplitIter cy_string_split_by_set(
+    CyStringView str, const CyCharSet *set
+);
+// NOTE(cya): false once every token has been returned
+CY_DEF b32 cy_string_split_next(CyStringSplitIter *iter, CyStringView *token);
+
+/* ------------------- Multi-pattern search (Aho-Corasick) ------------------ */
+/*
+ * Matches a whole set of patterns in one pass over the text with a DFA. Bytes
+ * that behave the same get merged into classes, so each state's row is only as
+ * wide as the number of distinct bytes in the patterns. Everything lives in the
+ * arena it was built in (there's nothing to free on its own) and is read-only
+ * after the build, so one matcher can be shared by any number of threads
+ */
+typedef struct {
+    u32 *table; // NOTE(cya): state rows of premultiplied next states
+    u32 *state_patterns; // NOTE(cya): first pattern ending in each state
+    u32 *dict_links; // NOTE(cya): longest suffix state with a pattern in it
+    u32 *pattern_next; // NOTE(cya): duplicates of the same pattern
+    isize *pattern_lens;
+    isize state_count;
+    isize pattern_count;
+    i32 class_count;
+    u8 classes[256];
+} CyAhoCorasick;
+
+typedef struct {
+    isize pattern; // NOTE(cya): index into the array the matcher was built from
+    isize begin; // NOTE(cya): stream offsets (exclusive end)
+    isize end;
+} CyAhoCorasickMatch;
+
+// NOTE(cya): gets every match in order of where it ends, false stops the scan
+#define CY_AHO_CORASICK_MATCH_PROC(name) \
+    b32 name(void *user_data, CyAhoCorasickMatch match)
+typedef CY_AHO_CORASICK_MATCH_PROC(CyAhoCorasickMatchProc);
+
+// NOTE(cya): position in a stream (zero-initialize it to start a new one)
+typedef struct {
+    u32 state;
+    isize offset;
+} CyAhoCorasickStream;
+
+// NOTE(cya): empty patterns never match, the table is NULL if the arena ran out
+CY_DEF CyAhoCorasick cy_aho_corasick_create(
+    CyArena *arena, const CyStringView *patterns, isize pattern_count
+);
+/*
+ * Feeds the next chunk of a stream through the matcher, matches that straddle
+ * chunks get reported with the chunk that completes them. Returns false if
+ * `proc` stopped the scan
+ */
+CY_DEF b32 cy_aho_corasick_scan(
+    const CyAhoCorasick *ac, CyAhoCorasickStream *stream, CyStringView chunk,
+    CyAhoCorasickMatchProc *proc, void *user_data
+);
+CY_DEF b32 cy_aho_corasick_find_all(
+    const CyAhoCorasick *ac, CyStringView str,
+    CyAhoCorasickMatchProc *proc, void *user_data
+);
 
 /* ================== Strings (and StringViews) (UTF-16) ==================== */
 typedef wchar_t *CyString16;
@@ -933,6 +1447,192 @@ CY_DEF b32 cy_string_16_view_contains(
 /* ============================ Unicode helpers ============================= */
 CY_DEF isize cy_utf8_codepoints(const char *str);
 
+/* ================================ Hashing ================================= */
+/*
+ * Fast non-cryptographic 64-bit hashing (wyhash's 128-bit multiply-and-fold
+ * mixing). Tables that get keys from untrusted input should use the seeded
+ * versions with a random seed so nobody can precompute colliding keys
+ */
+CY_DEF u64 cy_hash_bytes(const void *data, isize len);
+CY_DEF u64 cy_hash_bytes_seed(const void *data, isize len, u64 seed);
+CY_DEF u64 cy_hash_string(CyString str);
+CY_DEF u64 cy_hash_string_view(CyStringView str);
+CY_DEF u64 cy_hash_string_view_seed(CyStringView str, u64 seed);
+
+// NOTE(cya): hashes data fed in pieces to the same value as in one go
+typedef struct {
+    u64 seed;
+    u64 lanes[3];
+    isize len;
+    u8 buf[64]; // NOTE(cya): last 16 bytes hashed + up to 48 pending ones
+} CyHashState;
+
+CY_DEF CyHashState cy_hash_state_init(u64 seed);
+CY_DEF void cy_hash_update(CyHashState *state, const void *data, isize len);
+CY_DEF u64 cy_hash_final(const CyHashState *state);
+
+// NOTE(cya): CRC-32C (Castagnoli), start at 0 and pass the result to continue
+CY_DEF u32 cy_crc32c(u32 crc, const void *data, isize len);
+
+/* =============================== Hash maps ================================ */
+/*
+ * Open-addressing map with Swiss-table style control bytes: every slot has a
+ * byte holding 7 bits of its key's hash (or empty/deleted), and lookups check
+ * 16 of those at once so keys only get compared on a likely hit. Keys are
+ * either raw bytes or CyStringViews (the text isn't copied, so it has to
+ * outlive the map), each slot caches its full hash so growing never rehashes
+ * a key and mismatches rarely reach a compare. Values are 8-byte aligned
+ */
+typedef struct {
+    CyAllocator alloc;
+    u8 *ctrl;
+    u8 *slots; // NOTE(cya): [u64 hash][key][value]
+    isize cap;
+    isize len;
+    isize growth_left; // NOTE(cya): inserts left before a rehash
+    isize key_size;
+    isize value_size;
+    isize value_offset;
+    isize slot_size;
+    u64 seed; // NOTE(cya): randomize it before inserting untrusted keys
+    b32 string_keys;
+} CyHashMap;
+
+CY_DEF CyHashMap cy_hash_map_init(
+    CyAllocator a, isize key_size, isize value_size
+);
+// NOTE(cya): keys are passed in (and stored) as CyStringView
+CY_DEF CyHashMap cy_hash_map_init_string_keys(CyAllocator a, isize value_size);
+CY_DEF void cy_hash_map_deinit(CyHashMap *map);
+
+#define cy_hash_map_init_type(a, key_type, value_type) \
+    cy_hash_map_init(a, cy_sizeof(key_type), cy_sizeof(value_type))
+
+// NOTE(cya): makes room for `count` entries in total without rehashing
+CY_DEF b32 cy_hash_map_reserve(CyHashMap *map, isize count);
+CY_DEF void cy_hash_map_clear(CyHashMap *map);
+
+// NOTE(cya): these return pointers to the value (invalidated by inserts)
+CY_DEF void *cy_hash_map_get(const CyHashMap *map, const void *key);
+// NOTE(cya): new values are zeroed (returns NULL if the allocator failed)
+CY_DEF void *cy_hash_map_get_or_insert(
+    CyHashMap *map, const void *key, b32 *inserted
+);
+CY_DEF void *cy_hash_map_put(
+    CyHashMap *map, const void *key, const void *value
+);
+CY_DEF b32 cy_hash_map_remove(CyHashMap *map, const void *key);
+
+// NOTE(cya): iteration (start with *idx = 0), unordered
+CY_DEF b32 cy_hash_map_next(
+    const CyHashMap *map, isize *idx, void **key, void **value
+);
+
+/* ============================ String interning ============================ */
+/*
+ * Deduplicates strings into an arena and hands out stable 32-bit IDs (dense,
+ * in insertion order) and views, so the same text always gets the same ID and
+ * the same pointer: comparing those replaces comparing the strings. Lookups
+ * never lock, inserts from any number of threads take a short spin lock (and
+ * they're the only ones allowed to touch the arena while the interner lives)
+ */
+#define CY_INTERN_NONE U32_MAX
+#define CY__INTERN_SEGMENT_COUNT 27
+
+typedef struct {
+    u64 hash;
+    CyStringView str;
+} CyPrivInternEntry;
+
+typedef struct {
+    usize mask;
+    volatile u32 *slots; // NOTE(cya): entry ID + 1 (0 is empty)
+} CyPrivInternTable;
+
+typedef struct {
+    CyArena *arena;
+    CyPrivInternTable *volatile table;
+    // NOTE(cya): entries never move, so each segment is twice the last
+    CyPrivInternEntry *volatile segments[CY__INTERN_SEGMENT_COUNT];
+    volatile usize count;
+    volatile usize lock;
+} CyInterner;
+
+CY_DEF CyInterner cy_interner_init(CyArena *arena);
+// NOTE(cya): returns CY_INTERN_NONE if the arena ran out
+CY_DEF u32 cy_interner_intern(CyInterner *interner, CyStringView str);
+// NOTE(cya): the interned copy of the string (empty if the arena ran out)
+CY_DEF CyStringView cy_interner_intern_view(
+    CyInterner *interner, CyStringView str
+);
+// NOTE(cya): doesn't insert, returns CY_INTERN_NONE for unknown strings
+CY_DEF u32 cy_interner_find(CyInterner *interner, CyStringView str);
+// NOTE(cya): the text is NUL-terminated (the view's length excludes it)
+CY_DEF CyStringView cy_interner_get(CyInterner *interner, u32 id);
+CY_DEF isize cy_interner_count(CyInterner *interner);
+
+/* ================================= Arrays ================================= */
+/*
+ * Type-generic dynamic arrays laid out like CyString: the pointer you hold is
+ * the first element and the header sits right before it, so indexing is plain
+ * `arr[i]`. The macros that can grow the array assign the (possibly moved)
+ * pointer back to `arr` and evaluate to it, which is NULL if the allocator ran
+ * out (`arr` is evaluated more than once, so keep it a plain variable)
+ */
+typedef struct {
+    CyAllocator alloc;
+    isize len;
+    isize cap;
+} CyArrayHeader;
+
+#define CY_ARRAY_HEADER(arr) ((CyArrayHeader*)((uintptr)(arr)) - 1)
+
+CY_DEF void *cy__array_create(CyAllocator a, isize item_size, isize cap);
+CY_DEF void *cy__array_reserve_space_for(
+    void *arr, isize item_size, isize extra_len
+);
+// NOTE(cya): `items` can't point into `arr` and NULL inserts zeroed items
+CY_DEF void *cy__array_insert(
+    void *arr, isize item_size, isize idx, const void *items, isize count
+);
+CY_DEF void cy__array_remove(
+    void *arr, isize item_size, isize idx, isize count
+);
+CY_DEF void cy__array_remove_swap(void *arr, isize item_size, isize idx);
+CY_DEF void *cy__array_resize(void *arr, isize item_size, isize len);
+CY_DEF void *cy__array_shrink(void *arr, isize item_size);
+
+CY_DEF isize cy_array_len(const void *arr);
+CY_DEF isize cy_array_cap(const void *arr);
+CY_DEF void cy_array_clear(void *arr);
+CY_DEF void cy_array_free(void *arr);
+
+#define cy_array_create(a, type) cy_array_create_reserve(a, type, 0)
+#define cy_array_create_reserve(a, type, cap) \
+    ((type*)cy__array_create(a, cy_sizeof(type), cap))
+#define cy_array_reserve_space_for(arr, extra_len) ((arr) = \
+    cy__array_reserve_space_for((arr), cy_sizeof(*(arr)), extra_len))
+#define cy_array_insert(arr, idx, items, count) ((arr) = \
+    cy__array_insert((arr), cy_sizeof(*(arr)), idx, items, count))
+#define cy_array_append(arr, items, count) \
+    cy_array_insert(arr, cy_array_len(arr), items, count)
+#define cy_array_push(arr, item) ( \
+    cy_array_reserve_space_for(arr, 1) == NULL ? NULL : \
+    ((arr)[CY_ARRAY_HEADER(arr)->len++] = (item), (arr)) \
+)
+#define cy_array_pop(arr) ((arr)[--CY_ARRAY_HEADER(arr)->len])
+#define cy_array_last(arr) ((arr)[CY_ARRAY_HEADER(arr)->len - 1])
+#define cy_array_remove(arr, idx, count) \
+    cy__array_remove((arr), cy_sizeof(*(arr)), idx, count)
+// NOTE(cya): O(1), moves the last item into the hole instead of shifting
+#define cy_array_remove_swap(arr, idx) \
+    cy__array_remove_swap((arr), cy_sizeof(*(arr)), idx)
+// NOTE(cya): new items are zeroed
+#define cy_array_resize(arr, len) \
+    ((arr) = cy__array_resize((arr), cy_sizeof(*(arr)), len))
+#define cy_array_shrink(arr) \
+    ((arr) = cy__array_shrink((arr), cy_sizeof(*(arr))))
+
 #endif // CY__H_INCLUDE
 
 #ifdef CY_IMPLEMENTATION
@@ -1675,38 +2375,6 @@ cy_inline isize cy_fprintf(CyFile *f, const char *fmt, ...)
 
 #define CY__FMT_STATIC_BUF_SIZE 4096
 
-cy_inline isize cy_fprintf_va(CyFile *f, const char *fmt, va_list va)
-{
-    va_list va_dup;
-    va_copy(va_dup, va);
-
-    char static_buf[CY__FMT_STATIC_BUF_SIZE];
-    isize static_size = CY_ARRAY_LEN(static_buf);
-    isize len = cy_sprintf_va(static_buf, static_size, fmt, va);
-
-    char *src = static_buf;
-    b32 use_heap = (len >= static_size);
-    if (use_heap) {
-        isize heap_size = len + 1;
-        char *heap_buf = cy_alloc_array(cy_heap_allocator(), char, heap_size);
-        if (heap_buf != NULL) {
-            len = cy_sprintf_va(heap_buf, heap_size, fmt, va_dup);
-            CY_ASSERT(len < heap_size);
-
-            src = heap_buf;
-        } else {
-            use_heap = false;
-        }
-    }
-
-    cy_file_write(f, src, len);
-    if (use_heap) {
-        cy_free(cy_heap_allocator(), src);
-    }
-
-    return len;
-}
-
 cy_inline char *cy_aprintf(CyAllocator a, const char *fmt, ...)
 {
     va_list va;
@@ -1717,30 +2385,6 @@ cy_inline char *cy_aprintf(CyAllocator a, const char *fmt, ...)
     return res;
 }
 
-cy_inline char *cy_aprintf_va(CyAllocator a, const char *fmt, va_list va)
-{
-    va_list va_dup;
-     va_copy(va_dup, va);
-
-    isize init_size = 4096;
-    char *buf = cy_alloc(a, init_size);
-    isize len = cy_sprintf_va(buf, init_size, fmt, va);
-
-    isize new_size = len + 1;
-    char *new_buf = cy_resize(a, buf, init_size, new_size);
-    if (new_buf == NULL) {
-        cy_free(a, buf);
-        return NULL;
-    }
-
-    buf = new_buf;
-    if (new_size > init_size) {
-        cy_sprintf_va(buf, new_size, fmt, va_dup);
-    }
-
-    return buf;
-}
-
 cy_inline isize cy_sprintf(char *buf, isize size, const char *fmt, ...)
 {
     va_list va;
@@ -1785,6 +2429,7 @@ enum {
     CY__FMT_STYLE_EXP = CY_BIT(20), // e, E
     CY__FMT_STYLE_AUTO = CY_BIT(21), // g, G
     CY__FMT_STYLE_UPPER = CY_BIT(22),
+    CY__FMT_STYLE_SHORTEST = CY_BIT(23), // r, R
 };
 
 typedef struct {
@@ -1800,306 +2445,482 @@ typedef struct {
     } value;
 } CyPrivFmtInfo;
 
-cy_internal isize cy__scan_u64(const char *str, i32 base, u64 *value)
+/*
+ * Integer parsing: the run of digits is found first (8 bytes at a time with
+ * SWAR when the length is known), then converted in chunks of 8 decimal or
+ * hex digits, so overflow only has to be checked where it can happen
+ */
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define CY__SWAR_DIGITS
+#endif
+
+// NOTE(cya): 0-35 for digits and (case-insensitive) letters, 0xFF otherwise
+cy_internal cy_inline u32 cy__digit_value(u8 c)
 {
-    const char *s = str;
-    u64 res = 0;
-    if (base == 16 && cy_str_has_prefix(s, "0x")) {
-        s += 2;
+    u32 d = (u32)c - '0';
+    if (d < 10) {
+        return d;
     }
 
-    for (;;) {
-        i64 d;
-        char c = *s;
-        if (cy_char_is_digit(c)) {
-            d = c - '0';
-        } else if (base == 16 && cy_char_is_hex_digit(c)) {
-            d = cy_hex_digit_to_i64(c);
-        } else {
-            break;
-        }
+    d = ((u32)c | 0x20) - 'a';
+    return (d < 26) ? d + 10 : 0xFF;
+}
 
-        res = res * (u64)base + (u64)d;
-        s += 1;
-    }
+cy_internal cy_inline u64 cy__load_u64(const void *p)
+{
+    u64 val;
+    cy_mem_copy(&val, p, cy_sizeof(val));
+    return val;
+}
 
-    if (value != NULL) {
-        *value = res;
-    }
+cy_internal cy_inline b32 cy__is_eight_digits(const u8 *s)
+{
+    u64 val = cy__load_u64(s);
+    return ((val & 0xF0F0F0F0F0F0F0F0ULL) |
+        (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+        0x3333333333333333ULL;
+}
 
-    return s - str;
+cy_internal cy_inline u32 cy__parse_eight_digits(const void *s)
+{
+    u64 val = cy__load_u64(s);
+    val = ((val & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    val = ((val & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return (u32)(((val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
 }
 
-cy_internal isize cy__scan_i64(const char *str, i32 base, i64 *value)
+// NOTE(cya): s must hold 8 valid hex digits
+cy_internal cy_inline u32 cy__parse_eight_hex_digits(const void *s)
 {
-    const char *s = str;
-    i64 res = 0;
-    b32 negative = false;
-    if (*s == '-') {
-        negative = true;
-        s += 1;
-    }
+    u64 val = cy__load_u64(s);
+
+    // NOTE(cya): '0'-'9' -> 0-9, 'a'-'f'/'A'-'F' -> 10-15 (bit 6 = letter)
+    val = (val & 0x0F0F0F0F0F0F0F0FULL) +
+        ((val >> 6) & 0x0101010101010101ULL) * 9;
+    val = ((val << 4) | (val >> 8)) & 0x00FF00FF00FF00FFULL;
+    val = ((val << 8) | (val >> 16)) & 0x0000FFFF0000FFFFULL;
+    return (u32)((val << 16) | (val >> 32));
+}
 
-    if (base == 16 && cy_str_has_prefix(s, "0x")) {
-        s += 2;
+// NOTE(cya): converts n valid digits (which may overflow)
+cy_internal CyParseError cy__convert_digits_u64(
+    const u8 *s, isize n, i32 base, u64 *value
+) {
+    isize i = 0;
+    while (i < n && s[i] == '0') {
+        i += 1;
     }
 
-    for (;;) {
-        i64 d;
-        if (cy_char_is_digit(*s)) {
-            d = *s - '0';
-        } else if (base == 16 && cy_char_is_hex_digit(*s)) {
-            d = cy_hex_digit_to_i64(*s);
-        } else {
-            break;
+    u64 res = 0;
+    if (base == 10) {
+        // NOTE(cya): 19 digits always fit, the 20th might not
+        isize safe_end = i + CY_MIN(n - i, 19);
+#if defined(CY__SWAR_DIGITS)
+        for (; safe_end - i >= 8; i += 8) {
+            res = res * 100000000 + cy__parse_eight_digits(s + i);
+        }
+#endif
+        for (; i < safe_end; i++) {
+            res = res * 10 + (u64)(s[i] - '0');
         }
+        if (i < n) {
+            u64 d = (u64)(s[i] - '0');
+            if (n - i > 1 || res > (U64_MAX - d) / 10) {
+                *value = U64_MAX;
+                return CY_PARSE_ERROR_OVERFLOW;
+            }
 
-        res = res * base + d;
-        s += 1;
-    }
+            res = res * 10 + d;
+        }
+    } else if (base == 16) {
+        if (n - i > 16) {
+            *value = U64_MAX;
+            return CY_PARSE_ERROR_OVERFLOW;
+        }
 
-    if (negative) {
-        res = -res;
-    }
+#if defined(CY__SWAR_DIGITS)
+        for (; n - i >= 8; i += 8) {
+            res = (res << 32) | cy__parse_eight_hex_digits(s + i);
+        }
+#endif
+        for (; i < n; i++) {
+            res = (res << 4) | cy__digit_value(s[i]);
+        }
+    } else {
+        u64 b = (u32)base;
+        for (; i < n; i++) {
+            u64 d = cy__digit_value(s[i]);
+            if (res > (U64_MAX - d) / b) {
+                *value = U64_MAX;
+                return CY_PARSE_ERROR_OVERFLOW;
+            }
 
-    if (value != NULL) {
-        *value = res;
+            res = res * b + d;
+        }
     }
 
-    return s - str;
+    *value = res;
+    return CY_PARSE_ERROR_NONE;
 }
 
-cy_global const char cy__num_to_char_table_upper[] = "0123456789ABCDEF";
-cy_global const char cy__num_to_char_table_lower[] = "0123456789abcdef";
+/*
+ * Parses an unsigned integer from the first len bytes of s (or up to the null
+ * terminator when len < 0). Base 0 means 16 with a "0x" prefix and 10 without,
+ * and the prefix is optional for base 16
+ * NOTE: on overflow the digits are still consumed and the value saturates
+ */
+cy_internal CyParseError cy__parse_u64(
+    const u8 *s, isize len, i32 base, u64 *value, isize *len_out
+) {
+    isize i = 0;
+    b32 has_prefix = (len < 0 || len >= 3) &&
+        s[0] == '0' && (s[1] == 'x' || s[1] == 'X') &&
+        cy__digit_value(s[2]) < 16;
+    if (base == 0) {
+        base = has_prefix ? 16 : 10;
+    }
+    if (base == 16 && has_prefix) {
+        i = 2;
+    }
 
-cy_internal cy_inline char cy__fmt_get_base_char(i32 base)
-{
-    switch (base) {
-    case 2: {
-        return 'b';
-    } break;
-    case 16: {
-        return 'x';
-    } break;
+    *value = 0;
+    *len_out = 0;
+    if (base < 2 || base > 36) {
+        return CY_PARSE_ERROR_INVALID;
     }
 
-    return '?';
-}
+    isize start = i;
+#if defined(CY__SWAR_DIGITS)
+    if (base == 10 && len >= 0) {
+        while (len - i >= 8 && cy__is_eight_digits(s + i)) {
+            i += 8;
+        }
+    }
+#endif
+    while ((len < 0 || i < len) && cy__digit_value(s[i]) < (u32)base) {
+        i += 1;
+    }
+    if (i == start) {
+        return CY_PARSE_ERROR_INVALID;
+    }
 
-cy_internal cy_inline char cy__fmt_char_to_case(char c, b32 uppercase)
-{
-    return uppercase ? cy_char_to_upper(c) : c;
+    *len_out = i;
+    return cy__convert_digits_u64(s + start, i - start, base, value);
 }
 
-#define CY__PRINT_PROC(name) \
-    isize name(char *dst, isize cap, CyPrivFmtInfo info)
-typedef CY__PRINT_PROC(CyPrivPrintProc);
+cy_internal CyParseError cy__parse_i64(
+    const u8 *s, isize len, i32 base, i64 *value, isize *len_out
+) {
+    b32 negative = false;
+    isize sign_len = 0;
+    if (len != 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = (s[0] == '-');
+        sign_len = 1;
+    }
 
-cy_internal CY__PRINT_PROC(cy__print_u64)
+    u64 mag;
+    isize digits_len;
+    CyParseError err = cy__parse_u64(
+        s + sign_len, (len < 0) ? len : len - sign_len, base, &mag, &digits_len
+    );
+    *len_out = (digits_len > 0) ? sign_len + digits_len : 0;
+
+    // NOTE(cya): negating in unsigned so INT64_MIN doesn't overflow
+    u64 limit = negative ? (u64)I64_MAX + 1 : (u64)I64_MAX;
+    if (err == CY_PARSE_ERROR_NONE && mag > limit) {
+        err = CY_PARSE_ERROR_OVERFLOW;
+    }
+    if (err == CY_PARSE_ERROR_OVERFLOW) {
+        mag = limit;
+    }
+
+    *value = negative ? (i64)(0 - mag) : (i64)mag;
+    return err;
+}
+
+cy_internal isize cy__scan_u64(const char *str, i32 base, u64 *value)
 {
-    u64 n = info.value.u;
+    u64 res;
+    isize len;
+    cy__parse_u64((const u8*)str, -1, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
+    }
 
-    const isize limit = cap - 1;
-    isize written = 0;
-    isize written_total = 0;
+    return len;
+}
 
-    i32 base = info.base;
-    b32 style_alt = (info.flags & CY__FMT_HASH);
-    b32 add_prefix = style_alt &&
-        (base == 2 || base == 8 || base == 16) && n != 0;
-    b32 style_upper = (info.flags & CY__FMT_STYLE_UPPER);
-    const char *table = style_upper ?
-        cy__num_to_char_table_upper : cy__num_to_char_table_lower;
+cy_internal isize cy__scan_i64(const char *str, i32 base, i64 *value)
+{
+    i64 res;
+    isize len;
+    cy__parse_i64((const u8*)str, -1, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
+    }
 
-    char *c = dst;
-    if (n == 0) {
-        if (info.precision == 0) {
-            return 0; // NOTE(cya): edge case from the spec
-        } if (written < limit) {
-            *c++ = '0';
-            written += 1;
-        }
+    return len;
+}
 
-        written_total += 1;
-    } else {
-        while (n > 0) {
-            if (written < limit) {
-                *c++ = table[n % (u64)base];
-                written += 1;
-            }
+cy_global const char cy__num_to_char_table_upper[] = "0123456789ABCDEF";
+cy_global const char cy__num_to_char_table_lower[] = "0123456789abcdef";
 
-            n /= (u64)base;
-            written_total += 1;
-        }
+cy_global const char cy__digit_pairs_table[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+cy_global const u64 cy__pow_of_10_u64_table[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL,
+    100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+// NOTE(cya): amount of significant bits in n (0 for 0)
+cy_internal cy_inline i32 cy__u64_bit_len(u64 n)
+{
+#if defined(CY_COMPILER_MSVC) && defined(_M_X64)
+    unsigned long idx;
+    return _BitScanReverse64(&idx, n) ? (i32)idx + 1 : 0;
+#elif defined(CY_COMPILER_GCC) || defined(CY_COMPILER_CLANG)
+    return (n == 0) ? 0 : 64 - __builtin_clzll(n);
+#else
+    i32 len = 0;
+    for (; n != 0; n >>= 1) {
+        len += 1;
     }
 
-    b32 use_precision = (info.precision != -1) &&
-        (info.flags & CY__FMT_INTS);
-    if (use_precision) {
-        while (written < info.precision) {
-            if (written < limit) {
-                *c++ = '0';
-                written += 1;
-            }
+    return len;
+#endif
+}
 
-            written_total += 1;
-        }
+cy_internal cy_inline i32 cy__fmt_base_shift(i32 base)
+{
+    switch (base) {
+    case 2: {
+        return 1;
+    } break;
+    case 8: {
+        return 3;
+    } break;
+    case 16: {
+        return 4;
+    } break;
     }
 
-    b32 fill_with_zeros = !use_precision && (written < info.width) &&
-        (info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS);
-    b32 print_sign = (info.flags & CY__FMT_PLUS) ||
-        (info.flags & CY__FMT_SPACE);
-    isize sign_len = !!print_sign;
-    if (fill_with_zeros) {
-        isize extra = info.width - written - sign_len;
-        while (extra-- > 0) {
-            if (written < limit) {
-                *c++ = '0';
-                written += 1;
-            }
+    return 0;
+}
 
-            written_total += 1;
-        }
+cy_internal isize cy__u64_digit_count(u64 n, i32 base)
+{
+    u64 m = n | 1; // NOTE(cya): 0 still takes up a digit
+    i32 bits = cy__u64_bit_len(m);
+    if (base == 10) {
+        // NOTE(cya): 1233/4096 ~= log10(2), which can undershoot by one
+        i32 t = (bits * 1233) >> 12;
+        return t + (m >= cy__pow_of_10_u64_table[t]);
     }
 
-    if (add_prefix) {
-        switch (base) {
-        case 2:
-        case 16: {
-            if (written < limit) {
-                char p = cy__fmt_get_base_char(base);
-                *c++ = cy__fmt_char_to_case(p, style_upper);
-                written += 1;
-            }
+    i32 shift = cy__fmt_base_shift(base);
+    if (shift != 0) {
+        return (bits + shift - 1) / shift;
+    }
 
-            written_total += 1;
-        } // NOTE(cya): fallthrough
-        case 8: {
-            if (written < limit) {
-                *c++ = '0';
-                written += 1;
-            }
+    isize count = 1;
+    for (n /= (u64)base; n != 0; n /= (u64)base) {
+        count += 1;
+    }
 
-            written_total += 1;
-        } break;
-        default: break;
+    return count;
+}
+
+/*
+ * Writes the digits of n backwards, ending right before `end` (so the caller
+ * has to reserve cy__u64_digit_count(n, base) chars) and returns the start
+ */
+cy_internal char *cy__u64_write_digits(
+    u64 n, i32 base, const char *table, char *end
+) {
+    char *c = end;
+    if (base == 10) {
+        while (n >= 100) {
+            u64 q = n / 100;
+            const char *pair = cy__digit_pairs_table + (n - q * 100) * 2;
+            c -= 2;
+            c[0] = pair[0];
+            c[1] = pair[1];
+            n = q;
         }
-    }
 
-    if (print_sign) {
-        char sign = (info.flags & CY__FMT_SPACE) ? ' ' : '+';
-        if (written < limit) {
-            *c++ = sign;
-            written += 1;
+        if (n >= 10) {
+            const char *pair = cy__digit_pairs_table + n * 2;
+            c -= 2;
+            c[0] = pair[0];
+            c[1] = pair[1];
+        } else {
+            *--c = (char)('0' + n);
         }
 
-        written_total += 1;
+        return c;
     }
 
-    isize len = written;
-    cy_str_reverse_n(dst, len);
+    i32 shift = cy__fmt_base_shift(base);
+    if (shift != 0) {
+        u64 mask = (u64)base - 1;
+        do {
+            *--c = table[n & mask];
+            n >>= shift;
+        } while (n != 0);
+    } else {
+        do {
+            *--c = table[n % (u64)base];
+            n /= (u64)base;
+        } while (n != 0);
+    }
 
-    return written_total;
+    return c;
 }
 
-cy_internal CY__PRINT_PROC(cy__print_i64)
+cy_internal cy_inline char cy__fmt_char_to_case(char c, b32 uppercase)
 {
-    i64 n = info.value.i;
+    return uppercase ? cy_char_to_upper(c) : c;
+}
 
-    const isize limit = cap - 1;
-    isize written = 0;
-    isize written_total = 0;
+/*
+ * Run of zeros that goes at `offset` in a conversion's output (zero padding
+ * and precision can get arbitrarily long, so the print procs leave them out
+ * of the output and the writer emits them as a fill instead)
+ */
+typedef struct {
+    isize offset;
+    isize len;
+} CyPrivFmtZeros;
+
+#define CY__PRINT_PROC(name) isize name( \
+    char *dst, isize cap, CyPrivFmtInfo info, CyPrivFmtZeros *zeros_out \
+)
+typedef CY__PRINT_PROC(CyPrivPrintProc);
+
+/*
+ * Shared body of the integer print procs: [sign][prefix][zeros][digits]
+ * (the zeros are reported through `zeros_out` instead of being written)
+ */
+cy_internal isize cy__print_int(
+    char *dst, isize cap, CyPrivFmtInfo info, CyPrivFmtZeros *zeros_out,
+    u64 n, char sign, const char *prefix
+) {
+    if (n == 0 && info.precision == 0) {
+        return 0; // NOTE(cya): edge case from the spec
+    }
 
     i32 base = info.base;
     b32 style_upper = (info.flags & CY__FMT_STYLE_UPPER);
     const char *table = style_upper ?
         cy__num_to_char_table_upper : cy__num_to_char_table_lower;
 
-    b32 negative = false;
-    if (n < 0) {
-        negative = true;
-        n = -n;
+    char head[4];
+    isize head_len = 0;
+    if (sign != '\0') {
+        head[head_len++] = sign;
     }
-
-    char *c = dst;
-    u64 v = (u64)n;
-    if (v == 0) {
-        if (info.precision == 0) {
-            return 0; // NOTE(cya): edge case from the spec
-        } else if (written < limit) {
-            *c++ = '0';
-            written += 1;
-        }
-
-        written_total += 1;
-    } else {
-        while (v > 0) {
-            if (written < limit) {
-                *c++ = table[v % (u64)base];
-                written += 1;
-            }
-
-            v /= (u64)base;
-            written_total += 1;
-        }
+    for (; prefix != NULL && *prefix != '\0'; prefix++) {
+        head[head_len++] = cy__fmt_char_to_case(*prefix, style_upper);
     }
 
+    isize digits = cy__u64_digit_count(n, base);
+    isize zeros = 0;
     b32 use_precision = (info.precision != -1) &&
         (info.flags & CY__FMT_INTS);
+    b32 fill_with_zeros = !use_precision &&
+        (info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS);
     if (use_precision) {
-        isize cur_len = c - dst;
-        while (cur_len < info.precision) {
-            if (written < limit) {
-                *c++ = '0';
-                written += 1;
-            }
+        zeros = info.precision - digits;
+    } else if (fill_with_zeros) {
+        zeros = info.width - digits - (sign != '\0');
+    }
 
-            written_total += 1;
-        }
+    if (zeros_out != NULL) {
+        zeros_out->offset = head_len;
+        zeros_out->len = CY_MAX(zeros, 0);
     }
 
-    b32 fill_with_zeros = !use_precision && (written < info.width) &&
-        (info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS);
-    b32 print_sign = negative ||
-        (info.flags & CY__FMT_PLUS) || (info.flags & CY__FMT_SPACE);
-    isize sign_len = !!print_sign;
-    if (fill_with_zeros) {
-        isize extra = info.width - written - sign_len;
-        while (extra-- > 0) {
-            if (written < limit) {
-                *c++ = '0';
-                written += 1;
-            }
+    char *c = dst;
+    isize remaining = CY_MAX(cap - 1, 0);
+    isize len = CY_MIN(head_len, remaining);
+    cy_mem_copy(c, head, len);
+    c += len, remaining -= len;
 
-            written_total += 1;
-        }
+    if (digits <= remaining) {
+        cy__u64_write_digits(n, base, table, c + digits);
+    } else if (remaining > 0) {
+        char digit_buf[64];
+        cy__u64_write_digits(n, base, table, digit_buf + digits);
+        cy_mem_copy(c, digit_buf, remaining);
     }
 
-    if (print_sign) {
-        char sign = '-';
-        if (info.flags & CY__FMT_PLUS) {
-            sign = '+';
-        } else if (info.flags & CY__FMT_SPACE) {
-            sign = ' ';
-        }
+    return head_len + digits;
+}
 
-        if (written < limit) {
-            *c++ = sign;
-            written += 1;
-        }
+cy_internal CY__PRINT_PROC(cy__print_u64)
+{
+    u64 n = info.value.u;
 
-        written_total += 1;
+    char sign = '\0';
+    if (info.flags & CY__FMT_SPACE) {
+        sign = ' ';
+    } else if (info.flags & CY__FMT_PLUS) {
+        sign = '+';
+    }
+
+    const char *prefix = NULL;
+    if ((info.flags & CY__FMT_HASH) && n != 0) {
+        switch (info.base) {
+        case 2: {
+            prefix = "0b";
+        } break;
+        case 8: {
+            prefix = "0";
+        } break;
+        case 16: {
+            prefix = "0x";
+        } break;
+        }
     }
 
-    isize len = written;
-    cy_str_reverse_n(dst, len);
+    return cy__print_int(dst, cap, info, zeros_out, n, sign, prefix);
+}
 
-    return written_total;
+cy_internal CY__PRINT_PROC(cy__print_i64)
+{
+    i64 n = info.value.i;
+
+    char sign = '\0';
+    if (n < 0) {
+        sign = '-';
+    } else if (info.flags & CY__FMT_PLUS) {
+        sign = '+';
+    } else if (info.flags & CY__FMT_SPACE) {
+        sign = ' ';
+    }
+
+    // NOTE(cya): negating in unsigned so INT64_MIN doesn't overflow
+    u64 v = (n < 0) ? 0 - (u64)n : (u64)n;
+    return cy__print_int(dst, cap, info, zeros_out, v, sign, NULL);
 }
 
 cy_internal CY__PRINT_PROC(cy__print_str)
 {
+    (void)zeros_out;
     const char *src = (const char*)info.value.s.text;
     isize len = info.value.s.len;
 
@@ -2170,2315 +2991,7278 @@ cy_global const f64 cy__pow_of_16_table[] = {
     0x1p60, 0x1p60, 0x1p60, 0x1p60, 0x1p60,
 };
 
-// TODO(cya):
-// * correct rounding errors on binary exponentiation (probably requires MPA)
-cy_internal CY__PRINT_PROC(cy__print_f64)
+/*
+ * Shortest round-trip float -> decimal conversion (Ryu, by Ulf Adams), which
+ * only uses integer arithmetic: the binary float is turned into the shortest
+ * decimal mantissa/exponent pair that still parses back to the same bits
+ *
+ * The 128-bit multipliers for 5^i and 2^k/5^i are reconstructed from every
+ * 26th entry, a table of small powers of 5 and a few bits of error correction
+ * (so we don't have to carry ~10KB of tables around)
+ */
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 cy__u128;
+#endif
+
+// NOTE(cya): full 64x64 -> 128-bit multiplication (returns the low half)
+cy_internal cy_inline u64 cy__u64_mul_128(u64 a, u64 b, u64 *hi)
 {
-    f64 n = info.value.f;
+#if defined(__SIZEOF_INT128__)
+    cy__u128 p = (cy__u128)a * b;
+    *hi = (u64)(p >> 64);
+    return (u64)p;
+#elif defined(CY_COMPILER_MSVC) && defined(_M_X64)
+    return _umul128(a, b, hi);
+#else
+    u64 a_lo = (u32)a, a_hi = a >> 32;
+    u64 b_lo = (u32)b, b_hi = b >> 32;
 
-    const isize limit = cap - 1;
-    isize written = 0;
-    isize written_total = 0;
+    u64 lo_lo = a_lo * b_lo;
+    u64 hi_lo = a_hi * b_lo;
+    u64 lo_hi = a_lo * b_hi;
+    u64 hi_hi = a_hi * b_hi;
 
-    b32 upper = info.flags & CY__FMT_STYLE_UPPER;
-    char *cur = dst;
-    if (CY_IS_NAN(n)) {
-        info.value.s = cy_string_view_create_c(upper ? "NAN" : "nan");
-        return cy__print_str(cur, cap, info);
-    }
+    u64 mid = (lo_lo >> 32) + (u32)hi_lo + lo_hi;
+    *hi = hi_hi + (hi_lo >> 32) + (mid >> 32);
+    return (mid << 32) | (u32)lo_lo;
+#endif
+}
 
-    if (n < 0.0) {
-        n = -n;
-        if (written < limit) {
-            *cur++ = '-';
-            written += 1;
-        }
+// NOTE(cya): (hi:lo) >> dist, for 0 < dist < 64
+cy_internal cy_inline u64 cy__u128_shift_right(u64 lo, u64 hi, i32 dist)
+{
+    return (hi << (64 - dist)) | (lo >> dist);
+}
 
-        written_total += 1;
-    } else if (info.flags & CY__FMT_PLUS) {
-        if (written < limit) {
-            *cur++ = '+';
-            written += 1;
-        }
+#define CY__RYU_POW5_TABLE_SIZE 26
+#define CY__RYU_POW5_BITCOUNT 125
+#define CY__RYU_POW5_INV_BITCOUNT 125
 
-        written_total += 1;
-    } else if (info.flags & CY__FMT_SPACE) {
-        if (written < limit) {
-            *cur++ = ' ';
-            written += 1;
-        }
+cy_global const u64 cy__ryu_pow5_table[26] = {
+    1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL, 78125ULL, 390625ULL,
+    1953125ULL, 9765625ULL, 48828125ULL, 244140625ULL, 1220703125ULL,
+    6103515625ULL, 30517578125ULL, 152587890625ULL, 762939453125ULL,
+    3814697265625ULL, 19073486328125ULL, 95367431640625ULL, 476837158203125ULL,
+    2384185791015625ULL, 11920928955078125ULL, 59604644775390625ULL,
+    298023223876953125ULL,
+};
 
-        written_total += 1;
-    }
+cy_global const u64 cy__ryu_pow5_split[13][2] = {
+    { 0x0000000000000000ULL, 0x1000000000000000ULL },
+    { 0x0000000000000000ULL, 0x14adf4b7320334b9ULL },
+    { 0x0e549208b31adb10ULL, 0x1aba4714957d300dULL },
+    { 0x6dc6ad264d8f0866ULL, 0x1145b7e285bf98f5ULL },
+    { 0xeb1dbd923d8596caULL, 0x1652efdc6018a1fcULL },
+    { 0xb4c1b80b22ae923cULL, 0x1cda62055b2d9d83ULL },
+    { 0x5bb28b4e8f7e4c30ULL, 0x12a5568b9f52f416ULL },
+    { 0xf08aed437682d4fbULL, 0x1819651531f9e78fULL },
+    { 0xb4ee134ad99bf150ULL, 0x1f25c186a6f04c28ULL },
+    { 0x16499ecb70c25f03ULL, 0x1420eb449c8842e6ULL },
+    { 0x85a56ead360865b0ULL, 0x1a03fde214caf085ULL },
+    { 0x093db1d57999890bULL, 0x10cfeb353a97dad8ULL },
+    { 0xcf38bb735e3f36acULL, 0x15baaf44fa52673eULL },
+};
 
-    if (CY_IS_INF(n)) {
-        info.value.s = cy_string_view_create_c(upper ? "INF" : "inf");
-        isize len = cy__print_str(cur, cap, info);
-        return written_total + len;
-    }
+cy_global const u64 cy__ryu_pow5_inv_split[13][2] = {
+    { 0x0000000000000001ULL, 0x2000000000000000ULL },
+    { 0x52a6c95fc0655034ULL, 0x18c240c4aecb13bbULL },
+    { 0x7ca8d50071dfc806ULL, 0x1327fc58da0f6ff5ULL },
+    { 0x6520247d3556476eULL, 0x1da48ce468e7c702ULL },
+    { 0x6139cdd76802e6e9ULL, 0x16ef5b40c2fc7779ULL },
+    { 0xf951a7ff43de8c79ULL, 0x11bebdf578b2f391ULL },
+    { 0x7be8bee8d6e957e8ULL, 0x1b758d848fac54b0ULL },
+    { 0x8bd3f9e999a423eaULL, 0x153eda614071a3b7ULL },
+    { 0x0848f973cb3ee3ceULL, 0x10701bd527b4978cULL },
+    { 0x153285ebb9efbfa2ULL, 0x196fbb9bb44db44dULL },
+    { 0xadeee7f86c07b696ULL, 0x13ae3591f5b4d936ULL },
+    { 0x4d686a4eaf182222ULL, 0x1e74404f3daada91ULL },
+    { 0x98c0a106e09ebd9fULL, 0x17900ea4fda7c257ULL },
+};
 
-    b32 style_hex = info.base == 16;
-    b32 style_exp = info.flags & CY__FMT_STYLE_EXP;
-    b32 style_auto = info.flags & CY__FMT_STYLE_AUTO;
-    b32 style_alt = info.flags & CY__FMT_HASH;
+cy_global const u32 cy__ryu_pow5_offsets[21] = {
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x40000000, 0x59695995,
+    0x55545555, 0x56555515, 0x41150504, 0x40555410, 0x44555145, 0x44504540,
+    0x45555550, 0x40004000, 0x96440440, 0x55565565, 0x54454045, 0x40154151,
+    0x55559155, 0x51405555, 0x00000105,
+};
 
-    if (style_hex) {
-        info.value.s = cy_string_view_create_c(upper ? "0X" : "0x");
-        isize len_total = cy__print_str(cur, cap, info);
-        isize len = CY_MIN(len_total, cap);
+cy_global const u32 cy__ryu_pow5_inv_offsets[19] = {
+    0x54544554, 0x04055545, 0x10041000, 0x00400414, 0x40010000, 0x41155555,
+    0x00000454, 0x00010044, 0x40000000, 0x44000041, 0x50454450, 0x55550054,
+    0x51655554, 0x40004000, 0x01000001, 0x00010500, 0x51515411, 0x05555554,
+    0x00000000,
+};
 
-        cur += len, written += len;
-        written_total += len_total;
+// NOTE(cya): ceil(log2(5^e)) (or 1 for e == 0), for 0 <= e <= 3528
+cy_internal cy_inline i32 cy__ryu_pow5_bits(i32 e)
+{
+    return (i32)((((u32)e * 1217359) >> 19) + 1);
+}
+
+// NOTE(cya): floor(log10(2^e)), for 0 <= e <= 1650
+cy_internal cy_inline u32 cy__ryu_log10_pow2(i32 e)
+{
+    return ((u32)e * 78913) >> 18;
+}
+
+// NOTE(cya): floor(log10(5^e)), for 0 <= e <= 2620
+cy_internal cy_inline u32 cy__ryu_log10_pow5(i32 e)
+{
+    return ((u32)e * 732923) >> 20;
+}
+
+cy_internal cy_inline b32 cy__ryu_is_multiple_of_pow5(u64 n, u32 p)
+{
+    u32 count = 0;
+    for (; n != 0 && n % 5 == 0; n /= 5) {
+        count += 1;
     }
 
-    char *num_start = cur;
+    return count >= p;
+}
 
-    const i32 MAX_PRECISION = 16;
-    i32 precision = info.precision;
-    b32 custom_precision = (precision != -1);
-    if (custom_precision) {
-        precision = CY_MIN(precision, MAX_PRECISION);
-    } else if (!style_hex) {
-        precision = 6;
+cy_internal cy_inline b32 cy__ryu_is_multiple_of_pow2(u64 n, u32 p)
+{
+    return (n & ((1ULL << p) - 1)) == 0;
+}
+
+// NOTE(cya): 5^i, normalized to CY__RYU_POW5_BITCOUNT bits
+cy_internal void cy__ryu_pow5(u32 i, u64 res[2])
+{
+    u32 base = i / CY__RYU_POW5_TABLE_SIZE;
+    u32 base2 = base * CY__RYU_POW5_TABLE_SIZE;
+    u32 offset = i - base2;
+    const u64 *mul = cy__ryu_pow5_split[base];
+    if (offset == 0) {
+        res[0] = mul[0];
+        res[1] = mul[1];
+        return;
     }
 
-    i16 exponent = 0;
-    f64 normalized = n;
-    if (style_exp || style_auto) {
-        if (normalized >= 1e1) {
-            CY__CALC_BIN_EXPS(INC, 10, 1e, normalized, exponent);
-        } else if (normalized > 0.0 && normalized <= 1e0) {
-            CY__CALC_BIN_EXPS(DEC, 10, 1e, normalized, exponent);
-            if (normalized < 1e0) {
-                normalized *= 1e1;
-                exponent -= 1;
-            }
-        }
-    } else if (style_hex) {
-        if (normalized >= 0x1p1) {
-            CY__CALC_BIN_EXPS(INC, 2, 0x1p, normalized, exponent);
-        } else if (normalized > 0.0 && normalized <= 0x1p0) {
-            CY__CALC_BIN_EXPS(DEC, 2, 0x1p, normalized, exponent);
-            if (normalized < 0x1p0) {
-                normalized *= 0x1p1;
-                exponent -= 1;
-            }
-        }
+    u64 m = cy__ryu_pow5_table[offset];
+    u64 high1, high0;
+    u64 low1 = cy__u64_mul_128(m, mul[1], &high1);
+    u64 low0 = cy__u64_mul_128(m, mul[0], &high0);
+    u64 sum = high0 + low1;
+    if (sum < high0) {
+        high1 += 1;
     }
 
-    b32 swap = style_hex || style_exp ||
-        (style_auto && (exponent < -4 || exponent >= precision));
-    if (swap) {
-        n = normalized;
+    i32 delta = cy__ryu_pow5_bits((i32)i) - cy__ryu_pow5_bits((i32)base2);
+    u32 correction = (cy__ryu_pow5_offsets[i / 16] >> ((i % 16) << 1)) & 3;
+    res[0] = cy__u128_shift_right(low0, sum, delta) + correction;
+    res[1] = cy__u128_shift_right(sum, high1, delta);
+}
+
+// NOTE(cya): 2^k / 5^i (+ 1), normalized to CY__RYU_POW5_INV_BITCOUNT bits
+cy_internal void cy__ryu_pow5_inv(u32 i, u64 res[2])
+{
+    u32 base = (i + CY__RYU_POW5_TABLE_SIZE - 1) / CY__RYU_POW5_TABLE_SIZE;
+    u32 base2 = base * CY__RYU_POW5_TABLE_SIZE;
+    u32 offset = base2 - i;
+    const u64 *mul = cy__ryu_pow5_inv_split[base];
+    if (offset == 0) {
+        res[0] = mul[0];
+        res[1] = mul[1];
+        return;
     }
 
-    u64 integral = (u64)n;
-    isize integral_len, len;
-    isize remaining = limit - written;
-    isize len_total = integral_len = cy__print_u64(
-        cur, remaining, (CyPrivFmtInfo){
-            .base = info.base,
-            .precision = -1,
-            .value.u = integral,
-        }
-    );
+    u64 m = cy__ryu_pow5_table[offset];
+    u64 high1, high0;
+    u64 low1 = cy__u64_mul_128(m, mul[1], &high1);
+    u64 low0 = cy__u64_mul_128(m, mul[0] - 1, &high0);
+    u64 sum = high0 + low1;
+    if (sum < high0) {
+        high1 += 1;
+    }
 
-    len = integral_len = CY_MIN(len_total, remaining);
-    cur += len, written += len;
-    written_total += len_total;
+    i32 delta = cy__ryu_pow5_bits((i32)base2) - cy__ryu_pow5_bits((i32)i);
+    u32 correction = (cy__ryu_pow5_inv_offsets[i / 16] >> ((i % 16) << 1)) & 3;
+    res[0] = cy__u128_shift_right(low0, sum, delta) + 1 + correction;
+    res[1] = cy__u128_shift_right(sum, high1, delta);
+}
 
-    // NOTE(cya): because 'significant digits' includes integral part
-    if (style_auto) {
-        precision -= (i32)integral_len;
+cy_internal cy_inline u64 cy__ryu_mul_shift_64(u64 m, const u64 mul[2], i32 j)
+{
+    u64 high1, high0;
+    u64 low1 = cy__u64_mul_128(m, mul[1], &high1);
+    (void)cy__u64_mul_128(m, mul[0], &high0);
+    u64 sum = high0 + low1;
+    if (sum < high0) {
+        high1 += 1;
     }
 
-    f64 remainder = (n - (f64)integral);
-    if (style_hex && precision == -1) {
-        precision = 0;
-        while (remainder - (f64)(u64)remainder != 0.0) {
-            remainder *= (f64)info.base;
-            precision += 1;
+    return cy__u128_shift_right(sum, high1, j - 64);
+}
+
+cy_internal cy_inline u32 cy__ryu_mul_shift_32(u32 m, u64 factor, i32 shift)
+{
+    u64 bits0 = (u64)m * (u32)factor;
+    u64 bits1 = (u64)m * (u32)(factor >> 32);
+    u64 sum = (bits0 >> 32) + bits1;
+    return (u32)(sum >> (shift - 32));
+}
+
+typedef struct {
+    u64 mantissa;
+    i32 exponent;
+} CyPrivDecimalFloat;
+
+cy_internal CyPrivDecimalFloat cy__f64_to_shortest_decimal(
+    u64 ieee_mantissa, u32 ieee_exponent
+) {
+    const i32 mantissa_bits = 52, bias = 1023;
+
+    i32 e2;
+    u64 m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - bias - mantissa_bits - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = (i32)ieee_exponent - bias - mantissa_bits - 2;
+        m2 = (1ULL << mantissa_bits) | ieee_mantissa;
+    }
+
+    b32 accept_bounds = (m2 & 1) == 0;
+
+    // NOTE(cya): the interval of valid representations is [mm, mp] / 4
+    u64 mv = 4 * m2;
+    u32 mm_shift = (ieee_mantissa != 0 || ieee_exponent <= 1);
+
+    u64 vr, vp, vm;
+    i32 e10;
+    b32 vm_trailing_zeros = false;
+    b32 vr_trailing_zeros = false;
+    if (e2 >= 0) {
+        u32 q = cy__ryu_log10_pow2(e2) - (e2 > 3);
+        i32 k = CY__RYU_POW5_INV_BITCOUNT + cy__ryu_pow5_bits((i32)q) - 1;
+        i32 i = -e2 + (i32)q + k;
+        e10 = (i32)q;
+
+        u64 pow5[2];
+        cy__ryu_pow5_inv(q, pow5);
+        vr = cy__ryu_mul_shift_64(4 * m2, pow5, i);
+        vp = cy__ryu_mul_shift_64(4 * m2 + 2, pow5, i);
+        vm = cy__ryu_mul_shift_64(4 * m2 - 1 - mm_shift, pow5, i);
+        if (q <= 21) {
+            // NOTE(cya): only one of mp, mv and mm can be a multiple of 5
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = cy__ryu_is_multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros =
+                    cy__ryu_is_multiple_of_pow5(mv - 1 - mm_shift, q);
+            } else {
+                vp -= cy__ryu_is_multiple_of_pow5(mv + 2, q) ? 1 : 0;
+            }
         }
     } else {
-        const f64 *table = info.base == 16 ?
-            cy__pow_of_16_table : cy__pow_of_10_table;
-        remainder *= table[precision];
-    }
-
-    u64 decimal = (u64)remainder;
-    remainder -= (f64)decimal;
-    if (remainder > 0.5) {
-        decimal += 1;
-        if (decimal >= (u64)1e16) {
-            decimal = 0;
-            integral += 1;
-            if (exponent != 0 && integral >= 10) {
-                exponent += 1;
-                integral = 1;
+        u32 q = cy__ryu_log10_pow5(-e2) - (-e2 > 1);
+        i32 i = -e2 - (i32)q;
+        i32 k = cy__ryu_pow5_bits(i) - CY__RYU_POW5_BITCOUNT;
+        i32 j = (i32)q - k;
+        e10 = (i32)q + e2;
+
+        u64 pow5[2];
+        cy__ryu_pow5((u32)i, pow5);
+        vr = cy__ryu_mul_shift_64(4 * m2, pow5, j);
+        vp = cy__ryu_mul_shift_64(4 * m2 + 2, pow5, j);
+        vm = cy__ryu_mul_shift_64(4 * m2 - 1 - mm_shift, pow5, j);
+        if (q <= 1) {
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = (mm_shift == 1);
+            } else {
+                vp -= 1;
             }
+        } else if (q < 63) {
+            vr_trailing_zeros = cy__ryu_is_multiple_of_pow2(mv, q);
         }
     }
 
-    b32 print_decimal = precision > 0 &&
-        !(style_auto && !style_alt && decimal == 0);
-    b32 print_dot = print_decimal || style_alt;
-    if (print_dot) {
-        if (written < limit) {
-            *cur++ = '.';
-            written += 1;
+    // NOTE(cya): removing digits while the interval still has a candidate
+    i32 removed = 0;
+    u8 last_removed_digit = 0;
+    u64 output;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= (vm % 10 == 0);
+            vr_trailing_zeros &= (last_removed_digit == 0);
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10, vp /= 10, vm /= 10;
+            removed += 1;
         }
 
-        written_total += 1;
-    }
-
-    if (print_decimal) {
-        char *c = cur;
-        if (!style_auto || style_alt) {
-            i32 extra_digits = info.precision - precision;
-            while (extra_digits-- > 0) {
-                if (written < limit) {
-                    *c++ = '0';
-                    written += 1;
-                }
-
-                written_total += 1;
-            }
-        } else {
-            while (decimal % (u64)info.base == 0) {
-                decimal /= (u64)info.base;
-                precision -= 1;
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= (last_removed_digit == 0);
+                last_removed_digit = (u8)(vr % 10);
+                vr /= 10, vp /= 10, vm /= 10;
+                removed += 1;
             }
         }
 
-        const char *table = upper ?
-            cy__num_to_char_table_upper : cy__num_to_char_table_lower;
-        while (precision-- > 0) {
-            if (written < limit) {
-                *c++ = table[decimal % (u64)info.base];
-                written += 1;
-            }
+        // NOTE(cya): round half to even if the exact number is .....50..0
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+            last_removed_digit = 4;
+        }
 
-            decimal /= (u64)info.base;
-            written_total += 1;
+        b32 out_of_bounds = (vr == vm) &&
+            (!accept_bounds || !vm_trailing_zeros);
+        output = vr + (out_of_bounds || last_removed_digit >= 5);
+    } else {
+        b32 round_up = false;
+        if (vp / 100 > vm / 100) {
+            u64 vr_mod_100 = vr % 100;
+            round_up = (vr_mod_100 >= 50);
+            vr /= 100, vp /= 100, vm /= 100;
+            removed += 2;
         }
 
-        len = c - cur;
-        cy_str_reverse_n(cur, len);
-        cur += len;
+        while (vp / 10 > vm / 10) {
+            round_up = (vr % 10 >= 5);
+            vr /= 10, vp /= 10, vm /= 10;
+            removed += 1;
+        }
+
+        output = vr + (vr == vm || round_up);
     }
 
-    b32 print_exponent = swap &&
-        (style_exp || style_hex || (exponent != 0));
-    if (print_exponent) {
-        char c = style_hex ? 'p' : 'e';
-        c = cy__fmt_char_to_case(c, upper);
-        if (written < limit) {
-            *cur++ = c;
-            written += 1;
-        }
+    return (CyPrivDecimalFloat){
+        .mantissa = output,
+        .exponent = e10 + removed,
+    };
+}
 
-        written_total += 1;
-        c = (exponent < 0) ? '-' : '+';
-        if (written < limit) {
-            *cur++ = c;
-            written += 1;
+cy_internal CyPrivDecimalFloat cy__f32_to_shortest_decimal(
+    u32 ieee_mantissa, u32 ieee_exponent
+) {
+    const i32 mantissa_bits = 23, bias = 127;
+    const i32 pow5_inv_bitcount = CY__RYU_POW5_INV_BITCOUNT - 64;
+    const i32 pow5_bitcount = CY__RYU_POW5_BITCOUNT - 64;
+
+    i32 e2;
+    u32 m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - bias - mantissa_bits - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = (i32)ieee_exponent - bias - mantissa_bits - 2;
+        m2 = (1U << mantissa_bits) | ieee_mantissa;
+    }
+
+    b32 accept_bounds = (m2 & 1) == 0;
+
+    u32 mv = 4 * m2;
+    u32 mp = 4 * m2 + 2;
+    u32 mm_shift = (ieee_mantissa != 0 || ieee_exponent <= 1);
+    u32 mm = 4 * m2 - 1 - mm_shift;
+
+    // NOTE(cya): the upper half of the f64 multipliers is enough for f32s
+    u64 pow5[2];
+    u32 vr, vp, vm;
+    i32 e10;
+    b32 vm_trailing_zeros = false;
+    b32 vr_trailing_zeros = false;
+    u8 last_removed_digit = 0;
+    if (e2 >= 0) {
+        u32 q = cy__ryu_log10_pow2(e2);
+        i32 k = pow5_inv_bitcount + cy__ryu_pow5_bits((i32)q) - 1;
+        i32 i = -e2 + (i32)q + k;
+        e10 = (i32)q;
+
+        cy__ryu_pow5_inv(q, pow5);
+        vr = cy__ryu_mul_shift_32(mv, pow5[1] + 1, i);
+        vp = cy__ryu_mul_shift_32(mp, pow5[1] + 1, i);
+        vm = cy__ryu_mul_shift_32(mm, pow5[1] + 1, i);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            // NOTE(cya): we need to know one removed digit even if we don't
+            // end up removing any digits below
+            i32 l = pow5_inv_bitcount + cy__ryu_pow5_bits((i32)q - 1) - 1;
+            cy__ryu_pow5_inv(q - 1, pow5);
+            u32 v = cy__ryu_mul_shift_32(
+                mv, pow5[1] + 1, -e2 + (i32)q - 1 + l
+            );
+            last_removed_digit = (u8)(v % 10);
         }
 
-        written_total += 1;
-        exponent = CY_ABS(exponent);
-        if (!style_hex && exponent < 10) {
-            if (written < limit) {
-                *cur++ = '0';
-                written += 1;
+        if (q <= 9) {
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = cy__ryu_is_multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros = cy__ryu_is_multiple_of_pow5(mm, q);
+            } else {
+                vp -= cy__ryu_is_multiple_of_pow5(mp, q) ? 1 : 0;
             }
-
-            written_total += 1;
+        }
+    } else {
+        u32 q = cy__ryu_log10_pow5(-e2);
+        i32 i = -e2 - (i32)q;
+        i32 k = cy__ryu_pow5_bits(i) - pow5_bitcount;
+        i32 j = (i32)q - k;
+        e10 = (i32)q + e2;
+
+        cy__ryu_pow5((u32)i, pow5);
+        vr = cy__ryu_mul_shift_32(mv, pow5[1], j);
+        vp = cy__ryu_mul_shift_32(mp, pow5[1], j);
+        vm = cy__ryu_mul_shift_32(mm, pow5[1], j);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            j = (i32)q - 1 - (cy__ryu_pow5_bits(i + 1) - pow5_bitcount);
+            cy__ryu_pow5((u32)i + 1, pow5);
+            u32 v = cy__ryu_mul_shift_32(mv, pow5[1], j);
+            last_removed_digit = (u8)(v % 10);
         }
 
-        remaining = limit - written;
-        len_total = cy__print_i64(cur, remaining, (CyPrivFmtInfo){
-            .base = 10,
-            .precision = -1,
-            .value.i = exponent,
-        });
-
-        len = CY_MIN(len_total, remaining);
-        cur += len, written += len;
-        written_total += len_total;
+        if (q <= 1) {
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = (mm_shift == 1);
+            } else {
+                vp -= 1;
+            }
+        } else if (q < 31) {
+            vr_trailing_zeros = cy__ryu_is_multiple_of_pow2(mv, q - 1);
+        }
     }
 
-    len = cur - dst;
-    b32 fill_with_zeros = !custom_precision && (len < info.width) &&
-        (info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS);
-    if (fill_with_zeros) {
-        remaining = limit - written;
+    i32 removed = 0;
+    u32 output;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= (vm % 10 == 0);
+            vr_trailing_zeros &= (last_removed_digit == 0);
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10, vp /= 10, vm /= 10;
+            removed += 1;
+        }
+
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= (last_removed_digit == 0);
+                last_removed_digit = (u8)(vr % 10);
+                vr /= 10, vp /= 10, vm /= 10;
+                removed += 1;
+            }
+        }
 
-        isize prefix_len = num_start - dst;
-        isize extra_total = info.width - len;
-        isize extra = CY_MIN(extra_total, remaining);
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+            last_removed_digit = 4;
+        }
 
-        cy_mem_move(num_start + extra, num_start, len - prefix_len);
-        cy_mem_set(num_start, '0', extra);
+        b32 out_of_bounds = (vr == vm) &&
+            (!accept_bounds || !vm_trailing_zeros);
+        output = vr + (out_of_bounds || last_removed_digit >= 5);
+    } else {
+        while (vp / 10 > vm / 10) {
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10, vp /= 10, vm /= 10;
+            removed += 1;
+        }
 
-        written += extra;
-        written_total += extra_total;
+        output = vr + (vr == vm || last_removed_digit >= 5);
     }
 
-    return written_total;
+    return (CyPrivDecimalFloat){
+        .mantissa = output,
+        .exponent = e10 + removed,
+    };
 }
 
-#ifndef CY_STD_C_PRINTF
-cy_global const char *cy__b32_to_str_table[4] = {
-    "false", "true",
-    "FALSE", "TRUE",
-};
-#endif
-
-isize cy_sprintf_va(char *buf, isize size, const char *fmt, va_list va)
+cy_internal cy_inline u64 cy__f64_to_bits(f64 n)
 {
-    // NOTE(cya): written_total is how much _would_ be written in case the buf
-    // wasn't large enough, while written is how much _was_ written which can
-    // truncate if we reach the end of the buffer, that way we can report the
-    // amount of bytes necessary for this whole conversion to work and the user
-    // can allocate a suitable buffer if needed and then recall this procedure
-    // (all the cy__print_* subprocs use this pattern to propagate this logic)
-    const isize limit = size - 1;
-    isize written_total = 0;
-    isize written = 0;
-
-    char conv_buf_static[CY__FMT_STATIC_BUF_SIZE];
-    isize conv_cap_static = CY_ARRAY_LEN(conv_buf_static) - 1;
-    char *conv_buf_heap = NULL;
-    isize conv_cap_heap = 0;
+    u64 bits;
+    cy_mem_copy(&bits, &n, cy_sizeof(bits));
+    return bits;
+}
 
-    char *end = buf;
-    const char *f = fmt;
-    for (;;) {
-        for (; *f != '\0' && *f != '%'; f++) {
-            char c = *f;
-#if defined(CY_OS_WINDOWS)
-            // NOTE(cya): LF -> CRLF conversion
-            if (c == '\n') {
-                if (f - fmt < 1 || *(f - 1) != '\r') {
-                    if (written < limit) {
-                        *end++ = '\r';
-                        written += 1;
-                    }
+cy_internal cy_inline u32 cy__f32_to_bits(f32 n)
+{
+    u32 bits;
+    cy_mem_copy(&bits, &n, cy_sizeof(bits));
+    return bits;
+}
 
-                    written_total += 1;
-                }
-            }
-#endif
+// NOTE(cya): only for finite, non-zero values (the sign is ignored)
+cy_internal CyPrivDecimalFloat cy__f64_shortest(f64 n)
+{
+    u64 bits = cy__f64_to_bits(n);
+    u64 ieee_mantissa = bits & ((1ULL << 52) - 1);
+    u32 ieee_exponent = (u32)((bits >> 52) & 0x7FF);
+    return cy__f64_to_shortest_decimal(ieee_mantissa, ieee_exponent);
+}
 
-            if (written < limit) {
-                *end++ = c;
-                written += 1;
-            }
+cy_internal CyPrivDecimalFloat cy__f32_shortest(f32 n)
+{
+    u32 bits = cy__f32_to_bits(n);
+    u32 ieee_mantissa = bits & ((1U << 23) - 1);
+    u32 ieee_exponent = (bits >> 23) & 0xFF;
+    return cy__f32_to_shortest_decimal(ieee_mantissa, ieee_exponent);
+}
 
-            written_total += 1;
+/*
+ * Writes a decimal float with %g's rules for the given precision (it's never
+ * rounded, so it should have at most `precision` significant digits). When
+ * `alt` is set, the trailing zeros and the dot are kept, like with %#g
+ * NOTE: make sure buf has at least 32 bytes of capacity
+ */
+cy_internal isize cy__f64_format_general(
+    char *buf, CyPrivDecimalFloat dec, i32 precision, b32 alt, b32 upper
+) {
+    char digits[24];
+    isize digit_count = cy__u64_digit_count(dec.mantissa, 10);
+    cy__u64_write_digits(dec.mantissa, 10, NULL, digits + digit_count);
+
+    isize shown = alt ? precision : digit_count;
+    i32 exp = dec.exponent + (i32)digit_count - 1;
+    char *c = buf;
+    if (exp < -4 || exp >= precision) {
+        *c++ = digits[0];
+        if (shown > 1 || alt) {
+            *c++ = '.';
         }
-
-        if (*f++ == '\0') {
-            break;
+        for (isize i = 1; i < shown; i++) {
+            *c++ = (i < digit_count) ? digits[i] : '0';
         }
 
-        CyPrivFmtInfo info = {.precision = -1};
-        b32 done = false;
-        do {
-            switch (*f++) {
-            case '-': {
-                info.flags |= CY__FMT_MINUS;
-            } break;
-            case '+': {
-                info.flags |= CY__FMT_PLUS;
-            } break;
-            case ' ': {
-                info.flags |= CY__FMT_SPACE;
-            } break;
-            case '#': {
-                info.flags |= CY__FMT_HASH;
-            } break;
-            case '0': {
-                info.flags |= CY__FMT_ZERO;
-            } break;
-            default: {
-                done = true;
-                f -= 1;
-            } break;
-            }
-        } while (!done);
-
-        if (cy_char_is_digit(*f)) {
-            u64 width;
-            isize len = cy__scan_u64(f, 10, &width);
-            info.width = (i32)width;
-            f += len;
-        } else if (*f == '*') {
-            info.width = va_arg(va, int);
-            f += 1;
+        *c++ = upper ? 'E' : 'e';
+        *c++ = (exp < 0) ? '-' : '+';
+        if (exp > -10 && exp < 10) {
+            *c++ = '0';
         }
 
-        if (*f == '.') {
-            isize len = 1;
-            if (*++f == '*') {
-                info.precision = va_arg(va, int);
-            } else {
-                i64 precision;
-                len = cy__scan_i64(f, 10, &precision);
-                if (precision >= 0) {
-                    info.precision = (i32)precision;
-                }
-            }
-
-            f += len;
+        c += cy_str_parse_u64((u64)CY_ABS(exp), 10, c);
+    } else if (exp >= 0) {
+        isize i = 0;
+        for (; i <= exp; i++) {
+            *c++ = (i < digit_count) ? digits[i] : '0';
         }
-
-        switch (*f++) {
-        case 'h': {
-            if (*f == 'h') {
-                info.flags |= CY__FMT_LEN_CHAR;
-                f += 1;
-            } else {
-                info.flags |= CY__FMT_LEN_SHORT;
-            }
-        } break;
-        case 'l': {
-            if (*f == 'l') {
-                info.flags |= CY__FMT_LEN_LONG_LONG;
-                f += 1;
-            } else {
-                info.flags |= CY__FMT_LEN_LONG;
-            }
-        } break;
-        case 'j': {
-            info.flags |= CY__FMT_LEN_INTMAX;
-        } break;
-        case 'z': {
-            info.flags |= CY__FMT_LEN_SIZE;
-        } break;
-        case 't': {
-            info.flags |= CY__FMT_LEN_PTRDIFF;
-        } break;
-        case 'L': {
-            info.flags |= CY__FMT_LEN_LONG_DOUBLE;
-        } break;
-        default: {
-            f -= 1;
-        } break;
+        if (shown > i || alt) {
+            *c++ = '.';
+        }
+        for (; i < shown; i++) {
+            *c++ = (i < digit_count) ? digits[i] : '0';
+        }
+    } else {
+        *c++ = '0';
+        *c++ = '.';
+        for (i32 i = exp + 1; i < 0; i++) {
+            *c++ = '0';
+        }
+        for (isize i = 0; i < shown; i++) {
+            *c++ = (i < digit_count) ? digits[i] : '0';
         }
+    }
 
-        char *conv_buf = conv_buf_static;
-        isize conv_cap = conv_cap_static;
-        CyPrivPrintProc *print_proc = NULL;
-        isize conv_len = 0;
-        b32 out_arg = false;
-        switch (*f) {
-        case 'd':
-        case 'i': {
-            info.flags |= CY__FMT_INT;
-            info.base = 10;
-        } break;
-        case 'o':
-        case 'u':
-        case 'x':
-        case 'X': {
-            info.flags |= CY__FMT_UNSIGNED;
-            switch (*f) {
-            case 'o': {
-                info.base = 8;
-            } break;
-            case 'u': {
-                info.base = 10;
-            } break;
-            case 'x':
-            case 'X': {
-                info.base = 16;
-                if (cy_char_is_upper(*f)) {
-                    info.flags |= CY__FMT_STYLE_UPPER;
-                }
-            } break;
-            }
-        } break;
-        case 'f':
-        case 'F':
-        case 'e':
-        case 'E':
-        case 'g':
-        case 'G':
-        case 'a':
-        case 'A': {
-            info.flags |= CY__FMT_FLOAT;
-            info.base = 10;
-            switch (cy_char_to_lower(*f)) {
-            case 'e': {
-                info.flags |= CY__FMT_STYLE_EXP;
-            } break;
-            case 'g': {
-                info.flags |= CY__FMT_STYLE_AUTO;
-            } break;
-            case 'a': {
-                info.base = 16;
-            } break;
-            }
+    return c - buf;
+}
 
-            if (cy_char_is_upper(*f)) {
-                info.flags |= CY__FMT_STYLE_UPPER;
-            }
-        } break;
-        case 'c': {
-            if (info.flags & CY__FMT_LEN_LONG) {
-                // TODO(cya): convert from wcs to mbs (is it even worth it?)
-            } else {
-                *(u8*)conv_buf = (u8)va_arg(va, int);
-                conv_len = 1;
-            }
-        } break;
-        case 's': {
-            if (info.flags & CY__FMT_LEN_LONG) {
-                // TODO(cya): same as the todo above
-            } else {
-                const char *str = va_arg(va, char*);
-                info.value.s = cy_string_view_create_c(str);
-                print_proc = cy__print_str;
-            }
-        } break;
-        case 'p': {
-            void *ptr = va_arg(va, void*);
-            print_proc = cy__print_u64;
-            info = (CyPrivFmtInfo){
-                .base = 16,
-                .flags = (CY__FMT_ZERO | CY__FMT_STYLE_UPPER | CY__FMT_HASH),
-                .width = 16,
-                .value.u = (u64)ptr,
-            };
-        } break;
-        case 'n': {
-            out_arg = true;
-        } break;
-        case '%': {
-            *conv_buf = '%';
-            conv_len = 1;
-        } break;
-#ifndef CY_STD_C_PRINTF // NOTE(cya): extended format specifiers
-        case 'b':
-        case 'B': { // NOTE(cya): binary ints
-            info.flags |= CY__FMT_UNSIGNED;
-            info.base = 2;
-            if (cy_char_is_upper(*f)) {
-                info.flags |= CY__FMT_STYLE_UPPER;
-            }
-        } break;
-        case 'q':
-        case 'Q': {
-            isize ofs = cy_char_is_upper(*f) ? 2 : 0;
-
-            b32 val = !!(b32)va_arg(va, int);
-            const char *str = cy__b32_to_str_table[ofs + val];
-            info.value.s = cy_string_view_create_c(str);
-            print_proc = cy__print_str;
-        } break;
-        case 'v': {
-            info.value.s = va_arg(va, CyStringView);
-            print_proc = cy__print_str;
-        } break;
-#endif
-        default: {
-            (void)va_arg(va, uintptr);
-            const char *msg = "%!(missing format specifier)";
-            info.value.s = cy_string_view_create_c(msg);
-            info.width = 0;
-            print_proc = cy__print_str;
-            goto fmt_convert;
-        } break;
-        }
+/*
+ * String -> float conversion: up to 19 significant digits are gathered into a
+ * 64-bit mantissa (eight at a time with SWAR where possible), which is then
+ * converted either with Clinger's fast path (when both the mantissa and the
+ * power of 10 are exact doubles) or with the Eisel-Lemire algorithm (one or
+ * two 64x128-bit multiplications). The few inputs it can't decide on (exact
+ * halfway points, subnormals, truncated mantissas that round differently)
+ * fall back to a slow but exact decimal shifting conversion
+ *
+ * The 128-bit approximations of 5^q (rounded down, normalized to have their
+ * top bit set) are reconstructed from every 26th power just like the Ryu
+ * tables above, reusing cy__ryu_pow5_table for the small powers
+ */
+#define CY__EISEL_LEMIRE_MIN_EXP10 (-342)
+#define CY__EISEL_LEMIRE_MAX_EXP10 308
+
+cy_global const u64 cy__eisel_lemire_pow5_split[26][2] = {
+    { 0x82189c09a3a1ec21ULL, 0xe1afa13afbd14d6dULL }, // 5^-364
+    { 0x79071b9b8a4be869ULL, 0x91d8a02bb6c10594ULL }, // 5^-338
+    { 0xc605083704f5ecf2ULL, 0xbc807527ed3e12bcULL }, // 5^-312
+    { 0x6b43527578c1110fULL, 0xf3a20279ed56d48aULL }, // 5^-286
+    { 0x6f773fc3603db4a9ULL, 0x9d71ac8fada6c9b5ULL }, // 5^-260
+    { 0xa9942f5dcf7dfd09ULL, 0xcb7ddcdda26da268ULL }, // 5^-234
+    { 0x4247cb9e59f71e6dULL, 0x8380dea93da4bc60ULL }, // 5^-208
+    { 0x5e9fcf4ccd211f4cULL, 0xa9f6d30a038d1dbcULL }, // 5^-182
+    { 0xdf45f746b74abf39ULL, 0xdbac6c247d62a583ULL }, // 5^-156
+    { 0xca8d3ffa1ef463c1ULL, 0x8df5efabc5979c8fULL }, // 5^-130
+    { 0x09ce6ebb40173744ULL, 0xb77ada0617e3bbcbULL }, // 5^-104
+    { 0x290123e9aab23b68ULL, 0xed246723473e3813ULL }, // 5^-78
+    { 0xe546a8038efe4029ULL, 0x993fe2c6d07b7fabULL }, // 5^-52
+    { 0x95364afe032a819dULL, 0xc612062576589ddaULL }, // 5^-26
+    { 0x0000000000000000ULL, 0x8000000000000000ULL }, // 5^0
+    { 0x0000000000000000ULL, 0xa56fa5b99019a5c8ULL }, // 5^26
+    { 0x72a4904598d6d880ULL, 0xd5d238a4abe98068ULL }, // 5^52
+    { 0x6e3569326c784337ULL, 0x8a2dbf142dfcc7abULL }, // 5^78
+    { 0x58edec91ec2cb657ULL, 0xb2977ee300c50fe7ULL }, // 5^104
+    { 0xa60dc059157491e5ULL, 0xe6d3102ad96cec1dULL }, // 5^130
+    { 0xdd945a747bf26183ULL, 0x952ab45cfa97a0b2ULL }, // 5^156
+    { 0x84576a1bb416a7ddULL, 0xc0cb28a98fcf3c7fULL }, // 5^182
+    { 0xa7709a56ccdf8a82ULL, 0xf92e0c3537826145ULL }, // 5^208
+    { 0xb24cf65b8612f81fULL, 0xa1075a24e4421730ULL }, // 5^234
+    { 0x2d2b7569b0432d85ULL, 0xd01fef10a657842cULL }, // 5^260
+    { 0x49ed8eabcccc485dULL, 0x867f59a9d4bed6c0ULL }, // 5^286
+};
 
-        f += 1;
+cy_global const u32 cy__eisel_lemire_pow5_offsets[41] = {
+    0x55555440, 0x06551514, 0x01450500, 0x00000000, 0x00001001, 0x40100000,
+    0x44504101, 0x01055405, 0x41010050, 0x50551514, 0x01040000, 0x00000040,
+    0x50000000, 0x55555400, 0x05455555, 0x40405514, 0x54405455, 0x15555100,
+    0x00000004, 0x00011001, 0x01000050, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00141000, 0x41401050, 0x05440505, 0x50501555,
+    0x14545511, 0x05115545, 0x54514545, 0x55556455, 0x40140595, 0x04040504,
+    0x50155514, 0x00055115, 0x00000000, 0x50144000, 0x00111055,
+};
 
-#ifndef CY_STD_C_PRINTF
-        // NOTE(cya): parsing sized format specs (%u64, %d32, %i16, etc.)
-        u8 bit_size = 0, skip = 1;
-        if ((info.flags & CY__FMT_INTS) && cy_char_is_digit(*f)) {
-            switch (*f) {
-            case '8': {
-                bit_size = 8;
-            } break;
-            case '1': {
-                if (*(f + 1) == '6') {
-                    bit_size = 16;
-                    skip += 1;
-                }
-            } break;
-            case '3': {
-                if (*(f + 1) == '2') {
-                    bit_size = 32;
-                    skip += 1;
-                }
-            } break;
-            case '6': {
-                if (*(f + 1) == '4') {
-                    bit_size = 64;
-                    skip += 1;
-                }
-            } break;
-            default: {
-                skip = 0;
-            } break;
-            }
+cy_global const f64 cy__pow_of_10_exact_table[23] = {
+    1e00, 1e01, 1e02, 1e03, 1e04, 1e05, 1e06, 1e07, 1e08, 1e09, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
 
-            f += skip;
-        }
-
-        if (bit_size > 0) {
-            if (info.flags & CY__FMT_UNSIGNED) {
-                u64 val = 0;
-                switch (bit_size) {
-                case 8: {
-                    val = (u64)((u8)va_arg(va, int));
-                } break;
-                case 16: {
-                    val = (u64)((u16)va_arg(va, int));
-                } break;
-                case 32: {
-                    val = (u64)va_arg(va, u32);
-                } break;
-                case 64: {
-                    val = va_arg(va, u64);
-                } break;
-                }
+cy_internal void cy__eisel_lemire_pow5(i32 q, u64 *lo, u64 *hi)
+{
+    i32 idx = q - CY__EISEL_LEMIRE_MIN_EXP10;
+    i32 base = (q + 364) / 26;
+    i32 offset = q + 364 - base * 26;
+    u64 res_lo = cy__eisel_lemire_pow5_split[base][0];
+    u64 res_hi = cy__eisel_lemire_pow5_split[base][1];
+    if (offset != 0) {
+        u64 m = cy__ryu_pow5_table[offset];
+        u64 high0, high1;
+        u64 low0 = cy__u64_mul_128(res_lo, m, &high0);
+        u64 low1 = cy__u64_mul_128(res_hi, m, &high1);
+        u64 mid = low1 + high0;
+        u64 top = high1 + (mid < low1);
 
-                info.value.u = val;
-                print_proc = cy__print_u64;
-                goto fmt_convert;
-            } else if (info.flags & CY__FMT_INT) {
-                i64 val = 0;
-                switch (bit_size) {
-                case 8: {
-                    val = (i64)((i8)va_arg(va, int));
-                } break;
-                case 16: {
-                    val = (i64)((i16)va_arg(va, int));
-                } break;
-                case 32: {
-                    val = (i64)va_arg(va, i32);
-                } break;
-                case 64: {
-                    val = va_arg(va, i64);
-                } break;
-                }
+        // NOTE(cya): m >= 5 and m < 2^61, so 0 < shift < 64
+        i32 shift = cy__u64_bit_len(top);
+        res_hi = cy__u128_shift_right(mid, top, shift);
+        res_lo = cy__u128_shift_right(low0, mid, shift);
+    }
 
-                info.value.i = val;
-                print_proc = cy__print_i64;
-                goto fmt_convert;
-            } else {
-                f -= skip;
-            }
+    u32 corr_word = cy__eisel_lemire_pow5_offsets[idx / 16];
+    u32 corr = (corr_word >> ((idx % 16) * 2)) & 3;
+    res_lo += corr;
+    res_hi += (res_lo < corr);
+
+    *lo = res_lo;
+    *hi = res_hi;
+}
+
+/*
+ * Converts w * 10^q to binary64 bits (w != 0, q in the table's range)
+ * NOTE: returns false when the result can't be decided with 128 bits of
+ * precision or when it's subnormal/infinite (so the caller has to fall back)
+ */
+cy_internal b32 cy__eisel_lemire_f64(u64 w, i32 q, u64 *bits)
+{
+    i32 clz = 64 - cy__u64_bit_len(w);
+    w <<= clz;
+
+    // NOTE(cya): floor(q * log2(10)) + 64 + bias - clz
+    i64 exp2 = (((i64)217706 * q) >> 16) + 64 + 1023 - clz;
+
+    u64 pow_lo, pow_hi;
+    cy__eisel_lemire_pow5(q, &pow_lo, &pow_hi);
+
+    u64 x_hi;
+    u64 x_lo = cy__u64_mul_128(w, pow_hi, &x_hi);
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + w < w) {
+        u64 y_hi;
+        u64 y_lo = cy__u64_mul_128(w, pow_lo, &y_hi);
+        u64 merged_lo = x_lo + y_hi;
+        u64 merged_hi = x_hi + (merged_lo < x_lo);
+        if (
+            (merged_hi & 0x1FF) == 0x1FF &&
+            merged_lo + 1 == 0 && y_lo + w < w
+        ) {
+            return false;
         }
-#endif
 
-        if (out_arg) {
-            void *out = va_arg(va, void*);
-            if (out != NULL) {
-                isize val = written_total;
-                switch (info.flags & CY__FMT_LEN_MODS) {
-                case CY__FMT_LEN_CHAR: {
-                    *((signed char*)out) = (signed char)val;
-                } break;
-                case CY__FMT_LEN_SHORT: {
-                    *((short*)out) = (short)val;
-                } break;
-                case CY__FMT_LEN_LONG: {
-                    *((long*)out) = (long)val;
-                } break;
-                case CY__FMT_LEN_LONG_LONG: {
-                    *((long long*)out) = (long long)val;
-                } break;
-                case CY__FMT_LEN_INTMAX: {
-                    *((intmax_t*)out) = (intmax_t)val;
-                } break;
-                case CY__FMT_LEN_SIZE:
-                case CY__FMT_LEN_PTRDIFF: {
-                    *((isize*)out) = val;
-                } break;
-                default: {
-                    *((int*)out) = (int)val;
-                } break;
-                }
-            }
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
 
-            continue;
-        } else if (info.base != 0) { // NOTE(cya): print a number (C notation)
-            if (info.flags & CY__FMT_INTS) {
-                if (info.flags & CY__FMT_UNSIGNED) {
-                    u64 val;
-                    switch (info.flags & CY__FMT_LEN_MODS) {
-                    case CY__FMT_LEN_CHAR: {
-                        val = (u64)((unsigned char)va_arg(va, int));
-                    } break;
-                    case CY__FMT_LEN_SHORT: {
-                        val = (u64)((unsigned short)va_arg(va, int));
-                    } break;
-                    case CY__FMT_LEN_LONG: {
-                        val = (u64)va_arg(va, unsigned long);
-                    } break;
-                    case CY__FMT_LEN_LONG_LONG: {
-                        val = (u64)va_arg(va, unsigned long long);
-                    } break;
-                    case CY__FMT_LEN_INTMAX: {
-                        val = (u64)va_arg(va, uintmax_t);
-                    } break;
-                    case CY__FMT_LEN_SIZE:
-                    case CY__FMT_LEN_PTRDIFF: {
-                        val = (u64)va_arg(va, usize);
-                    } break;
-                    default: {
-                        val = (u64)va_arg(va, unsigned);
-                    } break;
-                    }
+    u64 msb = x_hi >> 63;
+    u64 mantissa = x_hi >> (msb + 9);
+    exp2 -= (i64)(1 ^ msb);
 
-                    info.value.u = val;
-                    print_proc = cy__print_u64;
-                } else if (info.flags & CY__FMT_INT) {
-                    i64 val;
-                    switch (info.flags & CY__FMT_LEN_MODS) {
-                    case CY__FMT_LEN_CHAR: {
-                        val = (i64)((signed char)va_arg(va, int));
-                    } break;
-                    case CY__FMT_LEN_SHORT: {
-                        val = (i64)((short)va_arg(va, int));
-                    } break;
-                    case CY__FMT_LEN_LONG: {
-                        val = (i64)va_arg(va, long);
-                    } break;
-                    case CY__FMT_LEN_LONG_LONG: {
-                        val = (i64)va_arg(va, long long);
-                    } break;
-                    case CY__FMT_LEN_INTMAX: {
-                        val = (i64)va_arg(va, intmax_t);
-                    } break;
-                    case CY__FMT_LEN_SIZE:
-                    case CY__FMT_LEN_PTRDIFF: {
-                        val = (i64)va_arg(va, isize);
-                    } break;
-                    default: {
-                        val = (i64)va_arg(va, int);
-                    } break;
-                    }
+    // NOTE(cya): might be exactly halfway between two floats
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (mantissa & 3) == 1) {
+        return false;
+    }
 
-                    info.value.i = val;
-                    print_proc = cy__print_i64;
-                }
-            } else if (info.flags & CY__FMT_FLOAT) {
-                info.value.f = info.flags & CY__FMT_LEN_LONG_DOUBLE ?
-                    (f64)va_arg(va, long double) : va_arg(va, f64);
-                print_proc = cy__print_f64;
-            }
-        }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >> 53) {
+        mantissa >>= 1;
+        exp2 += 1;
+    }
+    if (exp2 <= 0 || exp2 >= 0x7FF) {
+        return false;
+    }
 
-fmt_convert:
-        if (print_proc != NULL) {
-            conv_len = print_proc(conv_buf, conv_cap, info);
-            isize remaining = limit - written;
-            if (conv_len > conv_cap && conv_cap < remaining) {
-                // TODO(cya): allocate heap buf and reapply conversion
-                conv_cap = conv_len + 1;
-                char *new_heap_buf = cy_default_resize(
-                    cy_heap_allocator(), conv_buf_heap,
-                    conv_cap_heap, conv_cap
-                );
-                if (new_heap_buf == NULL) {
-                    // TODO(cya): maybe this could be handled better?
-                    cy_free(cy_heap_allocator(), conv_buf_heap);
-                    return -1;
-                }
+    *bits = ((u64)exp2 << 52) | (mantissa & ((1ULL << 52) - 1));
+    return true;
+}
 
-                conv_buf_heap = new_heap_buf;
-                conv_cap_heap = conv_cap;
-                conv_buf = conv_buf_heap;
-                conv_len = print_proc(conv_buf, conv_cap, info);
-            }
-        }
+#define CY__BIG_DECIMAL_MAX_DIGITS 800
 
+// NOTE(cya): 0.d0d1d2... * 10^decimal_point, with no trailing zeros
+typedef struct {
+    i32 digit_count;
+    i32 decimal_point;
+    b32 truncated;
+    u8 digits[CY__BIG_DECIMAL_MAX_DIGITS];
+} CyPrivBigDecimal;
 
-        b32 right_pad = info.flags & CY__FMT_MINUS;
-        b32 fill_with_zeros = !right_pad && (info.flags & CY__FMT_ZERO);
-        if (!fill_with_zeros && conv_len < info.width) {
-            // NOTE(cya): truncating to remaining length
-            isize remaining = conv_cap - conv_len;
-            char *conv_end = conv_buf + conv_len;
+cy_internal void cy__big_decimal_trim(CyPrivBigDecimal *d)
+{
+    while (d->digit_count > 0 && d->digits[d->digit_count - 1] == 0) {
+        d->digit_count -= 1;
+    }
+}
 
-            isize extra = CY_MIN(info.width - conv_len, remaining);
-            if (right_pad) {
-                cy_mem_set(conv_end, ' ', extra);
-            } else { // NOTE(cya): npm
-                cy_mem_move(conv_buf + extra, conv_buf, conv_len);
-                cy_mem_set(conv_buf, ' ', extra);
-            }
+// NOTE(cya): s points to the start of the mantissa (after the sign)
+cy_internal void cy__big_decimal_init(
+    CyPrivBigDecimal *d, const char *s, i64 exp10
+) {
+    *d = (CyPrivBigDecimal){0};
 
-            conv_len += extra;
+    i64 point = 0;
+    b32 seen_dot = false;
+    for (;; s++) {
+        char c = *s;
+        if (c == '.' && !seen_dot) {
+            seen_dot = true;
+            continue;
+        } else if (!cy_char_is_digit(c)) {
+            break;
         }
 
-        if (written < limit) {
-            isize remaining = limit - written;
-            isize copy_len = CY_MIN(remaining, conv_len);
+        if (c == '0' && d->digit_count == 0) {
+            point -= seen_dot ? 1 : 0;
+            continue;
+        }
 
-            cy_mem_copy(end, conv_buf, copy_len);
-            end += copy_len, written += copy_len;
+        point += seen_dot ? 0 : 1;
+        if (d->digit_count < CY__BIG_DECIMAL_MAX_DIGITS) {
+            d->digits[d->digit_count++] = (u8)(c - '0');
+        } else if (c != '0') {
+            d->truncated = true;
         }
+    }
+
+    point += exp10;
+    d->decimal_point = (i32)CY_MAX(CY_MIN(point, 0x10000), -0x10000);
+    cy__big_decimal_trim(d);
+}
 
-        written_total += conv_len;
+cy_internal void cy__big_decimal_shift_left(CyPrivBigDecimal *d, u32 shift)
+{
+    if (d->digit_count == 0) {
+        return;
     }
 
-    if (conv_buf_heap != NULL) {
-        cy_free(cy_heap_allocator(), conv_buf_heap);
+    // NOTE(cya): shifting by up to 60 bits adds at most 19 digits
+    u8 rev[CY__BIG_DECIMAL_MAX_DIGITS + 20];
+    i32 count = 0;
+    u64 n = 0;
+    for (i32 i = d->digit_count - 1; i >= 0; i--) {
+        n += (u64)d->digits[i] << shift;
+        rev[count++] = (u8)(n % 10);
+        n /= 10;
+    }
+    for (; n > 0; n /= 10) {
+        rev[count++] = (u8)(n % 10);
     }
 
-    if (end != NULL) {
-        *end = '\0';
+    d->decimal_point += count - d->digit_count;
+    d->digit_count = CY_MIN(count, CY__BIG_DECIMAL_MAX_DIGITS);
+    for (i32 i = 0; i < count; i++) {
+        u8 digit = rev[count - 1 - i];
+        if (i < d->digit_count) {
+            d->digits[i] = digit;
+        } else if (digit != 0) {
+            d->truncated = true;
+        }
     }
 
-    return written_total;
+    cy__big_decimal_trim(d);
 }
 
-/* ============================= Virtual memory ============================= */
-cy_global CyOSMemoryBlock cy__os_memory_block_sentinel = {
-    .prev = &cy__os_memory_block_sentinel,
-    .next = &cy__os_memory_block_sentinel,
-};
+cy_internal void cy__big_decimal_shift_right(CyPrivBigDecimal *d, u32 shift)
+{
+    i32 r = 0, w = 0;
+    u64 n = 0;
+    for (; (n >> shift) == 0; r++) {
+        if (r >= d->digit_count) {
+            if (n == 0) {
+                d->digit_count = 0;
+                return;
+            }
+            for (; (n >> shift) == 0; r++) {
+                n *= 10;
+            }
 
-cy_internal CyOSMemoryBlock *cy__os_virtual_memory_reserve(isize size);
-cy_internal void cy__os_virtual_memory_commit(void *mem, isize size);
-cy_internal void cy__os_virtual_memory_free(CyOSMemoryBlock *block);
-cy_internal void cy__os_virtual_memory_protect(void *memory, isize size);
+            break;
+        }
 
-cy_inline CyMemoryBlock *cy_virtual_memory_alloc(isize size)
-{
-    return cy_virtual_memory_alloc_reserve(size, size);
+        n = n * 10 + d->digits[r];
+    }
+
+    d->decimal_point -= r - 1;
+    u64 mask = (1ULL << shift) - 1;
+    for (; r < d->digit_count; r++) {
+        u8 digit = d->digits[r];
+        d->digits[w++] = (u8)(n >> shift);
+        n = (n & mask) * 10 + digit;
+    }
+    for (; n > 0; n = (n & mask) * 10) {
+        u8 digit = (u8)(n >> shift);
+        if (w < CY__BIG_DECIMAL_MAX_DIGITS) {
+            d->digits[w++] = digit;
+        } else if (digit != 0) {
+            d->truncated = true;
+        }
+    }
+
+    d->digit_count = w;
+    cy__big_decimal_trim(d);
 }
 
-CyMemoryBlock *cy_virtual_memory_alloc_reserve(isize size, isize commit_size)
+// NOTE(cya): integer part, rounded to nearest (ties to even)
+cy_internal u64 cy__big_decimal_round(const CyPrivBigDecimal *d)
 {
-    CY_ASSERT(commit_size <= size);
+    if (d->digit_count == 0 || d->decimal_point < 0) {
+        return 0;
+    } else if (d->decimal_point > 18) {
+        return U64_MAX;
+    }
 
-    isize page_size = cy_virtual_memory_page_size(NULL);
-    isize total_size = size + cy_sizeof(CyOSMemoryBlock);
-    isize total_commit_size = commit_size + cy_sizeof(CyOSMemoryBlock);
-    isize start_offset = cy_sizeof(CyOSMemoryBlock);
+    i32 point = d->decimal_point;
+    u64 n = 0;
+    for (i32 i = 0; i < point; i++) {
+        n = n * 10 + ((i < d->digit_count) ? d->digits[i] : 0);
+    }
 
-    isize aligned_size = cy_align_forward_size(total_size, page_size);
-    isize aligned_commit_size = cy_align_forward_size(
-        total_commit_size, page_size
-    );
-    total_size = aligned_size + 2 * page_size;
-    total_commit_size = page_size + aligned_commit_size;
+    b32 round_up = false;
+    if (point < d->digit_count) {
+        round_up = d->digits[point] >= 5;
+        if (d->digits[point] == 5 && point + 1 == d->digit_count) {
+            round_up = d->truncated ||
+                (point > 0 && (d->digits[point - 1] & 1));
+        }
+    }
 
-    start_offset = page_size + aligned_size - size;
-    isize protect_offset = page_size + aligned_size;
+    return n + (round_up ? 1 : 0);
+}
 
-    CyOSMemoryBlock *os_block = cy__os_virtual_memory_reserve(total_size);
-    CY_ASSERT_MSG(os_block != NULL, "out of virtual memory D:");
+cy_internal u64 cy__big_decimal_to_f64_bits(CyPrivBigDecimal *d)
+{
+    // NOTE(cya): the biggest shifts that don't lose precision for 10^n
+    cy_persist const u8 shifts[19] = {
+        0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59,
+    };
+    const u64 inf_bits = 0x7FFULL << 52;
+    if (d->digit_count == 0 || d->decimal_point < -324) {
+        return 0;
+    } else if (d->decimal_point >= 310) {
+        return inf_bits;
+    }
+
+    // NOTE(cya): scale the value to [1/2, 1) in powers of two
+    i32 exp2 = 0;
+    while (d->decimal_point > 0) {
+        u32 n = (u32)d->decimal_point;
+        u32 shift = (n < CY_ARRAY_LEN(shifts)) ? shifts[n] : 60;
+        cy__big_decimal_shift_right(d, shift);
+        exp2 += (i32)shift;
+    }
+    while (d->decimal_point <= 0) {
+        u32 shift;
+        if (d->decimal_point == 0) {
+            if (d->digits[0] >= 5) {
+                break;
+            }
 
-    cy__os_virtual_memory_commit(os_block, total_commit_size);
-    CY_ASSERT(os_block->block.start == NULL);
+            shift = (d->digits[0] < 2) ? 2 : 1;
+        } else {
+            u32 n = (u32)-d->decimal_point;
+            shift = (n < CY_ARRAY_LEN(shifts)) ? shifts[n] : 60;
+        }
 
-    os_block->block.start = (u8*)os_block + start_offset;
-    os_block->block.size = size;
-    os_block->commit_size = commit_size;
-    os_block->total_size = total_size;
+        cy__big_decimal_shift_left(d, shift);
+        exp2 -= (i32)shift;
+    }
 
-    cy__os_virtual_memory_protect((u8*)os_block + protect_offset, page_size);
+    // NOTE(cya): now to [1, 2), making room for subnormals
+    exp2 -= 1;
+    while (exp2 < -1022) {
+        u32 shift = (u32)CY_MIN(-1022 - exp2, 60);
+        cy__big_decimal_shift_right(d, shift);
+        exp2 += (i32)shift;
+    }
+    if (exp2 + 1023 >= 0x7FF) {
+        return inf_bits;
+    }
 
-    CyOSMemoryBlock *sentinel = &cy__os_memory_block_sentinel;
-    os_block->next = sentinel;
-    os_block->prev = sentinel->prev;
-    os_block->next->prev = os_block;
-    os_block->prev->next = os_block;
+    cy__big_decimal_shift_left(d, 53);
+    u64 mantissa = cy__big_decimal_round(d);
+    if (mantissa >= (1ULL << 53)) {
+        cy__big_decimal_shift_right(d, 1);
+        exp2 += 1;
+        mantissa = cy__big_decimal_round(d);
+        if (exp2 + 1023 >= 0x7FF) {
+            return inf_bits;
+        }
+    }
 
-    return &os_block->block;
+    u64 biased_exp = (u64)(exp2 + 1023) - ((mantissa >> 52) ? 0 : 1);
+    return (biased_exp << 52) | (mantissa & ((1ULL << 52) - 1));
 }
 
-void cy_virtual_memory_free(CyMemoryBlock *block)
+// NOTE(cya): m * 2^exp2 rounded to nearest (ties to even) as binary64 bits
+cy_internal u64 cy__f64_bits_from_binary(u64 m, i64 exp2, b32 sticky)
 {
-    CyOSMemoryBlock *os_block = (CyOSMemoryBlock*)block;
-    if (os_block == NULL) {
-        return;
+    const u64 inf_bits = 0x7FFULL << 52;
+    if (m == 0) {
+        return 0;
     }
 
-    os_block->prev->next = os_block->next;
-    os_block->next->prev = os_block->prev;
+    i32 len = cy__u64_bit_len(m);
+    m <<= 64 - len;
+    i64 biased_exp = exp2 + len - 1 + 1023;
+    if (biased_exp >= 0x7FF) {
+        return inf_bits;
+    }
 
-    cy__os_virtual_memory_free(os_block);
-}
+    i64 shift = 11;
+    if (biased_exp <= 0) {
+        shift += 1 - biased_exp;
+        biased_exp = 0;
+    }
+    if (shift > 64) {
+        return 0;
+    }
 
-cy_inline CyMemoryBlock *cy_virtual_memory_resize(
-    CyMemoryBlock *block, isize new_size
-) {
-    CY_VALIDATE_PTR(block);
+    u64 mantissa = (shift == 64) ? 0 : m >> shift;
+    u64 rem = (shift == 64) ? m : m & ((1ULL << shift) - 1);
+    u64 half = 1ULL << (shift - 1);
+    if (rem > half || (rem == half && (sticky || (mantissa & 1)))) {
+        mantissa += 1;
+    }
 
-    isize old_size = block->size;
-    if (new_size < old_size) {
-        void *new_start = (u8*)block->start + (old_size - new_size);
-        cy_mem_move(new_start, block->start, new_size);
+    // NOTE(cya): the implicit bit (or a rounding carry) bumps the exponent
+    u64 bits = (biased_exp > 0) ?
+        ((u64)(biased_exp - 1) << 52) + mantissa : mantissa;
+    return CY_MIN(bits, inf_bits);
+}
 
-        block->start = new_start;
-        block->size = new_size;
-        return block;
+// NOTE(cya): accumulates a run of digits into *n (wrapping around on overflow)
+cy_internal const char *cy__scan_digit_run(const char *s, u64 *n)
+{
+    const char *end = s;
+    while (cy_char_is_digit(*end)) {
+        end += 1;
     }
 
-    CyMemoryBlock *new_block = cy_virtual_memory_alloc(new_size);
-    CY_VALIDATE_PTR(new_block);
+    u64 val = *n;
+#if defined(CY__SWAR_DIGITS)
+    for (; end - s >= 8; s += 8) {
+        val = val * 100000000 + cy__parse_eight_digits(s);
+    }
+#endif
+    for (; s < end; s++) {
+        val = val * 10 + (u64)(*s - '0');
+    }
 
-    cy_mem_copy(new_block->start, block->start, block->size);
-    return new_block;
+    *n = val;
+    return end;
 }
 
-#if defined(CY_OS_WINDOWS)
-cy_inline isize cy_virtual_memory_page_size(isize *align_out)
+// NOTE(cya): length of the (lowercase) word at the start of s, or 0
+cy_internal isize cy__str_match_nocase(const char *s, const char *word)
 {
-    SYSTEM_INFO info;
-    GetSystemInfo(&info);
-    if (align_out != NULL) {
-        *align_out = (isize)info.dwAllocationGranularity;
+    isize len = 0;
+    for (; word[len] != '\0'; len++) {
+        if (cy_char_to_lower(s[len]) != word[len]) {
+            return 0;
+        }
     }
 
-    return (isize)info.dwPageSize;
+    return len;
 }
 
-cy_internal cy_inline CyOSMemoryBlock *cy__os_virtual_memory_reserve(isize size)
+// NOTE(cya): s points right after the "0x" prefix (returns NULL on no digits)
+cy_internal const char *cy__scan_hex_f64(const char *s, u64 *bits)
 {
-    return VirtualAlloc(NULL, (usize)size, MEM_RESERVE, PAGE_READWRITE);
-}
+    u64 m = 0;
+    i64 exp2 = 0;
+    b32 sticky = false, seen_dot = false, has_digits = false;
+    for (;; s++) {
+        if (*s == '.' && !seen_dot) {
+            seen_dot = true;
+            continue;
+        } else if (!cy_char_is_hex_digit(*s)) {
+            break;
+        }
 
-cy_internal cy_inline void cy__os_virtual_memory_commit(void *mem, isize size)
-{
-    VirtualAlloc(mem, (usize)size, MEM_COMMIT, PAGE_READWRITE);
-}
+        u64 digit = (u64)cy_hex_digit_to_i64(*s);
+        has_digits = true;
+        if ((m >> 60) == 0) {
+            m = (m << 4) | digit;
+            exp2 -= seen_dot ? 4 : 0;
+        } else {
+            sticky |= (digit != 0);
+            exp2 += seen_dot ? 0 : 4;
+        }
+    }
+    if (!has_digits) {
+        return NULL;
+    }
 
-cy_internal cy_inline void cy__os_virtual_memory_free(CyOSMemoryBlock *block)
-{
-    VirtualFree(block, 0, MEM_RELEASE);
-}
+    if (*s == 'p' || *s == 'P') {
+        const char *e = s + 1;
+        b32 negative = (*e == '-');
+        e += (*e == '-' || *e == '+') ? 1 : 0;
+        if (cy_char_is_digit(*e)) {
+            i64 exp = 0;
+            for (; cy_char_is_digit(*e); e++) {
+                exp = (exp < 0x100000) ? exp * 10 + (*e - '0') : exp;
+            }
 
-cy_internal cy_inline void cy__os_virtual_memory_protect(void *mem, isize size)
-{
-    cy__os_virtual_memory_commit(mem, size);
+            exp2 += negative ? -exp : exp;
+            s = e;
+        }
+    }
 
-    DWORD old_protect = 0;
-    BOOL ok = VirtualProtect(mem, (usize)size, PAGE_NOACCESS, &old_protect);
-    CY_ASSERT(ok);
+    *bits = cy__f64_bits_from_binary(m, exp2, sticky);
+    return s;
 }
-#else
 
-#endif
+// NOTE(cya): returns the length of the number (0 if there's none)
+cy_internal isize cy__scan_f64(const char *str, f64 *value)
+{
+    const char *s = str;
+    b32 negative = (*s == '-');
+    s += (*s == '-' || *s == '+') ? 1 : 0;
+
+    u64 bits = 0;
+    isize special_len = 0;
+    if ((special_len = cy__str_match_nocase(s, "inf")) != 0) {
+        s += special_len;
+        s += cy__str_match_nocase(s, "inity");
+        bits = 0x7FFULL << 52;
+    } else if ((special_len = cy__str_match_nocase(s, "nan")) != 0) {
+        s += special_len;
+        bits = 0x7FF8ULL << 48;
+        if (*s == '(') {
+            const char *p = s + 1;
+            while (
+                cy_char_is_digit(*p) || cy_char_is_lower(*p) ||
+                CY_IS_IN_RANGE_INCL(*p, 'A', 'Z') || *p == '_'
+            ) {
+                p += 1;
+            }
+            if (*p == ')') {
+                s = p + 1;
+            }
+        }
+    } else if (cy_str_has_prefix(s, "0x") || cy_str_has_prefix(s, "0X")) {
+        const char *end = cy__scan_hex_f64(s + 2, &bits);
+        s = (end != NULL) ? end : s + 1;
+    } else {
+        const char *mantissa_start = s;
+        u64 w = 0;
+        s = cy__scan_digit_run(s, &w);
+        const char *int_end = s;
+        i64 digit_count = int_end - mantissa_start;
+        i64 frac_len = 0;
+        if (*s == '.') {
+            s = cy__scan_digit_run(s + 1, &w);
+            frac_len = s - (int_end + 1);
+            digit_count += frac_len;
+        }
+        if (digit_count == 0) {
+            *value = 0.0;
+            return 0;
+        }
+
+        const char *mantissa_end = s;
+        i64 exp_explicit = 0;
+        if (*s == 'e' || *s == 'E') {
+            const char *e = s + 1;
+            b32 negative_exp = (*e == '-');
+            e += (*e == '-' || *e == '+') ? 1 : 0;
+            if (cy_char_is_digit(*e)) {
+                for (; cy_char_is_digit(*e); e++) {
+                    exp_explicit = (exp_explicit < 0x100000) ?
+                        exp_explicit * 10 + (*e - '0') : exp_explicit;
+                }
+
+                exp_explicit = negative_exp ? -exp_explicit : exp_explicit;
+                s = e;
+            }
+        }
+
+        i64 exp10 = exp_explicit - frac_len;
+        b32 truncated = false;
+        if (digit_count > 19) {
+            const char *p = mantissa_start;
+            for (; p < mantissa_end && (*p == '0' || *p == '.'); p++) {
+                digit_count -= (*p == '0') ? 1 : 0;
+            }
+
+            // NOTE(cya): keep only the first 19 significant digits
+            if (digit_count > 19) {
+                truncated = true;
+                w = 0;
+                for (i32 taken = 0; taken < 19; p++) {
+                    if (*p != '.') {
+                        w = w * 10 + (u64)(*p - '0');
+                        taken += 1;
+                    }
+                }
+
+                exp10 = exp_explicit + ((p <= int_end) ?
+                    int_end - p : -(p - (int_end + 1)));
+            }
+        }
+
+        if (
+            !truncated && exp10 >= -22 && exp10 <= 22 && w <= (1ULL << 53)
+        ) {
+            f64 n = (f64)w;
+            n = (exp10 < 0) ?
+                n / cy__pow_of_10_exact_table[-exp10] :
+                n * cy__pow_of_10_exact_table[exp10];
+            bits = cy__f64_to_bits(n);
+        } else if (w == 0 || exp10 < CY__EISEL_LEMIRE_MIN_EXP10) {
+            bits = 0;
+        } else if (exp10 > CY__EISEL_LEMIRE_MAX_EXP10) {
+            bits = 0x7FFULL << 52;
+        } else {
+            b32 ok = cy__eisel_lemire_f64(w, (i32)exp10, &bits);
+            if (ok && truncated) {
+                // NOTE(cya): the dropped digits can't change the result
+                u64 bits_up;
+                ok = cy__eisel_lemire_f64(w + 1, (i32)exp10, &bits_up) &&
+                    bits_up == bits;
+            }
+            if (!ok) {
+                CyPrivBigDecimal d;
+                cy__big_decimal_init(&d, mantissa_start, exp_explicit);
+                bits = cy__big_decimal_to_f64_bits(&d);
+            }
+        }
+    }
+
+    bits |= (u64)negative << 63;
+    cy_mem_copy(value, &bits, cy_sizeof(*value));
+    return s - str;
+}
+
+// TODO(cya):
+// * correct rounding errors on binary exponentiation (probably requires MPA)
+cy_internal CY__PRINT_PROC(cy__print_f64)
+{
+    f64 n = info.value.f;
+
+    const isize limit = cap - 1;
+    isize written = 0;
+    isize written_total = 0;
+
+    b32 upper = info.flags & CY__FMT_STYLE_UPPER;
+    char *cur = dst;
+    if (CY_IS_NAN(n)) {
+        info.value.s = cy_string_view_create_c(upper ? "NAN" : "nan");
+        return cy__print_str(cur, cap, info, NULL);
+    }
+
+    if (cy__f64_to_bits(n) >> 63) {
+        n = -n;
+        if (written < limit) {
+            *cur++ = '-';
+            written += 1;
+        }
+
+        written_total += 1;
+    } else if (info.flags & CY__FMT_PLUS) {
+        if (written < limit) {
+            *cur++ = '+';
+            written += 1;
+        }
+
+        written_total += 1;
+    } else if (info.flags & CY__FMT_SPACE) {
+        if (written < limit) {
+            *cur++ = ' ';
+            written += 1;
+        }
+
+        written_total += 1;
+    }
+
+    if (CY_IS_INF(n)) {
+        info.value.s = cy_string_view_create_c(upper ? "INF" : "inf");
+        isize len = cy__print_str(cur, cap, info, NULL);
+        return written_total + len;
+    }
+
+    b32 style_shortest = info.flags & CY__FMT_STYLE_SHORTEST;
+    b32 style_general = (info.flags & CY__FMT_STYLE_AUTO) && info.base == 10;
+    if (style_shortest || style_general) {
+        i32 precision = 17;
+        if (!style_shortest) {
+            precision = (info.precision == -1) ? 6 : CY_MAX(info.precision, 1);
+        }
+
+        CyPrivDecimalFloat dec = {0};
+        if (n != 0.0) {
+            dec = cy__f64_shortest(n);
+        }
+
+        // NOTE(cya): the shortest representation is also the correctly
+        // rounded one for %g as long as it fits in up to 15 digits (except
+        // for subnormals, which don't have enough precision for that)
+        isize digit_count = cy__u64_digit_count(dec.mantissa, 10);
+        b32 exact = (precision <= 15 && digit_count <= precision) &&
+            (n == 0.0 || n >= 0x1p-1022);
+        if (style_shortest || exact) {
+            char buf[64];
+            b32 alt = !style_shortest && (info.flags & CY__FMT_HASH);
+            isize len = cy__f64_format_general(buf, dec, precision, alt, upper);
+
+            if ((info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS)) {
+                zeros_out->offset = written;
+                zeros_out->len = CY_MAX(info.width - written_total - len, 0);
+            }
+
+            isize remaining = CY_MAX(limit - written, 0);
+            cy_mem_copy(cur, buf, CY_MIN(len, remaining));
+
+            return written_total + len;
+        }
+    }
+
+    b32 style_hex = info.base == 16;
+    b32 style_exp = info.flags & CY__FMT_STYLE_EXP;
+    b32 style_auto = info.flags & CY__FMT_STYLE_AUTO;
+    b32 style_alt = info.flags & CY__FMT_HASH;
+
+    if (style_hex) {
+        info.value.s = cy_string_view_create_c(upper ? "0X" : "0x");
+        isize len_total = cy__print_str(cur, cap, info, NULL);
+        isize len = CY_MIN(len_total, cap);
+
+        cur += len, written += len;
+        written_total += len_total;
+    }
+
+    char *num_start = cur;
+
+    const i32 MAX_PRECISION = 16;
+    i32 precision = info.precision;
+    b32 custom_precision = (precision != -1);
+    if (custom_precision) {
+        precision = CY_MIN(precision, MAX_PRECISION);
+    } else if (!style_hex) {
+        precision = 6;
+    }
+
+    i16 exponent = 0;
+    f64 normalized = n;
+    if (style_exp || style_auto) {
+        if (normalized >= 1e1) {
+            CY__CALC_BIN_EXPS(INC, 10, 1e, normalized, exponent);
+        } else if (normalized > 0.0 && normalized <= 1e0) {
+            CY__CALC_BIN_EXPS(DEC, 10, 1e, normalized, exponent);
+            if (normalized < 1e0) {
+                normalized *= 1e1;
+                exponent -= 1;
+            }
+        }
+    } else if (style_hex) {
+        if (normalized >= 0x1p1) {
+            CY__CALC_BIN_EXPS(INC, 2, 0x1p, normalized, exponent);
+        } else if (normalized > 0.0 && normalized <= 0x1p0) {
+            CY__CALC_BIN_EXPS(DEC, 2, 0x1p, normalized, exponent);
+            if (normalized < 0x1p0) {
+                normalized *= 0x1p1;
+                exponent -= 1;
+            }
+        }
+    }
+
+    b32 swap = style_hex || style_exp ||
+        (style_auto && (exponent < -4 || exponent >= precision));
+    if (swap) {
+        n = normalized;
+    }
+
+    u64 integral = (u64)n;
+    isize integral_len, len;
+    isize remaining = limit - written;
+    isize len_total = integral_len = cy__print_u64(
+        cur, remaining, (CyPrivFmtInfo){
+            .base = info.base,
+            .precision = -1,
+            .value.u = integral,
+        }, NULL
+    );
+
+    len = integral_len = CY_MIN(len_total, remaining);
+    cur += len, written += len;
+    written_total += len_total;
+
+    // NOTE(cya): because 'significant digits' includes integral part
+    if (style_auto) {
+        precision -= (i32)integral_len;
+    }
+
+    f64 remainder = (n - (f64)integral);
+    if (style_hex && precision == -1) {
+        precision = 0;
+        while (remainder - (f64)(u64)remainder != 0.0) {
+            remainder *= (f64)info.base;
+            precision += 1;
+        }
+    } else {
+        const f64 *table = info.base == 16 ?
+            cy__pow_of_16_table : cy__pow_of_10_table;
+        remainder *= table[precision];
+    }
+
+    u64 decimal = (u64)remainder;
+    remainder -= (f64)decimal;
+    if (remainder > 0.5) {
+        decimal += 1;
+        if (decimal >= (u64)1e16) {
+            decimal = 0;
+            integral += 1;
+            if (exponent != 0 && integral >= 10) {
+                exponent += 1;
+                integral = 1;
+            }
+        }
+    }
+
+    b32 print_decimal = precision > 0 &&
+        !(style_auto && !style_alt && decimal == 0);
+    b32 print_dot = print_decimal || style_alt;
+    if (print_dot) {
+        if (written < limit) {
+            *cur++ = '.';
+            written += 1;
+        }
+
+        written_total += 1;
+    }
+
+    isize extra_digits = 0;
+    if (print_decimal) {
+        char *c = cur;
+        if (!style_auto || style_alt) {
+            // NOTE(cya): digits past the max precision are always zeros
+            extra_digits = CY_MAX(info.precision - precision, 0);
+        } else {
+            while (decimal % (u64)info.base == 0) {
+                decimal /= (u64)info.base;
+                precision -= 1;
+            }
+        }
+
+        const char *table = upper ?
+            cy__num_to_char_table_upper : cy__num_to_char_table_lower;
+        while (precision-- > 0) {
+            if (written < limit) {
+                *c++ = table[decimal % (u64)info.base];
+                written += 1;
+            }
+
+            decimal /= (u64)info.base;
+            written_total += 1;
+        }
+
+        len = c - cur;
+        cy_str_reverse_n(cur, len);
+        cur += len;
+
+        zeros_out->offset = cur - dst;
+        zeros_out->len = extra_digits;
+    }
+
+    b32 print_exponent = swap &&
+        (style_exp || style_hex || (exponent != 0));
+    if (print_exponent) {
+        char c = style_hex ? 'p' : 'e';
+        c = cy__fmt_char_to_case(c, upper);
+        if (written < limit) {
+            *cur++ = c;
+            written += 1;
+        }
+
+        written_total += 1;
+        c = (exponent < 0) ? '-' : '+';
+        if (written < limit) {
+            *cur++ = c;
+            written += 1;
+        }
+
+        written_total += 1;
+        exponent = CY_ABS(exponent);
+        if (!style_hex && exponent < 10) {
+            if (written < limit) {
+                *cur++ = '0';
+                written += 1;
+            }
+
+            written_total += 1;
+        }
+
+        remaining = limit - written;
+        len_total = cy__print_i64(cur, remaining, (CyPrivFmtInfo){
+            .base = 10,
+            .precision = -1,
+            .value.i = exponent,
+        }, NULL);
+
+        len = CY_MIN(len_total, remaining);
+        cur += len, written += len;
+        written_total += len_total;
+    }
+
+    len = cur - dst;
+    b32 fill_with_zeros = !custom_precision && (len < info.width) &&
+        (info.flags & CY__FMT_ZERO) && !(info.flags & CY__FMT_MINUS);
+    if (fill_with_zeros) {
+        zeros_out->offset = num_start - dst;
+        zeros_out->len = info.width - len;
+    }
+
+    return written_total;
+}
+
+#ifndef CY_STD_C_PRINTF
+cy_global const char *cy__b32_to_str_table[4] = {
+    "false", "true",
+    "FALSE", "TRUE",
+};
+#endif
+
+// NOTE(cya): what a conversion spec fetches from the va_list when it's run
+enum {
+    CY__FMT_ARG_NONE,
+    CY__FMT_ARG_CHAR,
+    CY__FMT_ARG_STR,
+    CY__FMT_ARG_PTR,
+    CY__FMT_ARG_COUNT,
+    CY__FMT_ARG_INT,
+    CY__FMT_ARG_UINT,
+    CY__FMT_ARG_FLOAT,
+    CY__FMT_ARG_BOOL,
+    CY__FMT_ARG_VIEW,
+    CY__FMT_ARG_CUSTOM,
+    CY__FMT_ARG_INVALID,
+};
+
+#ifndef CY_FORMAT_MAX_CUSTOM_SPECS
+    #define CY_FORMAT_MAX_CUSTOM_SPECS 32
+#endif
+
+#if CY_FORMAT_MAX_CUSTOM_SPECS > 256
+    #error "custom format spec indices have to fit in a u8"
+#endif
+
+typedef struct {
+    CyStringView name;
+    CyFormatProc *proc;
+} CyPrivFmtCustomSpec;
+
+cy_global CyPrivFmtCustomSpec cy__fmt_custom_specs[CY_FORMAT_MAX_CUSTOM_SPECS];
+cy_global isize cy__fmt_custom_spec_count;
+
+// NOTE(cya): index of the custom spec with the given name (or -1)
+cy_internal isize cy__fmt_find_custom_spec(CyStringView name)
+{
+    for (isize i = 0; i < cy__fmt_custom_spec_count; i++) {
+        if (cy_string_view_are_equal(cy__fmt_custom_specs[i].name, name)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+b32 cy_format_register(const char *name, CyFormatProc *proc)
+{
+    CyStringView view = cy_string_view_create_c(name);
+    if (view.len == 0 || proc == NULL || cy_string_view_contains(view, "}")) {
+        return false;
+    }
+
+    isize idx = cy__fmt_find_custom_spec(view);
+    if (idx < 0) {
+        if (cy__fmt_custom_spec_count >= CY_FORMAT_MAX_CUSTOM_SPECS) {
+            return false;
+        }
+
+        idx = cy__fmt_custom_spec_count++;
+    }
+
+    cy__fmt_custom_specs[idx] = (CyPrivFmtCustomSpec){
+        .name = view,
+        .proc = proc,
+    };
+    return true;
+}
+
+/*
+ * Everything that can be known about a conversion spec without looking at
+ * its arguments, so it can be parsed once and replayed (see CyFormat)
+ */
+typedef struct {
+    i32 flags;
+    i32 base;
+    i32 width;
+    i32 precision;
+    u8 arg;
+    u8 bit_size;
+    b8 width_arg;
+    b8 precision_arg;
+    char c; // NOTE(cya): output char for CY__FMT_ARG_NONE (e.g.: %%)
+    u8 custom; // NOTE(cya): index into cy__fmt_custom_specs
+} CyPrivFmtSpec;
+
+struct CyPrivFmtOp {
+    const char *lit;
+    isize lit_len;
+    b32 has_spec;
+    CyPrivFmtSpec spec;
+};
+
+// NOTE(cya): parses the spec right after a '%' and returns the char after it
+cy_internal const char *cy__fmt_parse_spec(const char *f, CyPrivFmtSpec *spec)
+{
+    *spec = (CyPrivFmtSpec){.precision = -1};
+
+    b32 done = false;
+    do {
+        switch (*f++) {
+        case '-': {
+            spec->flags |= CY__FMT_MINUS;
+        } break;
+        case '+': {
+            spec->flags |= CY__FMT_PLUS;
+        } break;
+        case ' ': {
+            spec->flags |= CY__FMT_SPACE;
+        } break;
+        case '#': {
+            spec->flags |= CY__FMT_HASH;
+        } break;
+        case '0': {
+            spec->flags |= CY__FMT_ZERO;
+        } break;
+        default: {
+            done = true;
+            f -= 1;
+        } break;
+        }
+    } while (!done);
+
+    if (cy_char_is_digit(*f)) {
+        u64 width;
+        isize len = cy__scan_u64(f, 10, &width);
+        spec->width = (i32)width;
+        f += len;
+    } else if (*f == '*') {
+        spec->width_arg = true;
+        f += 1;
+    }
+
+    if (*f == '.') {
+        isize len = 1;
+        if (*++f == '*') {
+            spec->precision_arg = true;
+        } else {
+            i64 precision;
+            len = cy__scan_i64(f, 10, &precision);
+            if (precision >= 0) {
+                spec->precision = (i32)precision;
+            }
+        }
+
+        f += len;
+    }
+
+    switch (*f++) {
+    case 'h': {
+        if (*f == 'h') {
+            spec->flags |= CY__FMT_LEN_CHAR;
+            f += 1;
+        } else {
+            spec->flags |= CY__FMT_LEN_SHORT;
+        }
+    } break;
+    case 'l': {
+        if (*f == 'l') {
+            spec->flags |= CY__FMT_LEN_LONG_LONG;
+            f += 1;
+        } else {
+            spec->flags |= CY__FMT_LEN_LONG;
+        }
+    } break;
+    case 'j': {
+        spec->flags |= CY__FMT_LEN_INTMAX;
+    } break;
+    case 'z': {
+        spec->flags |= CY__FMT_LEN_SIZE;
+    } break;
+    case 't': {
+        spec->flags |= CY__FMT_LEN_PTRDIFF;
+    } break;
+    case 'L': {
+        spec->flags |= CY__FMT_LEN_LONG_DOUBLE;
+    } break;
+    default: {
+        f -= 1;
+    } break;
+    }
+
+    switch (*f) {
+    case 'd':
+    case 'i': {
+        spec->flags |= CY__FMT_INT;
+        spec->base = 10;
+        spec->arg = CY__FMT_ARG_INT;
+    } break;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X': {
+        spec->flags |= CY__FMT_UNSIGNED;
+        spec->arg = CY__FMT_ARG_UINT;
+        switch (*f) {
+        case 'o': {
+            spec->base = 8;
+        } break;
+        case 'u': {
+            spec->base = 10;
+        } break;
+        case 'x':
+        case 'X': {
+            spec->base = 16;
+            if (cy_char_is_upper(*f)) {
+                spec->flags |= CY__FMT_STYLE_UPPER;
+            }
+        } break;
+        }
+    } break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A': {
+        spec->flags |= CY__FMT_FLOAT;
+        spec->base = 10;
+        spec->arg = CY__FMT_ARG_FLOAT;
+        switch (cy_char_to_lower(*f)) {
+        case 'e': {
+            spec->flags |= CY__FMT_STYLE_EXP;
+        } break;
+        case 'g': {
+            spec->flags |= CY__FMT_STYLE_AUTO;
+        } break;
+        case 'a': {
+            spec->base = 16;
+        } break;
+        }
+
+        if (cy_char_is_upper(*f)) {
+            spec->flags |= CY__FMT_STYLE_UPPER;
+        }
+    } break;
+    case 'c': {
+        // TODO(cya): convert from wcs to mbs (is it even worth it?)
+        if (!(spec->flags & CY__FMT_LEN_LONG)) {
+            spec->arg = CY__FMT_ARG_CHAR;
+        }
+    } break;
+    case 's': {
+        // TODO(cya): same as the todo above
+        if (!(spec->flags & CY__FMT_LEN_LONG)) {
+            spec->arg = CY__FMT_ARG_STR;
+        }
+    } break;
+    case 'p': {
+        spec->arg = CY__FMT_ARG_PTR;
+    } break;
+    case 'n': {
+        spec->arg = CY__FMT_ARG_COUNT;
+    } break;
+    case '%': {
+        spec->c = '%';
+    } break;
+#ifndef CY_STD_C_PRINTF // NOTE(cya): extended format specifiers
+    case 'b':
+    case 'B': { // NOTE(cya): binary ints
+        spec->flags |= CY__FMT_UNSIGNED;
+        spec->base = 2;
+        spec->arg = CY__FMT_ARG_UINT;
+        if (cy_char_is_upper(*f)) {
+            spec->flags |= CY__FMT_STYLE_UPPER;
+        }
+    } break;
+    case 'q':
+    case 'Q': {
+        spec->arg = CY__FMT_ARG_BOOL;
+        if (cy_char_is_upper(*f)) {
+            spec->flags |= CY__FMT_STYLE_UPPER;
+        }
+    } break;
+    case 'v': {
+        spec->arg = CY__FMT_ARG_VIEW;
+    } break;
+    case '{': { // NOTE(cya): registered custom specs (%{name})
+        const char *name = f + 1;
+        const char *end = name;
+        while (*end != '\0' && *end != '}') {
+            end += 1;
+        }
+        if (*end == '\0') {
+            spec->arg = CY__FMT_ARG_INVALID;
+            return f;
+        }
+
+        isize idx = cy__fmt_find_custom_spec(
+            cy_string_view_create_len(name, end - name)
+        );
+        spec->arg = (idx < 0) ? CY__FMT_ARG_INVALID : CY__FMT_ARG_CUSTOM;
+        spec->custom = (u8)CY_MAX(idx, 0);
+        return end + 1;
+    } break;
+    case 'r':
+    case 'R': { // NOTE(cya): shortest round-trip floats
+        spec->flags |= CY__FMT_FLOAT | CY__FMT_STYLE_SHORTEST;
+        spec->base = 10;
+        spec->arg = CY__FMT_ARG_FLOAT;
+        if (cy_char_is_upper(*f)) {
+            spec->flags |= CY__FMT_STYLE_UPPER;
+        }
+    } break;
+#endif
+    default: {
+        // NOTE(cya): the offending char is left to be printed as a literal
+        spec->arg = CY__FMT_ARG_INVALID;
+        return f;
+    } break;
+    }
+
+    f += 1;
+
+#ifndef CY_STD_C_PRINTF
+    // NOTE(cya): parsing sized format specs (%u64, %d32, %i16, etc.)
+    if ((spec->flags & CY__FMT_INTS) && cy_char_is_digit(*f)) {
+        switch (*f) {
+        case '8': {
+            spec->bit_size = 8;
+        } break;
+        case '1': {
+            if (*(f + 1) == '6') {
+                spec->bit_size = 16;
+            }
+        } break;
+        case '3': {
+            if (*(f + 1) == '2') {
+                spec->bit_size = 32;
+            }
+        } break;
+        case '6': {
+            if (*(f + 1) == '4') {
+                spec->bit_size = 64;
+            }
+        } break;
+        }
+
+        if (spec->bit_size > 0) {
+            f += (spec->bit_size == 8) ? 1 : 2;
+        }
+    }
+#endif
+
+    return f;
+}
+
+cy_internal u64 cy__fmt_arg_u64(const CyPrivFmtSpec *spec, va_list *va)
+{
+    switch (spec->bit_size) {
+    case 8: {
+        return (u64)((u8)va_arg(*va, int));
+    } break;
+    case 16: {
+        return (u64)((u16)va_arg(*va, int));
+    } break;
+    case 32: {
+        return (u64)va_arg(*va, u32);
+    } break;
+    case 64: {
+        return va_arg(*va, u64);
+    } break;
+    }
+
+    switch (spec->flags & CY__FMT_LEN_MODS) {
+    case CY__FMT_LEN_CHAR: {
+        return (u64)((unsigned char)va_arg(*va, int));
+    } break;
+    case CY__FMT_LEN_SHORT: {
+        return (u64)((unsigned short)va_arg(*va, int));
+    } break;
+    case CY__FMT_LEN_LONG: {
+        return (u64)va_arg(*va, unsigned long);
+    } break;
+    case CY__FMT_LEN_LONG_LONG: {
+        return (u64)va_arg(*va, unsigned long long);
+    } break;
+    case CY__FMT_LEN_INTMAX: {
+        return (u64)va_arg(*va, uintmax_t);
+    } break;
+    case CY__FMT_LEN_SIZE:
+    case CY__FMT_LEN_PTRDIFF: {
+        return (u64)va_arg(*va, usize);
+    } break;
+    }
+
+    return (u64)va_arg(*va, unsigned);
+}
+
+cy_internal i64 cy__fmt_arg_i64(const CyPrivFmtSpec *spec, va_list *va)
+{
+    switch (spec->bit_size) {
+    case 8: {
+        return (i64)((i8)va_arg(*va, int));
+    } break;
+    case 16: {
+        return (i64)((i16)va_arg(*va, int));
+    } break;
+    case 32: {
+        return (i64)va_arg(*va, i32);
+    } break;
+    case 64: {
+        return va_arg(*va, i64);
+    } break;
+    }
+
+    switch (spec->flags & CY__FMT_LEN_MODS) {
+    case CY__FMT_LEN_CHAR: {
+        return (i64)((signed char)va_arg(*va, int));
+    } break;
+    case CY__FMT_LEN_SHORT: {
+        return (i64)((short)va_arg(*va, int));
+    } break;
+    case CY__FMT_LEN_LONG: {
+        return (i64)va_arg(*va, long);
+    } break;
+    case CY__FMT_LEN_LONG_LONG: {
+        return (i64)va_arg(*va, long long);
+    } break;
+    case CY__FMT_LEN_INTMAX: {
+        return (i64)va_arg(*va, intmax_t);
+    } break;
+    case CY__FMT_LEN_SIZE:
+    case CY__FMT_LEN_PTRDIFF: {
+        return (i64)va_arg(*va, isize);
+    } break;
+    }
+
+    return (i64)va_arg(*va, int);
+}
+
+cy_internal void cy__fmt_store_count(
+    const CyPrivFmtSpec *spec, void *out, isize val
+) {
+    if (out == NULL) {
+        return;
+    }
+
+    switch (spec->flags & CY__FMT_LEN_MODS) {
+    case CY__FMT_LEN_CHAR: {
+        *((signed char*)out) = (signed char)val;
+    } break;
+    case CY__FMT_LEN_SHORT: {
+        *((short*)out) = (short)val;
+    } break;
+    case CY__FMT_LEN_LONG: {
+        *((long*)out) = (long)val;
+    } break;
+    case CY__FMT_LEN_LONG_LONG: {
+        *((long long*)out) = (long long)val;
+    } break;
+    case CY__FMT_LEN_INTMAX: {
+        *((intmax_t*)out) = (intmax_t)val;
+    } break;
+    case CY__FMT_LEN_SIZE:
+    case CY__FMT_LEN_PTRDIFF: {
+        *((isize*)out) = val;
+    } break;
+    default: {
+        *((int*)out) = (int)val;
+    } break;
+    }
+}
+
+// NOTE(cya): written_total is how much _would_ be written in case the buf
+// wasn't large enough, while written is how much _was_ written which can
+// truncate if we reach the end of the buffer, that way we can report the
+// amount of bytes necessary for this whole conversion to work and the user
+// can allocate a suitable buffer if needed and then recall this procedure
+// (all the cy__print_* subprocs use this pattern to propagate this logic)
+//
+// When a flush proc is set, the buffer is just a chunk of the output: once it
+// fills up the proc gets called to make room in it (by writing it out or by
+// growing it), so the output gets streamed in a single pass. If the proc
+// fails, the writer falls back to truncating like a plain buffer
+typedef struct CyPrivFmtWriter CyPrivFmtWriter;
+
+#define CY__FMT_FLUSH_PROC(name) b32 name(CyPrivFmtWriter *w)
+typedef CY__FMT_FLUSH_PROC(CyPrivFmtFlushProc);
+
+struct CyPrivFmtWriter {
+    char *buf;
+    char *end;
+    isize limit;
+    isize written;
+    isize written_total;
+
+    CyPrivFmtFlushProc *flush;
+    void *sink;
+    b32 flush_failed;
+};
+
+cy_internal cy_inline void cy__fmt_writer_init(
+    CyPrivFmtWriter *w, char *buf, isize size
+) {
+    w->buf = buf;
+    w->end = buf;
+    w->limit = size - 1;
+    w->written = 0;
+    w->written_total = 0;
+    w->flush = NULL;
+    w->sink = NULL;
+    w->flush_failed = false;
+}
+
+cy_internal void cy__fmt_write(CyPrivFmtWriter *w, const char *src, isize len)
+{
+    w->written_total += len;
+    while (len > 0) {
+        if (w->written >= w->limit) {
+            if (w->flush == NULL) {
+                return;
+            } else if (!w->flush(w)) {
+                w->flush = NULL;
+                w->flush_failed = true;
+                return;
+            }
+        }
+
+        isize copy_len = CY_MIN(w->limit - w->written, len);
+        cy_mem_copy(w->end, src, copy_len);
+        w->end += copy_len, w->written += copy_len;
+        src += copy_len, len -= copy_len;
+    }
+}
+
+cy_internal void cy__fmt_write_fill(CyPrivFmtWriter *w, u8 c, isize len)
+{
+    if (len <= 0) {
+        return;
+    }
+
+    char fill[64];
+    cy_mem_set(fill, c, CY_MIN(len, cy_sizeof(fill)));
+    for (; len > 0; len -= cy_sizeof(fill)) {
+        cy__fmt_write(w, fill, CY_MIN(len, cy_sizeof(fill)));
+    }
+}
+
+cy_internal isize cy__fmt_writer_finish(CyPrivFmtWriter *w)
+{
+    if (w->end != NULL) {
+        *w->end = '\0';
+    }
+
+    return w->written_total;
+}
+
+cy_internal void cy__fmt_write_literal(
+    CyPrivFmtWriter *w, const char *fmt, const char *lit, isize len
+) {
+#if defined(CY_OS_WINDOWS)
+    const char *seg = lit;
+    for (const char *f = lit; f < lit + len; f++) {
+        // NOTE(cya): LF -> CRLF conversion
+        if (*f == '\n' && (f - fmt < 1 || *(f - 1) != '\r')) {
+            cy__fmt_write(w, seg, f - seg);
+            cy__fmt_write(w, "\r", 1);
+            seg = f;
+        }
+    }
+
+    cy__fmt_write(w, seg, lit + len - seg);
+#else
+    (void)fmt;
+    cy__fmt_write(w, lit, len);
+#endif
+}
+
+// NOTE(cya): a spec's arguments, fetched from the va_list but not converted
+typedef struct {
+    i32 width;
+    i32 precision;
+    union {
+        u64 u;
+        i64 i;
+        f64 f;
+        CyStringView s;
+        const void *p;
+    } value;
+} CyPrivFmtArg;
+
+cy_internal void cy__fmt_fetch_arg(
+    const CyPrivFmtSpec *spec, va_list *va, CyPrivFmtArg *arg
+) {
+    arg->width = spec->width_arg ? va_arg(*va, int) : spec->width;
+    arg->precision = spec->precision_arg ? va_arg(*va, int) : spec->precision;
+
+    switch (spec->arg) {
+    case CY__FMT_ARG_NONE: {
+        arg->value.u = 0;
+    } break;
+    case CY__FMT_ARG_CHAR: {
+        arg->value.u = (u8)va_arg(*va, int);
+    } break;
+    case CY__FMT_ARG_STR: {
+        const char *str = va_arg(*va, char*);
+        arg->value.s = cy_string_view_create_c(str);
+    } break;
+    case CY__FMT_ARG_PTR:
+    case CY__FMT_ARG_COUNT: {
+        arg->value.p = va_arg(*va, void*);
+    } break;
+    case CY__FMT_ARG_INT: {
+        arg->value.i = cy__fmt_arg_i64(spec, va);
+    } break;
+    case CY__FMT_ARG_UINT: {
+        arg->value.u = cy__fmt_arg_u64(spec, va);
+    } break;
+    case CY__FMT_ARG_FLOAT: {
+        arg->value.f = spec->flags & CY__FMT_LEN_LONG_DOUBLE ?
+            (f64)va_arg(*va, long double) : va_arg(*va, f64);
+    } break;
+#ifndef CY_STD_C_PRINTF
+    case CY__FMT_ARG_BOOL: {
+        arg->value.u = !!(b32)va_arg(*va, int);
+    } break;
+    case CY__FMT_ARG_VIEW: {
+        arg->value.s = va_arg(*va, CyStringView);
+    } break;
+    case CY__FMT_ARG_CUSTOM: {
+        arg->value.p = va_arg(*va, const void*);
+    } break;
+#endif
+    default: {
+        arg->value.u = (u64)va_arg(*va, uintptr);
+    } break;
+    }
+}
+
+// NOTE(cya): runs the conversion of an already fetched argument
+cy_internal void cy__fmt_write_arg(
+    CyPrivFmtWriter *w, const CyPrivFmtSpec *spec, const CyPrivFmtArg *arg
+) {
+    CyPrivFmtInfo info = {
+        .base = spec->base,
+        .flags = spec->flags,
+        .width = arg->width,
+        .precision = arg->precision,
+    };
+
+    // NOTE(cya): everything but the zero runs of a conversion fits in here
+    char conv_buf[128];
+    CyPrivFmtZeros zeros = {0};
+    CyPrivPrintProc *print_proc = NULL;
+    isize conv_len = 0;
+    switch (spec->arg) {
+    case CY__FMT_ARG_NONE: {
+        if (spec->c != '\0') {
+            *conv_buf = spec->c;
+            conv_len = 1;
+        }
+    } break;
+    case CY__FMT_ARG_CHAR: {
+        *(u8*)conv_buf = (u8)arg->value.u;
+        conv_len = 1;
+    } break;
+    case CY__FMT_ARG_STR: {
+        info.value.s = arg->value.s;
+        print_proc = cy__print_str;
+    } break;
+    case CY__FMT_ARG_PTR: {
+        print_proc = cy__print_u64;
+        info = (CyPrivFmtInfo){
+            .base = 16,
+            .flags = (CY__FMT_ZERO | CY__FMT_STYLE_UPPER | CY__FMT_HASH),
+            .width = 16,
+            .value.u = (u64)(uintptr)arg->value.p,
+        };
+    } break;
+    case CY__FMT_ARG_COUNT: {
+        cy__fmt_store_count(spec, (void*)arg->value.p, w->written_total);
+        return;
+    } break;
+    case CY__FMT_ARG_INT: {
+        info.value.i = arg->value.i;
+        print_proc = cy__print_i64;
+    } break;
+    case CY__FMT_ARG_UINT: {
+        info.value.u = arg->value.u;
+        print_proc = cy__print_u64;
+    } break;
+    case CY__FMT_ARG_FLOAT: {
+        info.value.f = arg->value.f;
+        print_proc = cy__print_f64;
+    } break;
+#ifndef CY_STD_C_PRINTF
+    case CY__FMT_ARG_BOOL: {
+        isize ofs = (spec->flags & CY__FMT_STYLE_UPPER) ? 2 : 0;
+
+        const char *str = cy__b32_to_str_table[ofs + (isize)arg->value.u];
+        info.value.s = cy_string_view_create_c(str);
+        print_proc = cy__print_str;
+    } break;
+    case CY__FMT_ARG_VIEW: {
+        info.value.s = arg->value.s;
+        print_proc = cy__print_str;
+    } break;
+    case CY__FMT_ARG_CUSTOM: {
+        CyFormatOptions opts = {
+            .width = info.width,
+            .precision = info.precision,
+            .left_align = (info.flags & CY__FMT_MINUS) != 0,
+        };
+        cy__fmt_custom_specs[spec->custom].proc(w, arg->value.p, &opts);
+        return;
+    } break;
+#endif
+    default: {
+        const char *msg = "%!(missing format specifier)";
+        info.value.s = cy_string_view_create_c(msg);
+        info.width = 0;
+        print_proc = cy__print_str;
+    } break;
+    }
+
+    b32 right_pad = info.flags & CY__FMT_MINUS;
+    b32 fill_with_zeros = !right_pad && (info.flags & CY__FMT_ZERO);
+    if (print_proc == cy__print_str) {
+        // NOTE(cya): strings go straight from the source to the output
+        isize len = info.value.s.len;
+        if (info.precision > 0) {
+            len = CY_MIN(len, info.precision);
+        }
+
+        isize pad = fill_with_zeros ? 0 : CY_MAX(info.width - len, 0);
+        if (!right_pad) {
+            cy__fmt_write_fill(w, ' ', pad);
+        }
+
+        cy__fmt_write(w, (const char*)info.value.s.text, len);
+        if (right_pad) {
+            cy__fmt_write_fill(w, ' ', pad);
+        }
+
+        return;
+    }
+
+    if (print_proc != NULL) {
+        conv_len = print_proc(conv_buf, cy_sizeof(conv_buf), info, &zeros);
+        CY_ASSERT(conv_len < cy_sizeof(conv_buf));
+    }
+
+    // NOTE(cya): [pad][head][zeros][tail][pad], none of it moved around
+    isize len = conv_len + zeros.len;
+    isize pad = fill_with_zeros ? 0 : CY_MAX(info.width - len, 0);
+    if (!right_pad) {
+        cy__fmt_write_fill(w, ' ', pad);
+    }
+
+    cy__fmt_write(w, conv_buf, zeros.offset);
+    cy__fmt_write_fill(w, '0', zeros.len);
+    cy__fmt_write(w, conv_buf + zeros.offset, conv_len - zeros.offset);
+    if (right_pad) {
+        cy__fmt_write_fill(w, ' ', pad);
+    }
+}
+
+// NOTE(cya): fetches the spec's arguments and runs the conversion
+cy_internal b32 cy__fmt_write_spec(
+    CyPrivFmtWriter *w, const CyPrivFmtSpec *spec, va_list *va
+) {
+    CyPrivFmtArg arg;
+    cy__fmt_fetch_arg(spec, va, &arg);
+    cy__fmt_write_arg(w, spec, &arg);
+    return true;
+}
+
+cy_internal b32 cy__fmt_format(CyPrivFmtWriter *w, const char *fmt, va_list va)
+{
+    va_list args;
+    va_copy(args, va);
+
+    b32 ok = true;
+    const char *f = fmt;
+    for (;;) {
+        const char *lit = f;
+        while (*f != '\0' && *f != '%') {
+            f += 1;
+        }
+
+        cy__fmt_write_literal(w, fmt, lit, f - lit);
+        if (*f++ == '\0') {
+            break;
+        }
+
+        CyPrivFmtSpec spec;
+        f = cy__fmt_parse_spec(f, &spec);
+        if (!cy__fmt_write_spec(w, &spec, &args)) {
+            ok = false;
+            break;
+        }
+    }
+
+    va_end(args);
+    return ok;
+}
+
+cy_inline void cy_format_write(CyFormatWriter *w, const char *src, isize len)
+{
+    cy__fmt_write(w, src, len);
+}
+
+cy_inline void cy_format_write_c(CyFormatWriter *w, const char *str)
+{
+    cy__fmt_write(w, str, cy_str_len(str));
+}
+
+cy_inline void cy_format_write_fill(CyFormatWriter *w, char c, isize count)
+{
+    cy__fmt_write_fill(w, (u8)c, count);
+}
+
+cy_inline b32 cy_format_writef(CyFormatWriter *w, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    b32 ok = cy_format_writef_va(w, fmt, va);
+    va_end(va);
+
+    return ok;
+}
+
+cy_inline b32 cy_format_writef_va(
+    CyFormatWriter *w, const char *fmt, va_list va
+) {
+    return cy__fmt_format(w, fmt, va);
+}
+
+isize cy_sprintf_va(char *buf, isize size, const char *fmt, va_list va)
+{
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(&w, buf, size);
+
+    b32 ok = cy__fmt_format(&w, fmt, va);
+    isize len = cy__fmt_writer_finish(&w);
+    return ok ? len : -1;
+}
+
+cy_internal CY__FMT_FLUSH_PROC(cy__fmt_flush_file)
+{
+    b32 ok = cy_file_write((CyFile*)w->sink, w->buf, w->written);
+    w->end = w->buf;
+    w->written = 0;
+
+    return ok;
+}
+
+isize cy_fprintf_va(CyFile *f, const char *fmt, va_list va)
+{
+    char buf[CY__FMT_STATIC_BUF_SIZE];
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(&w, buf, CY_ARRAY_LEN(buf));
+    w.flush = cy__fmt_flush_file;
+    w.sink = f;
+
+    b32 ok = cy__fmt_format(&w, fmt, va);
+    if (w.flush != NULL && w.written > 0) {
+        w.flush(&w);
+    }
+
+    isize len = cy__fmt_writer_finish(&w);
+    return ok ? len : -1;
+}
+
+typedef struct {
+    CyAllocator alloc;
+    char *heap_buf;
+} CyPrivFmtAllocSink;
+
+// NOTE(cya): moves the output from the stack to the allocator, then doubles it
+cy_internal CY__FMT_FLUSH_PROC(cy__fmt_flush_alloc)
+{
+    CyPrivFmtAllocSink *sink = w->sink;
+    isize old_size = w->limit + 1;
+    isize new_size = old_size * 2;
+
+    char *new_buf;
+    if (sink->heap_buf == NULL) {
+        new_buf = cy_alloc(sink->alloc, new_size);
+        if (new_buf != NULL) {
+            cy_mem_copy(new_buf, w->buf, w->written);
+        }
+    } else {
+        new_buf = cy_resize(sink->alloc, sink->heap_buf, old_size, new_size);
+    }
+    if (new_buf == NULL) {
+        return false;
+    }
+
+    sink->heap_buf = new_buf;
+    w->buf = new_buf;
+    w->end = new_buf + w->written;
+    w->limit = new_size - 1;
+
+    return true;
+}
+
+char *cy_aprintf_va(CyAllocator a, const char *fmt, va_list va)
+{
+    char buf[CY__FMT_STATIC_BUF_SIZE];
+    CyPrivFmtAllocSink sink = {.alloc = a};
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(&w, buf, CY_ARRAY_LEN(buf));
+    w.flush = cy__fmt_flush_alloc;
+    w.sink = &sink;
+
+    b32 ok = cy__fmt_format(&w, fmt, va) && !w.flush_failed;
+    isize size = cy__fmt_writer_finish(&w) + 1;
+    if (!ok) {
+        if (sink.heap_buf != NULL) {
+            cy_free(a, sink.heap_buf);
+        }
+
+        return NULL;
+    }
+
+    // NOTE(cya): a single allocation of the exact size for short outputs
+    char *res;
+    if (sink.heap_buf == NULL) {
+        res = cy_alloc(a, size);
+        if (res != NULL) {
+            cy_mem_copy(res, buf, size);
+        }
+    } else {
+        res = cy_resize(a, sink.heap_buf, w.limit + 1, size);
+        if (res == NULL) {
+            cy_free(a, sink.heap_buf);
+        }
+    }
+
+    return res;
+}
+
+cy_inline CyFormat cy_format_compile(const char *fmt)
+{
+    return cy_format_compile_alloc(cy_heap_allocator(), fmt);
+}
+
+CyFormat cy_format_compile_alloc(CyAllocator a, const char *fmt)
+{
+    // NOTE(cya): every op but the last one is terminated by a '%'
+    isize op_cap = 1;
+    for (const char *c = fmt; *c != '\0'; c++) {
+        op_cap += (*c == '%');
+    }
+
+    CyFormat res = {.alloc = a, .fmt = fmt};
+    CyPrivFmtOp *ops = cy_alloc_array(a, CyPrivFmtOp, op_cap);
+    if (ops == NULL) {
+        // NOTE(cya): cy_sprintf_compiled falls back to parsing `fmt` directly
+        return res;
+    }
+
+    isize op_count = 0;
+    const char *f = fmt;
+    for (;;) {
+        CY_ASSERT(op_count < op_cap);
+        CyPrivFmtOp *op = &ops[op_count++];
+        op->lit = f;
+        while (*f != '\0' && *f != '%') {
+            f += 1;
+        }
+
+        op->lit_len = f - op->lit;
+        op->has_spec = (*f++ != '\0');
+        if (!op->has_spec) {
+            break;
+        }
+
+        f = cy__fmt_parse_spec(f, &op->spec);
+    }
+
+    res.ops = ops;
+    res.op_count = op_count;
+    return res;
+}
+
+void cy_format_free(CyFormat *fmt)
+{
+    if (fmt->ops != NULL) {
+        cy_free(fmt->alloc, fmt->ops);
+    }
+
+    *fmt = (CyFormat){0};
+}
+
+cy_inline isize cy_sprintf_compiled(
+    char *buf, isize size, const CyFormat *fmt, ...
+) {
+    va_list va;
+    va_start(va, fmt);
+    isize len = cy_sprintf_compiled_va(buf, size, fmt, va);
+    va_end(va);
+
+    return len;
+}
+
+isize cy_sprintf_compiled_va(
+    char *buf, isize size, const CyFormat *fmt, va_list va
+) {
+    if (fmt->ops == NULL) {
+        return cy_sprintf_va(buf, size, fmt->fmt, va);
+    }
+
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(&w, buf, size);
+
+    va_list args;
+    va_copy(args, va);
+
+    b32 ok = true;
+    for (isize i = 0; i < fmt->op_count; i++) {
+        const CyPrivFmtOp *op = &fmt->ops[i];
+        cy__fmt_write_literal(&w, fmt->fmt, op->lit, op->lit_len);
+        if (op->has_spec && !cy__fmt_write_spec(&w, &op->spec, &args)) {
+            ok = false;
+            break;
+        }
+    }
+
+    va_end(args);
+
+    isize len = cy__fmt_writer_finish(&w);
+    return ok ? len : -1;
+}
+
+/* ============================ Deferred logging ============================ */
+#if defined(CY_COMPILER_MSVC)
+    #include <intrin.h>
+
+// NOTE(cya): plain loads and stores already have acquire/release semantics
+// on x86/x64, so these only have to keep the compiler from reordering them
+cy_internal cy_inline usize cy__atomic_load_acquire(volatile usize *p)
+{
+    usize val = *p;
+    _ReadWriteBarrier();
+    return val;
+}
+
+cy_internal cy_inline void cy__atomic_store_release(
+    volatile usize *p, usize val
+) {
+    _ReadWriteBarrier();
+    *p = val;
+}
+
+cy_internal cy_inline void *cy__atomic_load_ptr_acquire(void *volatile *p)
+{
+    void *val = *p;
+    _ReadWriteBarrier();
+    return val;
+}
+
+cy_internal cy_inline b32 cy__atomic_cas_ptr(
+    void *volatile *p, void *expected, void *desired
+) {
+    return _InterlockedCompareExchangePointer(p, desired, expected) == expected;
+}
+
+cy_internal cy_inline void cy__atomic_store_ptr_release(
+    void *volatile *p, void *val
+) {
+    _ReadWriteBarrier();
+    *p = val;
+}
+
+cy_internal cy_inline u32 cy__atomic_load_u32_acquire(volatile u32 *p)
+{
+    u32 val = *p;
+    _ReadWriteBarrier();
+    return val;
+}
+
+cy_internal cy_inline void cy__atomic_store_u32_release(
+    volatile u32 *p, u32 val
+) {
+    _ReadWriteBarrier();
+    *p = val;
+}
+
+cy_internal cy_inline b32 cy__atomic_cas(
+    volatile usize *p, usize expected, usize desired
+) {
+    return (usize)_InterlockedCompareExchangePointer(
+        (void *volatile*)p, (void*)desired, (void*)expected
+    ) == expected;
+}
+#else
+cy_internal cy_inline usize cy__atomic_load_acquire(volatile usize *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+cy_internal cy_inline void cy__atomic_store_release(
+    volatile usize *p, usize val
+) {
+    __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+cy_internal cy_inline void *cy__atomic_load_ptr_acquire(void *volatile *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+cy_internal cy_inline b32 cy__atomic_cas_ptr(
+    void *volatile *p, void *expected, void *desired
+) {
+    return __atomic_compare_exchange_n(
+        p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    );
+}
+
+cy_internal cy_inline void cy__atomic_store_ptr_release(
+    void *volatile *p, void *val
+) {
+    __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+cy_internal cy_inline u32 cy__atomic_load_u32_acquire(volatile u32 *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+cy_internal cy_inline void cy__atomic_store_u32_release(
+    volatile u32 *p, u32 val
+) {
+    __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+cy_internal cy_inline b32 cy__atomic_cas(
+    volatile usize *p, usize expected, usize desired
+) {
+    return __atomic_compare_exchange_n(
+        p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    );
+}
+#endif
+
+#define CY__LOG_CACHE_LINE 64
+#define CY__LOG_MIN_SIZE 256
+
+/*
+ * Single producer/single consumer ring: the logging thread only ever moves
+ * `head` and the draining thread only ever moves `tail` (both just keep going
+ * up and get masked into `data`), so each one gets its own cache line
+ */
+typedef struct CyPrivLogBuffer CyPrivLogBuffer;
+struct CyPrivLogBuffer {
+    CyAllocator alloc;
+    CyPrivLogBuffer *next;
+    u8 *data;
+    usize mask;
+    volatile usize closed;
+
+    u8 head_pad[CY__LOG_CACHE_LINE];
+    volatile usize head;
+
+    u8 tail_pad[CY__LOG_CACHE_LINE];
+    volatile usize tail;
+};
+
+enum {
+    CY__LOG_RECORD_PAD = CY_BIT(0), // NOTE(cya): skipped space at the end
+    CY__LOG_RECORD_COMPILED = CY_BIT(1),
+};
+
+// NOTE(cya): every record starts at (and is a multiple of) 8 bytes
+typedef struct {
+    u32 size;
+    u32 flags;
+    const void *fmt;
+} CyPrivLogRecord;
+
+// NOTE(cya): packed args of a spec (strings are copied right after them)
+typedef struct {
+    i32 width;
+    i32 precision;
+    u64 value;
+} CyPrivLogArg;
+
+typedef struct {
+    CyPrivFmtArg args[CY_LOG_MAX_ARGS];
+    u8 kinds[CY_LOG_MAX_ARGS];
+    isize count;
+    usize size;
+    b32 overflow;
+} CyPrivLogArgs;
+
+cy_global CyPrivLogBuffer *volatile cy__log_buffers;
+cy_global cy_thread_local CyPrivLogBuffer *cy__log_buffer;
+// NOTE(cya): shared by every producer, so the count can be read from any
+// thread without walking buffers that a drain may be freeing
+cy_global volatile usize cy__log_dropped;
+
+cy_internal void cy__log_count_drop(void)
+{
+    usize dropped;
+    do {
+        dropped = cy__atomic_load_acquire(&cy__log_dropped);
+    } while (!cy__atomic_cas(&cy__log_dropped, dropped, dropped + 1));
+}
+
+cy_internal cy_inline usize cy__log_align(usize n)
+{
+    return (n + 7) & ~(usize)7;
+}
+
+cy_internal cy_inline b32 cy__log_spec_has_arg(const CyPrivFmtSpec *spec)
+{
+    return spec->arg != CY__FMT_ARG_NONE ||
+        spec->width_arg || spec->precision_arg;
+}
+
+cy_internal cy_inline b32 cy__log_arg_is_str(u8 kind)
+{
+    return kind == CY__FMT_ARG_STR || kind == CY__FMT_ARG_VIEW;
+}
+
+b32 cy_log_thread_init(CyAllocator a, isize size)
+{
+    if (cy__log_buffer != NULL || size <= 0 || size > U32_MAX) {
+        return false;
+    }
+
+    usize cap = CY__LOG_MIN_SIZE;
+    while (cap < (usize)size) {
+        cap <<= 1;
+    }
+
+    isize header_size = cy_sizeof(CyPrivLogBuffer);
+    CyPrivLogBuffer *lb = cy_alloc_align(
+        a, header_size + (isize)cap, CY__LOG_CACHE_LINE
+    );
+    if (lb == NULL) {
+        return false;
+    }
+
+    cy_mem_zero(lb, header_size);
+    lb->alloc = a;
+    lb->data = (u8*)lb + header_size;
+    lb->mask = cap - 1;
+
+    void *volatile *list = (void *volatile*)&cy__log_buffers;
+    do {
+        lb->next = cy__atomic_load_ptr_acquire(list);
+    } while (!cy__atomic_cas_ptr(list, lb->next, lb));
+
+    cy__log_buffer = lb;
+    return true;
+}
+
+// NOTE(cya): the buffer is freed by the next drain that empties it
+void cy_log_thread_deinit(void)
+{
+    if (cy__log_buffer != NULL) {
+        cy__atomic_store_release(&cy__log_buffer->closed, true);
+        cy__log_buffer = NULL;
+    }
+}
+
+cy_internal void cy__log_fetch_arg(
+    CyPrivLogArgs *la, const CyPrivFmtSpec *spec, va_list *va
+) {
+    if (!cy__log_spec_has_arg(spec)) {
+        return;
+    }
+    if (la->count >= CY_LOG_MAX_ARGS) {
+        CyPrivFmtArg ignored;
+        cy__fmt_fetch_arg(spec, va, &ignored);
+        la->overflow = true;
+        return;
+    }
+
+    CyPrivFmtArg *arg = &la->args[la->count];
+    cy__fmt_fetch_arg(spec, va, arg);
+    la->kinds[la->count++] = spec->arg;
+
+    la->size += sizeof(CyPrivLogArg);
+    if (cy__log_arg_is_str(spec->arg)) {
+        la->size += cy__log_align((usize)arg->value.s.len);
+    }
+}
+
+/*
+ * Returns where `size` bytes can be written (wrapping around with a padding
+ * record when they don't fit before the end), and the head to publish after
+ */
+cy_internal u8 *cy__log_reserve(
+    CyPrivLogBuffer *lb, usize size, usize *new_head
+) {
+    usize cap = lb->mask + 1;
+    usize head = lb->head;
+    usize tail = cy__atomic_load_acquire(&lb->tail);
+
+    usize ofs = head & lb->mask;
+    usize contiguous = cap - ofs;
+    usize needed = (size > contiguous) ? contiguous + size : size;
+    if (needed > cap - (head - tail)) {
+        return NULL;
+    }
+
+    if (size > contiguous) {
+        CyPrivLogRecord *pad = (CyPrivLogRecord*)(lb->data + ofs);
+        pad->size = (u32)contiguous;
+        pad->flags = CY__LOG_RECORD_PAD;
+        head += contiguous;
+        ofs = 0;
+    }
+
+    *new_head = head + size;
+    return lb->data + ofs;
+}
+
+cy_internal b32 cy__log_push(
+    CyPrivLogBuffer *lb, u32 flags, const void *fmt, const CyPrivLogArgs *la
+) {
+    usize size = cy__log_align(sizeof(CyPrivLogRecord)) + la->size;
+    usize new_head = 0;
+    u8 *dst = la->overflow ? NULL : cy__log_reserve(lb, size, &new_head);
+    if (dst == NULL) {
+        cy__log_count_drop();
+        return false;
+    }
+
+    CyPrivLogRecord *rec = (CyPrivLogRecord*)dst;
+    rec->size = (u32)size;
+    rec->flags = flags;
+    rec->fmt = fmt;
+
+    u8 *cur = dst + cy__log_align(sizeof(CyPrivLogRecord));
+    for (isize i = 0; i < la->count; i++) {
+        const CyPrivFmtArg *arg = &la->args[i];
+        CyPrivLogArg *packed = (CyPrivLogArg*)cur;
+        packed->width = arg->width;
+        packed->precision = arg->precision;
+        cur += sizeof(*packed);
+
+        switch (la->kinds[i]) {
+        case CY__FMT_ARG_STR:
+        case CY__FMT_ARG_VIEW: {
+            packed->value = (u64)arg->value.s.len;
+            cy_mem_copy(cur, arg->value.s.text, arg->value.s.len);
+            cur += cy__log_align((usize)arg->value.s.len);
+        } break;
+        case CY__FMT_ARG_PTR:
+        case CY__FMT_ARG_CUSTOM: {
+            packed->value = (u64)(uintptr)arg->value.p;
+        } break;
+        case CY__FMT_ARG_COUNT: {
+            packed->value = 0;
+        } break;
+        default: {
+            packed->value = arg->value.u;
+        } break;
+        }
+    }
+
+    cy__atomic_store_release(&lb->head, new_head);
+    return true;
+}
+
+b32 cy_log_va(const char *fmt, va_list va)
+{
+    CyPrivLogBuffer *lb = cy__log_buffer;
+    if (lb == NULL) {
+        cy__log_count_drop();
+        return false;
+    }
+
+    CyPrivLogArgs la;
+    la.count = 0, la.size = 0, la.overflow = false;
+
+    va_list args;
+    va_copy(args, va);
+    for (const char *f = fmt; *f != '\0';) {
+        if (*f++ == '%') {
+            CyPrivFmtSpec spec;
+            f = cy__fmt_parse_spec(f, &spec);
+            cy__log_fetch_arg(&la, &spec, &args);
+        }
+    }
+
+    va_end(args);
+    return cy__log_push(lb, 0, fmt, &la);
+}
+
+b32 cy_log_compiled_va(const CyFormat *fmt, va_list va)
+{
+    if (fmt->ops == NULL) {
+        return cy_log_va(fmt->fmt, va);
+    }
+
+    CyPrivLogBuffer *lb = cy__log_buffer;
+    if (lb == NULL) {
+        cy__log_count_drop();
+        return false;
+    }
+
+    CyPrivLogArgs la;
+    la.count = 0, la.size = 0, la.overflow = false;
+
+    va_list args;
+    va_copy(args, va);
+    for (isize i = 0; i < fmt->op_count; i++) {
+        if (fmt->ops[i].has_spec) {
+            cy__log_fetch_arg(&la, &fmt->ops[i].spec, &args);
+        }
+    }
+
+    va_end(args);
+    return cy__log_push(lb, CY__LOG_RECORD_COMPILED, fmt, &la);
+}
+
+cy_inline b32 cy_log(const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    b32 ok = cy_log_va(fmt, va);
+    va_end(va);
+
+    return ok;
+}
+
+cy_inline b32 cy_log_compiled(const CyFormat *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    b32 ok = cy_log_compiled_va(fmt, va);
+    va_end(va);
+
+    return ok;
+}
+
+// NOTE(cya): unpacks the spec's args (if it has any) and runs the conversion
+cy_internal void cy__log_write_spec(
+    CyPrivFmtWriter *w, const CyPrivFmtSpec *spec, const u8 **cur
+) {
+    CyPrivFmtArg arg = {
+        .width = spec->width,
+        .precision = spec->precision,
+    };
+    if (cy__log_spec_has_arg(spec)) {
+        const CyPrivLogArg *packed = (const CyPrivLogArg*)*cur;
+        arg.width = packed->width;
+        arg.precision = packed->precision;
+        *cur += sizeof(*packed);
+
+        switch (spec->arg) {
+        case CY__FMT_ARG_STR:
+        case CY__FMT_ARG_VIEW: {
+            isize len = (isize)packed->value;
+            arg.value.s = cy_string_view_create_len((const char*)*cur, len);
+            *cur += cy__log_align((usize)len);
+        } break;
+        case CY__FMT_ARG_PTR:
+        case CY__FMT_ARG_CUSTOM: {
+            arg.value.p = (const void*)(uintptr)packed->value;
+        } break;
+        case CY__FMT_ARG_COUNT: {
+            arg.value.p = NULL;
+        } break;
+        default: {
+            arg.value.u = packed->value;
+        } break;
+        }
+    }
+
+    cy__fmt_write_arg(w, spec, &arg);
+}
+
+cy_internal void cy__log_write_record(
+    CyPrivFmtWriter *w, const CyPrivLogRecord *rec
+) {
+    const u8 *cur = (const u8*)rec + cy__log_align(sizeof(*rec));
+    const char *fmt = rec->fmt;
+    if (rec->flags & CY__LOG_RECORD_COMPILED) {
+        const CyFormat *compiled = rec->fmt;
+        fmt = compiled->fmt;
+        if (compiled->ops != NULL) {
+            for (isize i = 0; i < compiled->op_count; i++) {
+                const CyPrivFmtOp *op = &compiled->ops[i];
+                cy__fmt_write_literal(w, fmt, op->lit, op->lit_len);
+                if (op->has_spec) {
+                    cy__log_write_spec(w, &op->spec, &cur);
+                }
+            }
+
+            return;
+        }
+    }
+
+    const char *f = fmt;
+    for (;;) {
+        const char *lit = f;
+        while (*f != '\0' && *f != '%') {
+            f += 1;
+        }
+
+        cy__fmt_write_literal(w, fmt, lit, f - lit);
+        if (*f++ == '\0') {
+            break;
+        }
+
+        CyPrivFmtSpec spec;
+        f = cy__fmt_parse_spec(f, &spec);
+        cy__log_write_spec(w, &spec, &cur);
+    }
+}
+
+// NOTE(cya): returns the number of logs written (or -1 if writing failed)
+isize cy_log_drain(CyFile *f)
+{
+    char buf[CY__FMT_STATIC_BUF_SIZE];
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(&w, buf, CY_ARRAY_LEN(buf));
+    w.flush = cy__fmt_flush_file;
+    w.sink = f;
+
+    void *volatile *list = (void *volatile*)&cy__log_buffers;
+    CyPrivLogBuffer *prev = NULL;
+    CyPrivLogBuffer *lb = cy__atomic_load_ptr_acquire(list);
+    isize count = 0;
+    while (lb != NULL) {
+        // NOTE(cya): closed first, so nothing logged before closing is lost
+        b32 closed = (b32)cy__atomic_load_acquire(&lb->closed);
+        usize head = cy__atomic_load_acquire(&lb->head);
+        usize tail = lb->tail;
+        while (tail != head) {
+            const CyPrivLogRecord *rec =
+                (const CyPrivLogRecord*)(lb->data + (tail & lb->mask));
+            if (!(rec->flags & CY__LOG_RECORD_PAD)) {
+                cy__log_write_record(&w, rec);
+                count += 1;
+            }
+
+            tail += rec->size;
+            cy__atomic_store_release(&lb->tail, tail);
+        }
+
+        CyPrivLogBuffer *next = lb->next;
+        if (!closed) {
+            prev = lb;
+            lb = next;
+            continue;
+        }
+
+        // NOTE(cya): new buffers only ever get pushed in front of the list
+        if (prev == NULL && !cy__atomic_cas_ptr(list, lb, next)) {
+            prev = cy__atomic_load_ptr_acquire(list);
+            while (prev->next != lb) {
+                prev = prev->next;
+            }
+        }
+        if (prev != NULL) {
+            prev->next = next;
+        }
+
+        cy_free(lb->alloc, lb);
+        lb = next;
+    }
+
+    if (w.flush != NULL && w.written > 0) {
+        w.flush(&w);
+    }
+
+    cy__fmt_writer_finish(&w);
+    return w.flush_failed ? -1 : count;
+}
+
+u64 cy_log_dropped_count(void)
+{
+    return (u64)cy__atomic_load_acquire(&cy__log_dropped);
+}
+
+/* ============================= Virtual memory ============================= */
+cy_global CyOSMemoryBlock cy__os_memory_block_sentinel = {
+    .prev = &cy__os_memory_block_sentinel,
+    .next = &cy__os_memory_block_sentinel,
+};
+
+cy_internal CyOSMemoryBlock *cy__os_virtual_memory_reserve(isize size);
+cy_internal void cy__os_virtual_memory_commit(void *mem, isize size);
+cy_internal void cy__os_virtual_memory_free(CyOSMemoryBlock *block);
+cy_internal void cy__os_virtual_memory_protect(void *memory, isize size);
+
+cy_inline CyMemoryBlock *cy_virtual_memory_alloc(isize size)
+{
+    return cy_virtual_memory_alloc_reserve(size, size);
+}
+
+CyMemoryBlock *cy_virtual_memory_alloc_reserve(isize size, isize commit_size)
+{
+    CY_ASSERT(commit_size <= size);
+
+    isize page_size = cy_virtual_memory_page_size(NULL);
+    isize total_size = size + cy_sizeof(CyOSMemoryBlock);
+    isize total_commit_size = commit_size + cy_sizeof(CyOSMemoryBlock);
+    isize start_offset = cy_sizeof(CyOSMemoryBlock);
+
+    isize aligned_size = cy_align_forward_size(total_size, page_size);
+    isize aligned_commit_size = cy_align_forward_size(
+        total_commit_size, page_size
+    );
+    total_size = aligned_size + 2 * page_size;
+    total_commit_size = page_size + aligned_commit_size;
+
+    start_offset = page_size + aligned_size - size;
+    isize protect_offset = page_size + aligned_size;
+
+    CyOSMemoryBlock *os_block = cy__os_virtual_memory_reserve(total_size);
+    CY_ASSERT_MSG(os_block != NULL, "out of virtual memory D:");
+
+    cy__os_virtual_memory_commit(os_block, total_commit_size);
+    CY_ASSERT(os_block->block.start == NULL);
+
+    os_block->block.start = (u8*)os_block + start_offset;
+    os_block->block.size = size;
+    os_block->commit_size = commit_size;
+    os_block->total_size = total_size;
+
+    cy__os_virtual_memory_protect((u8*)os_block + protect_offset, page_size);
+
+    CyOSMemoryBlock *sentinel = &cy__os_memory_block_sentinel;
+    os_block->next = sentinel;
+    os_block->prev = sentinel->prev;
+    os_block->next->prev = os_block;
+    os_block->prev->next = os_block;
+
+    return &os_block->block;
+}
+
+void cy_virtual_memory_free(CyMemoryBlock *block)
+{
+    CyOSMemoryBlock *os_block = (CyOSMemoryBlock*)block;
+    if (os_block == NULL) {
+        return;
+    }
+
+    os_block->prev->next = os_block->next;
+    os_block->next->prev = os_block->prev;
+
+    cy__os_virtual_memory_free(os_block);
+}
+
+cy_inline CyMemoryBlock *cy_virtual_memory_resize(
+    CyMemoryBlock *block, isize new_size
+) {
+    CY_VALIDATE_PTR(block);
+
+    isize old_size = block->size;
+    if (new_size < old_size) {
+        void *new_start = (u8*)block->start + (old_size - new_size);
+        cy_mem_move(new_start, block->start, new_size);
+
+        block->start = new_start;
+        block->size = new_size;
+        return block;
+    }
+
+    CyMemoryBlock *new_block = cy_virtual_memory_alloc(new_size);
+    CY_VALIDATE_PTR(new_block);
+
+    cy_mem_copy(new_block->start, block->start, block->size);
+    return new_block;
+}
+
+#if defined(CY_OS_WINDOWS)
+cy_inline isize cy_virtual_memory_page_size(isize *align_out)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    if (align_out != NULL) {
+        *align_out = (isize)info.dwAllocationGranularity;
+    }
+
+    return (isize)info.dwPageSize;
+}
+
+cy_internal cy_inline CyOSMemoryBlock *cy__os_virtual_memory_reserve(isize size)
+{
+    return VirtualAlloc(NULL, (usize)size, MEM_RESERVE, PAGE_READWRITE);
+}
+
+cy_internal cy_inline void cy__os_virtual_memory_commit(void *mem, isize size)
+{
+    VirtualAlloc(mem, (usize)size, MEM_COMMIT, PAGE_READWRITE);
+}
+
+cy_internal cy_inline void cy__os_virtual_memory_free(CyOSMemoryBlock *block)
+{
+    VirtualFree(block, 0, MEM_RELEASE);
+}
+
+cy_internal cy_inline void cy__os_virtual_memory_protect(void *mem, isize size)
+{
+    cy__os_virtual_memory_commit(mem, size);
+
+    DWORD old_protect = 0;
+    BOOL ok = VirtualProtect(mem, (usize)size, PAGE_NOACCESS, &old_protect);
+    CY_ASSERT(ok);
+}
+#else
+
+#endif
+
+/* =============================== Allocators =============================== */
+// NOTE(cya): names in parentheses so the call site tracking macros don't
+// expand here (see CY_TRACK_ALLOCATIONS)
+cy_inline void *(cy_alloc_align)(CyAllocator a, isize size, isize align)
+{
+    return a.proc(
+        a.data, CY_ALLOCATION_ALLOC,
+        size, align,
+        NULL, 0,
+        CY_DEFAULT_ALLOCATOR_FLAGS
+    );
+}
+
+cy_inline void *(cy_alloc)(CyAllocator a, isize size)
+{
+    return (cy_alloc_align)(a, size, CY_DEFAULT_ALIGNMENT);
+}
+
+cy_inline void **(cy_alloc_batch_align)(
+    CyAllocator a, void **ptrs, isize count, isize size, isize align
+) {
+    if (count <= 0) {
+        return ptrs;
+    }
+
+    return a.proc(
+        a.data, CY_ALLOCATION_ALLOC_BATCH,
+        size, align,
+        ptrs, count,
+        CY_DEFAULT_ALLOCATOR_FLAGS
+    );
+}
+
+cy_inline void cy_free(CyAllocator a, void *ptr)
+{
+    if (ptr != NULL) {
+        a.proc(
+            a.data, CY_ALLOCATION_FREE,
+            0, 0,
+            ptr, 0,
+            CY_DEFAULT_ALLOCATOR_FLAGS
+        );
+    }
+}
+
+cy_inline void cy_free_all(CyAllocator a)
+{
+    a.proc(
+        a.data, CY_ALLOCATION_FREE_ALL,
+        0, 0,
+        NULL, 0,
+        CY_DEFAULT_ALLOCATOR_FLAGS
+    );
+}
+
+cy_inline void *(cy_resize_align)(
+    CyAllocator a, void *ptr, isize old_size, isize new_size, isize align
+) {
+    return a.proc(
+        a.data, CY_ALLOCATION_RESIZE,
+        new_size, align,
+        ptr, old_size,
+        CY_DEFAULT_ALLOCATOR_FLAGS
+    );
+}
+
+cy_inline void *(cy_resize)(
+    CyAllocator a, void *ptr, isize old_size, isize new_size
+) {
+    return (cy_resize_align)(
+        a, ptr, old_size, new_size, CY_DEFAULT_ALIGNMENT
+    );
+}
+
+cy_inline void *cy_default_resize_align(
+    CyAllocator a, void *old_mem, isize old_size, isize new_size, isize align
+) {
+    if (old_mem == NULL) {
+        return cy_alloc_align(a, new_size, align);
+    }
+    if (new_size == 0) {
+        cy_free(a, old_mem);
+        return NULL;
+    }
+    if (new_size <= old_size) {
+        return old_mem;
+    }
+
+    void *new_mem = cy_alloc_align(a, new_size, align);
+    if (new_mem == NULL) {
+        return NULL;
+    }
+
+    cy_mem_move(new_mem, old_mem, old_size);
+    cy_free(a, old_mem);
+    return new_mem;
+}
+
+cy_inline void *cy_default_resize(
+    CyAllocator a, void *old_mem, isize old_size, isize new_size
+) {
+    return cy_default_resize_align(
+        a, old_mem,
+        old_size, new_size,
+        CY_DEFAULT_ALIGNMENT
+    );
+}
+
+void **cy_default_alloc_batch_align(
+    CyAllocator a, void **ptrs, isize count, isize size, isize align
+) {
+    for (isize i = 0; i < count; i++) {
+        ptrs[i] = cy_alloc_align(a, size, align);
+        if (ptrs[i] == NULL) {
+            while (i-- > 0) {
+                cy_free(a, ptrs[i]);
+            }
+
+            return NULL;
+        }
+    }
+
+    return ptrs;
+}
+
+cy_inline void *cy_alloc_copy_align(
+    CyAllocator a, const void *src, isize size, isize align
+) {
+    return cy_mem_copy(cy_alloc_align(a, size, align), src, size);
+}
+
+cy_inline void *cy_alloc_copy(CyAllocator a, const void *src, isize size)
+{
+    return cy_alloc_copy_align(a, src, size, CY_DEFAULT_ALIGNMENT);
+}
+
+cy_inline char *cy_alloc_string_len(CyAllocator a, const char *str, isize len)
+{
+    char *res = cy_alloc(a, len + 1);
+    CY_VALIDATE_PTR(res);
+
+    cy_mem_copy(res, str, len);
+    res[len] = '\0';
+    return res;
+}
+
+cy_inline char *cy_alloc_string(CyAllocator a, const char *str)
+{
+    return cy_alloc_string_len(a, str, cy_str_len(str));
+}
+
+cy_inline CyAllocator cy_null_allocator(void)
+{
+    return (CyAllocator){
+        .proc = cy_null_allocator_proc,
+    };
+}
+
+CY_ALLOCATOR_PROC(cy_null_allocator_proc)
+{
+    CY_UNUSED(allocator_data);
+    CY_UNUSED(size);
+    CY_UNUSED(align);
+    CY_UNUSED(old_size);
+    CY_UNUSED(flags);
+
+    void *ptr = NULL;
+    switch(type) {
+    case CY_ALLOCATION_FREE: {
+        CY_ASSERT_MSG(old_mem == NULL, "null allocator: invalid pointer");
+    } break;
+    default: break;
+    }
+
+    return ptr;
+}
+
+cy_inline CyAllocator cy_heap_allocator(void)
+{
+    return (CyAllocator){
+        .proc = cy_heap_allocator_proc,
+    };
+}
+
+#if defined(CY_OS_WINDOWS)
+    #include <malloc.h>
+
+    #define malloc_align(s, a) _aligned_malloc((usize)s, (usize)a)
+    #define realloc_align(alloc, mem, old_size, new_size, align) \
+        _aligned_realloc(mem, (usize)new_size, (usize)align)
+    #define free_align(p, a) _aligned_free(p)
+#else
+extern int posix_memalign(void**, size_t, size_t);
+
+void *malloc_align(isize size, isize align)
+{
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, align, size) != 0) {
+        return NULL;
+    }
+
+    return ptr;
+}
+
+    #define realloc_align cy_default_resize_align
+    #define free_align(p, a) free(p)
+#endif
+
+CY_ALLOCATOR_PROC(cy_heap_allocator_proc)
+{
+#if defined(CY_OS_WINDOWS)
+    CY_UNUSED(old_size);
+#endif
+
+    CY_UNUSED(allocator_data);
+    CY_UNUSED(old_size);
+
+    void *ptr = NULL;
+    switch(type) {
+    case CY_ALLOCATION_ALLOC: {
+        ptr = malloc_align(size, align);
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(ptr, size);
+        }
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL: {
+    } break;
+    case CY_ALLOCATION_FREE: {
+        free_align(old_mem, align);
+    } break;
+    case CY_ALLOCATION_FREE_ALL: {
+    } break;
+    case CY_ALLOCATION_RESIZE: {
+        void *new_ptr = realloc_align(
+            cy_heap_allocator(), old_mem,
+            old_size, size, align
+        );
+        CY_VALIDATE_PTR(new_ptr);
+        ptr = new_ptr;
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        void **ptrs = old_mem;
+        isize count = old_size;
+        for (isize i = 0; i < count; i++) {
+            ptrs[i] = malloc_align(size, align);
+            if (ptrs[i] == NULL) {
+                while (i-- > 0) {
+                    free_align(ptrs[i], align);
+                }
+
+                return NULL;
+            }
+            if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+                cy_mem_zero(ptrs[i], size);
+            }
+        }
+
+        ptr = ptrs;
+    } break;
+    }
+
+    return ptr;
+}
+
+/* ---------------------------- Static Allocator ---------------------------- */
+cy_inline CyAllocator cy_static_allocator(CyBuffer *buf)
+{
+    return (CyAllocator){
+        .proc = cy_static_allocator_proc,
+        .data = buf,
+    };
+}
+
+cy_inline CyBuffer cy_static_buf_init(void *backing_buf, isize size)
+{
+    return (CyBuffer){
+        .memory = backing_buf,
+        .size = size,
+    };
+}
+
+CY_ALLOCATOR_PROC(cy_static_allocator_proc)
+{
+    CY_UNUSED(align);
+    CY_UNUSED(old_mem);
+    CY_UNUSED(old_size);
+
+    CyBuffer *buf = allocator_data;
+    void *ptr = NULL;
+    switch (type) {
+    case CY_ALLOCATION_ALLOC: {
+        CY_ASSERT_MSG(size == buf->size, "static_allocator: invalid size");
+    } // NOTE(cya): fallthrough
+    case CY_ALLOCATION_ALLOC_ALL: {
+        ptr = buf->memory;
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(ptr, size);
+        }
+    } break;
+    case CY_ALLOCATION_FREE:
+    case CY_ALLOCATION_FREE_ALL:
+    case CY_ALLOCATION_RESIZE:
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        CY_PANIC("static allocator: unsupported operation");
+    } break;
+    }
+
+    return ptr;
+}
+
+/* ---------------------- Virtual Memory (VM) Allocator --------------------- */
+CyAllocator cy_virtual_memory_allocator(void)
+{
+    return (CyAllocator){
+        .proc = cy_virtual_memory_allocator_proc,
+    };
+}
+
+cy_internal uintptr *cy__vm_header_from_alloc_start(void *ptr)
+{
+    return (uintptr*)((u8*)ptr - cy_sizeof(uintptr));
+}
+
+CY_ALLOCATOR_PROC(cy_virtual_memory_allocator_proc)
+{
+    CY_UNUSED(allocator_data);
+    CY_UNUSED(flags);
+    CY_UNUSED(old_size);
+
+    void *ptr = NULL;
+    switch (type) {
+    case CY_ALLOCATION_ALLOC: {
+        CY_ASSERT_MSG(size > 0, "VM allocator: invalid allocation size");
+
+        isize alignment = CY_MAX(align, cy_sizeof(uintptr));
+        isize total_size = size + alignment - 1;
+        CyMemoryBlock *block = cy_virtual_memory_alloc(total_size);
+        if (block == NULL) {
+            CY_PANIC("VM allocator: out of virtual memory");
+            break;
+        }
+
+        ptr = cy_align_forward_ptr(block->start, alignment);
+        uintptr *header = cy__vm_header_from_alloc_start(ptr);
+        *header = (uintptr)block;
+    } break;
+    case CY_ALLOCATION_FREE: {
+        uintptr *header = cy__vm_header_from_alloc_start(old_mem);
+        CyMemoryBlock *block = (CyMemoryBlock*)(*header);
+        cy_virtual_memory_free(block);
+    } break;
+    case CY_ALLOCATION_RESIZE: {
+        uintptr *header = cy__vm_header_from_alloc_start(old_mem);
+        CyMemoryBlock *block = (CyMemoryBlock*)(*header);
+
+        CyMemoryBlock *new_block = cy_virtual_memory_resize(block, size);
+        if (new_block == NULL) {
+            break;
+        }
+
+        ptr = new_block->start;
+        header = cy__vm_header_from_alloc_start(ptr);
+        *header = (uintptr)new_block;
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        ptr = cy_default_alloc_batch_align(
+            cy_virtual_memory_allocator(), old_mem, old_size, size, align
+        );
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL:
+    case CY_ALLOCATION_FREE_ALL: {
+        CY_PANIC("VM allocator: unsupported operation");
+    } break;
+    }
+
+    return ptr;
+}
+
+/* ---------------------------- Arena Allocator ----------------------------- */
+cy_inline CyAllocator cy_arena_allocator(CyArena *arena)
+{
+    return (CyAllocator){
+        .proc = cy_arena_allocator_proc,
+        .data = arena,
+    };
+}
+
+#ifndef CY_ARENA_DEFAULT_SIZE
+    #define CY_ARENA_DEFAULT_SIZE CY_KB(16)
+#endif
+
+#ifndef CY_ARENA_GROWTH_FACTOR
+    #define CY_ARENA_GROWTH_FACTOR 2.0
+#endif
+
+cy_inline CyMemoryBlock *cy_arena_insert_block(CyArena *arena, isize size)
+{
+    CY_VALIDATE_PTR(arena);
+
+    isize align = CY_DEFAULT_ALIGNMENT;
+    isize block_padding = cy_sizeof(CyMemoryBlock) + align - 1;
+    isize new_block_size = block_padding + size;
+    CyMemoryBlock *new_block = cy_alloc(arena->backing, new_block_size);
+    CY_VALIDATE_PTR(new_block);
+
+    new_block->start = cy_align_forward_ptr(new_block + 1, align);
+    new_block->size = size;
+    new_block->prev = arena->cur_block;
+    arena->cur_block = new_block;
+
+    return new_block;
+}
+
+cy_inline CyArena cy_arena_init(CyAllocator backing, isize initial_size)
+{
+    CY_ASSERT_NOT_NULL(backing.proc);
+
+    isize default_size = CY_ARENA_DEFAULT_SIZE;
+    if (initial_size == 0) {
+        initial_size = default_size;
+    }
+
+    CyArena arena = {.backing = backing};
+    cy_arena_insert_block(&arena, initial_size);
+    return arena;
+}
+
+cy_inline void cy_arena_deinit(CyArena *arena)
+{
+    if (arena == NULL) {
+        return;
+    }
+
+    CyMemoryBlock *cur_block = arena->cur_block;
+    while (cur_block != NULL) {
+        CyMemoryBlock *prev = cur_block->prev;
+        cy_free(arena->backing, cur_block);
+        cur_block = prev;
+    }
+
+    cy_mem_set(arena, 0, cy_sizeof(*arena));
+}
+
+cy_inline CyArenaTemp cy_arena_temp_begin(CyArena *arena)
+{
+    CY_ASSERT_NOT_NULL(arena);
+
+    CyMemoryBlock *block = arena->cur_block;
+    arena->temp_count += 1;
+    return (CyArenaTemp){
+        .arena = arena,
+        .block = block,
+        .offset = block->offset,
+        .prev_offset = block->prev_offset,
+    };
+}
+
+void cy_arena_temp_end(CyArenaTemp temp)
+{
+    CyArena *arena = temp.arena;
+    CY_ASSERT_NOT_NULL(arena);
+    CY_ASSERT_MSG(arena->temp_count > 0, "arena: unbalanced temp scope");
+
+    CyMemoryBlock *cur_block = arena->cur_block;
+    while (cur_block != temp.block) {
+        CY_ASSERT_MSG(cur_block != NULL, "arena: invalid temp scope");
+
+        CyMemoryBlock *prev = cur_block->prev;
+        cy_free(arena->backing, cur_block);
+        cur_block = prev;
+    }
+
+    arena->cur_block = cur_block;
+    cur_block->offset = temp.offset;
+    cur_block->prev_offset = temp.prev_offset;
+    arena->temp_count -= 1;
+}
+
+#ifndef CY_ARENA_SCRATCH_SIZE
+    #define CY_ARENA_SCRATCH_SIZE CY_KB(64)
+#endif
+
+cy_global cy_thread_local CyArena cy__scratch_arenas[CY_ARENA_SCRATCH_COUNT];
+
+CyArenaTemp cy_arena_scratch_begin(
+    CyArena *const *conflicts, isize conflict_count
+) {
+    CyArena *scratch = NULL;
+    for (isize i = 0; i < CY_ARRAY_LEN(cy__scratch_arenas); i++) {
+        CyArena *candidate = &cy__scratch_arenas[i];
+        b32 conflicting = false;
+        for (isize j = 0; j < conflict_count; j++) {
+            if (conflicts[j] == candidate) {
+                conflicting = true;
+                break;
+            }
+        }
+
+        if (!conflicting) {
+            scratch = candidate;
+            break;
+        }
+    }
+
+    if (scratch == NULL) {
+        CY_PANIC("arena: no scratch arena left (raise CY_ARENA_SCRATCH_COUNT)");
+        return (CyArenaTemp){0};
+    }
+    if (scratch->cur_block == NULL) {
+        *scratch = cy_arena_init(cy_heap_allocator(), CY_ARENA_SCRATCH_SIZE);
+    }
+
+    return cy_arena_temp_begin(scratch);
+}
+
+cy_inline void cy_arena_scratch_end(CyArenaTemp temp)
+{
+    cy_arena_temp_end(temp);
+}
+
+void cy_arena_scratch_release(void)
+{
+    for (isize i = 0; i < CY_ARRAY_LEN(cy__scratch_arenas); i++) {
+        CyArena *scratch = &cy__scratch_arenas[i];
+        CY_ASSERT_MSG(scratch->temp_count == 0, "arena: scratch still in use");
+
+        cy_arena_deinit(scratch);
+    }
+}
+
+void *cy_arena_push_slow(CyArena *arena, isize size, isize align)
+{
+    CY_ASSERT(cy_is_power_of_two(align));
+
+    // NOTE(cya): older blocks are never revisited, that way allocations stay
+    // in LIFO order (which temp scopes rely on) and this stays O(1)
+    f64 cur_size = (f64)arena->cur_block->size;
+    isize new_size = (isize)(cur_size * CY_ARENA_GROWTH_FACTOR);
+    isize min_size = size + CY_MAX(align - CY_DEFAULT_ALIGNMENT, 0);
+
+    CyMemoryBlock *block = cy_arena_insert_block(
+        arena, CY_MAX(new_size, min_size)
+    );
+    CY_VALIDATE_PTR(block);
+
+    u8 *aligned_end = cy_align_forward_ptr(block->start, align);
+    isize aligned_offset = aligned_end - (u8*)block->start;
+
+    block->prev_offset = aligned_offset;
+    block->offset = aligned_offset + size;
+    return aligned_end;
+}
+
+CY_ALLOCATOR_PROC(cy_arena_allocator_proc)
+{
+    CyArena *arena = (CyArena*)allocator_data;
+    CyAllocator a = cy_arena_allocator(arena);
+    void *ptr = NULL;
+    switch(type) {
+    case CY_ALLOCATION_ALLOC: {
+        CY_ASSERT(cy_is_power_of_two(align));
+
+        ptr = cy_arena_push(arena, size, align);
+        CY_VALIDATE_PTR(ptr);
+
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(ptr, size);
+        }
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        CY_ASSERT(cy_is_power_of_two(align));
+
+        // NOTE(cya): one bump for the whole batch
+        void **ptrs = old_mem;
+        isize count = old_size;
+        isize stride = cy_align_forward_size(size, align);
+        u8 *mem = cy_arena_push(arena, stride * count, align);
+        CY_VALIDATE_PTR(mem);
+
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(mem, stride * count);
+        }
+        for (isize i = 0; i < count; i++) {
+            ptrs[i] = mem + i * stride;
+        }
+
+        ptr = ptrs;
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL: {
+        CyAllocator backing = arena->backing;
+        CyMemoryBlock *cur_block = arena->cur_block->prev, *prev;
+        while (cur_block != NULL) {
+            prev = cur_block->prev;
+            cy_free(backing, cur_block);
+            cur_block = prev;
+        }
+
+        cur_block = arena->cur_block;
+        isize remaining = cur_block->size - cur_block->offset;
+        ptr = cy_alloc_align(backing, remaining, align);
+        CY_VALIDATE_PTR(ptr);
+
+        ptr = cy_align_forward_ptr(ptr, align);
+    } break;
+    case CY_ALLOCATION_FREE: {
+    } break;
+    case CY_ALLOCATION_FREE_ALL: {
+        CY_ASSERT_MSG(
+            arena->temp_count == 0, "arena allocator: free all in temp scope"
+        );
+
+        CyMemoryBlock *cur_block = arena->cur_block, *prev = cur_block->prev;
+        while (prev != NULL) {
+            cur_block = prev;
+            prev = prev->prev;
+            cy_free(arena->backing, cur_block);
+        }
+
+        // NOTE(cya): keeping the (largest) current block around for reuse
+        cur_block = arena->cur_block;
+        cy_mem_zero(cur_block->start, cur_block->size);
+        cur_block->prev = NULL;
+        cur_block->prev_offset = cur_block->offset = 0;
+    } break;
+    case CY_ALLOCATION_RESIZE: {
+        CY_ASSERT(cy_is_power_of_two(align));
+
+        u8 *old_memory = old_mem;
+        if (old_memory == NULL || old_size == 0) {
+            return cy_alloc_align(a, size, align);
+        }
+
+        CyMemoryBlock *cur_block = arena->cur_block;
+        u8 *start = cur_block->start;
+        isize prev_offset = 0;
+        b32 is_in_range = false, found_node = false;
+        while (cur_block != NULL) {
+            is_in_range = old_memory >= start &&
+                old_memory < (start + cur_block->size);
+            if (is_in_range) {
+                prev_offset = cur_block->prev_offset;
+                found_node = start + prev_offset == old_memory &&
+                    (cur_block->offset - cur_block->prev_offset == old_size);
+                break;
+            }
+
+            cur_block = cur_block->prev;
+            start = cur_block->start;
+        }
+
+        if (!is_in_range) {
+            CY_PANIC("arena allocator: out-of-bounds reallocation");
+            break;
+        } else if (!found_node) {
+            // NOTE(cya): is in valid space but is not the latest allocation
+            // (this might result in some odd behavior in some edge cases)
+            void *new_mem = cy_alloc_align(a, size, align);
+            CY_VALIDATE_PTR(new_mem);
+
+            cy_mem_copy(new_mem, old_mem, CY_MIN(old_size, size));
+            ptr = new_mem;
+            break;
+        }
+
+        intptr aligned_offset = cy_align_forward_size(prev_offset, align);
+        u8 *new_memory = start + aligned_offset;
+        if (new_memory + size < start + cur_block->size) {
+            cur_block->offset = aligned_offset + size;
+            if (cur_block->offset < cur_block->prev_offset + old_size) {
+                cy_mem_set(start + cur_block->offset, 0, old_size - size);
+            }
+
+            cur_block->prev_offset = aligned_offset;
+        } else {
+            void *new_ptr = cy_alloc_align(a, size, align);
+            CY_VALIDATE_PTR(new_ptr);
+
+            cy_mem_move(new_ptr, old_memory, CY_MIN(old_size, size));
+            new_memory = new_ptr;
+        }
+
+        ptr = new_memory;
+    } break;
+    }
+
+    return ptr;
+}
+
+/* -----------------------------Stack Allocator ----------------------------- */
+cy_inline CyAllocator cy_stack_allocator(CyStack *stack)
+{
+    return (CyAllocator){
+        .data = stack,
+        .proc = cy_stack_allocator_proc,
+    };
+}
+
+#ifndef CY_STACK_DEFAULT_SIZE
+    #define CY_STACK_DEFAULT_SIZE CY_KB(16)
+#endif
+
+#ifndef CY_STACK_GROWTH_FACTOR
+    #define CY_STACK_GROWTH_FACTOR 2.0
+#endif
+
+cy_internal cy_inline void cy__stack_update_peaks(CyStackStats *stats)
+{
+    stats->peak_used = CY_MAX(stats->peak_used, stats->used);
+    stats->peak_reserved = CY_MAX(stats->peak_reserved, stats->reserved);
+    stats->peak_nodes = CY_MAX(stats->peak_nodes, stats->nodes);
+}
+
+cy_inline CyStackNode *cy_stack_insert_node(CyStack *stack, isize size)
+{
+    CY_VALIDATE_PTR(stack);
+
+    isize node_padding = cy_sizeof(CyStackNode) + CY_DEFAULT_ALIGNMENT;
+    isize new_node_size = node_padding + size;
+    CyStackNode *new_node = cy_alloc(stack->backing, new_node_size);
+    CY_VALIDATE_PTR(new_node);
+
+    new_node->buf = cy_align_forward_ptr(new_node + 1, CY_DEFAULT_ALIGNMENT);
+    new_node->size = size;
+    new_node->next = stack->state.first_node;
+    stack->state.first_node = new_node;
+
+    CyStackStats *stats = &stack->state.stats;
+    stats->reserved += size;
+    stats->nodes += 1;
+    cy__stack_update_peaks(stats);
+
+    return new_node;
+}
+
+cy_internal void cy__stack_release_node(CyStack *stack, CyStackNode **link)
+{
+    CyStackNode *node = *link;
+    *link = node->next;
+
+    CyStackStats *stats = &stack->state.stats;
+    stats->reserved -= node->size;
+    stats->nodes -= 1;
+    cy_free(stack->backing, node);
+}
+
+// NOTE(cya): pushes a node that fits the allocation (replacing the top node
+// if it's empty, since it's too small anyway)
+cy_internal CyStackNode *cy__stack_grow(CyStack *stack, isize size, isize align)
+{
+    CyStackState *state = &stack->state;
+    f64 largest_node_size = (f64)state->first_node->size;
+    isize new_size = (isize)(largest_node_size * CY_STACK_GROWTH_FACTOR);
+    isize max_alloc_size = align + cy_sizeof(CyStackHeader) + size;
+
+    if (state->first_node->offset == 0 && state->first_node->next != NULL) {
+        cy__stack_release_node(stack, &state->first_node);
+    }
+
+    return cy_stack_insert_node(stack, CY_MAX(new_size, max_alloc_size));
+}
+
+// NOTE(cya): pops the top allocation along with the ones below it that were
+// already freed out of order, releasing nodes as they become empty
+cy_internal void cy__stack_pop(CyStack *stack)
+{
+    CyStackState *state = &stack->state;
+    CyStackStats *stats = &state->stats;
+    while (state->top != NULL) {
+        CyStackHeader *header = (CyStackHeader*)state->top - 1;
+        CyStackNode *node = header->node;
+        CY_ASSERT(node == state->first_node);
+
+        stats->used -= node->offset - header->prev_offset;
+        node->offset = header->prev_offset;
+        state->top = header->prev;
+        if (node->offset == 0 && node->next != NULL) {
+            cy__stack_release_node(stack, &state->first_node);
+        }
+
+        if (state->top == NULL) {
+            break;
+        }
+
+        header = (CyStackHeader*)state->top - 1;
+        if (!header->freed) {
+            break;
+        }
+
+        stats->pending_free -= header->size;
+    }
+}
+
+cy_inline CyStack cy_stack_init(CyAllocator backing, isize initial_size)
+{
+    isize default_size = CY_STACK_DEFAULT_SIZE;
+    if (initial_size == 0) {
+        initial_size = default_size;
+    }
+
+    CyStack stack = {
+        .backing = backing,
+    };
+    cy_stack_insert_node(&stack, initial_size);
+    return stack;
+}
+
+cy_inline void cy_stack_deinit(CyStack *stack)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    CyStackNode *cur_node = stack->state.first_node;
+    while (cur_node != NULL) {
+        CyStackNode *next = cur_node->next;
+        cy_free(stack->backing, cur_node);
+        cur_node = next;
+    }
+
+    cy_mem_set(stack, 0, cy_sizeof(*stack));
+}
+
+cy_inline CyStackStats cy_stack_stats(const CyStack *stack)
+{
+    return stack->state.stats;
+}
+
+// NOTE(cya): finds the node holding ptr (NULL if it's not from this stack)
+// without touching the header, since it may be foreign or already popped
+cy_internal CyStackNode *cy__stack_find_node(
+    const CyStackState *state, const void *ptr
+) {
+    const u8 *addr = ptr;
+    CyStackNode *node = state->first_node;
+    for (; node != NULL; node = node->next) {
+        const u8 *start = node->buf + cy_sizeof(CyStackHeader);
+        if (start <= addr && addr < node->buf + node->size) {
+            break;
+        }
+    }
+
+    return node;
+}
+
+CY_ALLOCATOR_PROC(cy_stack_allocator_proc)
+{
+    CY_ASSERT(cy_is_power_of_two(align));
+
+    CyStack *stack = (CyStack*)allocator_data;
+    CyStackState *state = &stack->state;
+    CyAllocator a = cy_stack_allocator(stack);
+    void *ptr = NULL;
+    switch(type) {
+    case CY_ALLOCATION_ALLOC: {
+        CyStackNode *cur_node = state->first_node;
+        u8 *cur_addr = cur_node->buf + cur_node->offset;
+        CyStackHeader *header;
+        isize padding = cy_calc_header_padding(
+            (uintptr)cur_addr, align, cy_sizeof(*header)
+        );
+        if (cur_node->offset + padding + size > cur_node->size) {
+            cur_node = cy__stack_grow(stack, size, align);
+            CY_VALIDATE_PTR(cur_node);
+
+            cur_addr = cur_node->buf + cur_node->offset;
+            padding = cy_calc_header_padding(
+                (uintptr)cur_addr, align, cy_sizeof(*header)
+            );
+        }
+
+        ptr = cur_addr + padding;
+        header = (CyStackHeader*)ptr - 1;
+        *header = (CyStackHeader){
+            .node = cur_node,
+            .prev = state->top,
+            .prev_offset = cur_node->offset,
+            .size = size,
+        };
+
+        cur_node->offset += padding + size;
+        state->top = ptr;
+        state->stats.used += padding + size;
+        cy__stack_update_peaks(&state->stats);
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(ptr, size);
+        }
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        // NOTE(cya): every item needs its own header for LIFO frees
+        ptr = cy_default_alloc_batch_align(a, old_mem, old_size, size, align);
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL: {
+        // NOTE(cya): only the allocations in the first node survive, so the
+        // chain gets cut before the older nodes are released
+        CyStackNode *cur_node = state->first_node, *next;
+        CyStackStats *stats = &state->stats;
+        stats->pending_free = 0;
+        void **link = &state->top;
+        while (*link != NULL) {
+            CyStackHeader *header = (CyStackHeader*)*link - 1;
+            if (header->node != cur_node) {
+                *link = NULL;
+                break;
+            } else if (header->freed) {
+                stats->pending_free += header->size;
+            }
+
+            link = &header->prev;
+        }
+
+        CyAllocator backing = stack->backing;
+        next = cur_node->next;
+        while (next != NULL) {
+            CyStackNode *node = next;
+            next = next->next;
+            cy_free(backing, node);
+        }
+
+        cur_node->next = NULL;
+        stats->used = cur_node->offset;
+        stats->reserved = cur_node->size;
+        stats->nodes = 1;
+
+        isize remaining = cur_node->size - cur_node->offset;
+        ptr = cy_alloc_align(backing, remaining, align);
+        CY_VALIDATE_PTR(ptr);
+
+        ptr = cy_align_forward_ptr(ptr, align);
+    } break;
+    case CY_ALLOCATION_FREE: {
+        CY_VALIDATE_PTR(old_mem);
+
+        CyStackNode *cur_node = cy__stack_find_node(state, old_mem);
+        if (cur_node == NULL) {
+            CY_PANIC("stack allocator: out-of-bounds pointer");
+            break;
+        }
+        if ((u8*)old_mem >= cur_node->buf + cur_node->offset) {
+            break; // NOTE(cya): allowing double-frees (already popped)
+        }
+
+        CyStackHeader *header = (CyStackHeader*)old_mem - 1;
+        if (header->node != cur_node) {
+            CY_PANIC("stack allocator: invalid pointer");
+            break;
+        }
+        if (header->freed) {
+            break; // NOTE(cya): allowing double-frees (freed out of order)
+        }
+
+        if (old_mem == state->top) {
+            cy__stack_pop(stack);
+        } else {
+            // NOTE(cya): out-of-order free, gets reclaimed once it's on top
+            header->freed = true;
+            state->stats.pending_free += header->size;
+        }
+    } break;
+    case CY_ALLOCATION_FREE_ALL: {
+        CyStackNode *cur_node = state->first_node, *next = cur_node->next;
+        while (next != NULL) {
+            cur_node = next;
+            next = next->next;
+            cy_free(stack->backing, cur_node);
+        }
+
+        cur_node = state->first_node;
+        cy_mem_set(cur_node->buf, 0, cur_node->size);
+        cur_node->offset = 0;
+        cur_node->next = NULL;
+
+        state->top = NULL;
+        state->stats.used = state->stats.pending_free = 0;
+        state->stats.reserved = cur_node->size;
+        state->stats.nodes = 1;
+    } break;
+    case CY_ALLOCATION_RESIZE: {
+        if (old_mem == NULL || old_size == 0) {
+            return cy_alloc_align(a, size, align);
+        } else if (size == 0) {
+            cy_free(a, old_mem);
+            break;
+        }
+
+        CyStackNode *cur_node = cy__stack_find_node(state, old_mem);
+        if (cur_node == NULL) {
+            CY_PANIC("stack allocator: out-of-bounds reallocation");
+            break;
+        }
+
+        CyStackHeader *header = (CyStackHeader*)old_mem - 1;
+        b32 is_popped = (u8*)old_mem >= cur_node->buf + cur_node->offset;
+        if (is_popped || header->freed) {
+            CY_PANIC("stack allocator: reallocation of freed memory");
+            break;
+        }
+        if (header->node != cur_node) {
+            CY_PANIC("stack allocator: invalid pointer");
+            break;
+        }
+
+        b32 is_aligned = CY__IS_ALIGNED(old_mem, align);
+        b32 is_top = (old_mem == state->top);
+        if (is_aligned && (is_top || size <= header->size)) {
+            isize offset = (u8*)old_mem - cur_node->buf;
+            isize new_offset = offset + size;
+            if (!is_top) {
+                return old_mem; // NOTE(cya): shrinking in place
+            } else if (new_offset <= cur_node->size) {
+                state->stats.used += new_offset - cur_node->offset;
+                cy__stack_update_peaks(&state->stats);
+
+                cur_node->offset = new_offset;
+                header->size = size;
+                return old_mem;
+            }
+
+            // NOTE(cya): top allocation crossing the node boundary, so it
+            // moves to a new node and its old space is released right away
+            CyStackHeader old_header = *header;
+            CyStackNode *new_node = cy__stack_grow(stack, size, align);
+            CY_VALIDATE_PTR(new_node);
+
+            isize padding = cy_calc_header_padding(
+                (uintptr)new_node->buf, align, cy_sizeof(*header)
+            );
+            ptr = new_node->buf + padding;
+            cy_mem_copy(ptr, old_mem, CY_MIN(old_size, size));
+
+            header = (CyStackHeader*)ptr - 1;
+            *header = (CyStackHeader){
+                .node = new_node,
+                .prev = old_header.prev,
+                .prev_offset = 0,
+                .size = size,
+            };
+
+            new_node->offset = padding + size;
+            state->top = ptr;
+            state->stats.used += (padding + size) -
+                (cur_node->offset - old_header.prev_offset);
+
+            cur_node->offset = old_header.prev_offset;
+            if (cur_node->offset == 0 && cur_node->next != NULL) {
+                cy__stack_release_node(stack, &new_node->next);
+            }
+
+            cy__stack_update_peaks(&state->stats);
+            break;
+        }
+
+        // NOTE(cya): not on top (or needs a different alignment), so this
+        // becomes a new allocation and the old one gets freed (lazily if
+        // it's out of order)
+        ptr = cy_alloc_align(a, size, align);
+        CY_VALIDATE_PTR(ptr);
+
+        cy_mem_copy(ptr, old_mem, CY_MIN(old_size, size));
+        cy_free(a, old_mem);
+    } break;
+    }
+
+    return ptr;
+}
+
+/* ----------------------------- Pool Allocator ----------------------------- */
+cy_inline CyAllocator cy_pool_allocator(CyPool *pool)
+{
+    return (CyAllocator){
+        .proc = cy_pool_allocator_proc,
+        .data = pool,
+    };
+}
+
+
+cy_inline CyPool cy_pool_init(CyAllocator backing, isize chunks, isize chunk_size)
+{
+    return cy_pool_init_align(
+        backing, chunks, chunk_size, CY_DEFAULT_ALIGNMENT
+    );
+}
+
+cy_inline CyPool cy_pool_init_align(
+    CyAllocator backing, isize chunks, isize chunk_size, isize chunk_align
+) {
+    CyPool pool = {0};
+    if (chunk_size < cy_sizeof(uintptr)) {
+        CY_PANIC("pool allocator: chunk size is too small");
+        return pool;
+    }
+
+    isize chunk_size_total = chunk_size + chunk_align;
+    isize buf_size = chunks * chunk_size_total;
+    void *buf = cy_alloc_align(backing, buf_size, chunk_align);
+    if (buf == NULL) {
+        buf_size = 0;
+        chunk_size = 0;
+    }
+
+    pool = (CyPool){
+        .backing = backing,
+        .memory = buf,
+        .free_list_head = buf,
+        .chunks = chunks,
+        .chunk_size = chunk_size,
+        .chunk_align = chunk_align,
+    };
+    CyAllocator a = cy_pool_allocator(&pool);
+    cy_free_all(a);
+
+    return pool;
+}
+
+cy_inline void cy_pool_deinit(CyPool *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    cy_free(pool->backing, pool->memory);
+    cy_mem_set(pool, 0, cy_sizeof(*pool));
+}
+
+CY_ALLOCATOR_PROC(cy_pool_allocator_proc)
+{
+    CY_UNUSED(old_size);
+
+    CyPool *pool = allocator_data;
+    void *ptr = NULL;
+    switch (type) {
+    case CY_ALLOCATION_ALLOC: {
+        CY_ASSERT(size == pool->chunk_size);
+        CY_ASSERT(align == pool->chunk_align);
+        if (pool->free_list_head == NULL) {
+            CY_PANIC("pool allocator: out of memory");
+            break;
+        }
+
+        ptr = pool->free_list_head;
+
+        uintptr *next_free = (uintptr*)pool->free_list_head;
+        pool->free_list_head = (void*)*next_free;
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            cy_mem_zero(ptr, size);
+        }
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        CY_ASSERT(size <= pool->chunk_size);
+        CY_ASSERT(align <= pool->chunk_align);
+
+        void **ptrs = old_mem;
+        isize count = old_size;
+        void *head = pool->free_list_head;
+        for (isize i = 0; i < count; i++) {
+            if (head == NULL) {
+                return NULL; // NOTE(cya): free list left untouched
+            }
+
+            ptrs[i] = head;
+            head = (void*)*(uintptr*)head;
+        }
+
+        pool->free_list_head = head;
+        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
+            for (isize i = 0; i < count; i++) {
+                cy_mem_zero(ptrs[i], pool->chunk_size);
+            }
+        }
+
+        ptr = ptrs;
+    } break;
+    case CY_ALLOCATION_FREE: {
+        if (old_mem == NULL) {
+            break;
+        }
+
+        isize chunk_size_total = pool->chunk_size + pool->chunk_align;
+        isize pool_size = pool->chunks * chunk_size_total;
+        void *pool_end = (void*)((uintptr)pool->memory + (uintptr)pool_size);
+        if (old_mem < pool->memory || old_mem > pool_end) {
+            CY_PANIC("pool allocator: out-of-bounds free");
+            break;
+        }
+
+        uintptr *next_free = (uintptr*)old_mem;
+        *next_free = (uintptr)pool->free_list_head;
+        pool->free_list_head = (void*)next_free;
+    } break;
+    case CY_ALLOCATION_FREE_ALL: {
+        isize chunk_size_total = pool->chunk_size + pool->chunk_align;
+        void *cur_chunk = pool->memory;
+        for (isize i = 0; i < pool->chunks - 1; i++) {
+            uintptr *next = (uintptr*)cur_chunk;
+            *next = (uintptr)cur_chunk + (uintptr)chunk_size_total;
+            cur_chunk = (void*)(*next);
+        }
+
+        uintptr *end = (uintptr*)cur_chunk;
+        *end = (uintptr)NULL; // NOTE(cya): free list tail
+        pool->free_list_head = pool->memory;
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL:
+    case CY_ALLOCATION_RESIZE: {
+        CY_PANIC("pool allocator: unsupported operation");
+    } break;
+    }
+
+    return ptr;
+}
+
+/* --------------------------- Tracking Allocator --------------------------- */
+typedef struct {
+    isize size;
+    i32 site;
+    i32 padding;
+} CyPrivTrackHeader;
+
+typedef struct {
+    const char *file;
+    i32 line;
+} CyPrivAllocSiteLoc;
+
+cy_global cy_thread_local CyPrivAllocSiteLoc cy__alloc_site;
+
+cy_inline void cy__alloc_site_set(const char *file, i32 line)
+{
+    cy__alloc_site = (CyPrivAllocSiteLoc){
+        .file = file,
+        .line = line,
+    };
+}
+
+cy_inline CyAllocator cy_alloc_tracker_allocator(CyAllocTracker *tracker)
+{
+    return (CyAllocator){
+        .proc = cy_alloc_tracker_allocator_proc,
+        .data = tracker,
+    };
+}
+
+cy_inline CyAllocTracker cy_alloc_tracker_init(CyAllocator backing)
+{
+    isize site_count = CY_ALLOC_TRACKER_MAX_SITES + 1;
+    CyAllocTracker tracker = {
+        .backing = backing,
+        .sites = (cy_alloc)(
+            cy_heap_allocator(), site_count * cy_sizeof(CyAllocSite)
+        ),
+    };
+    if (tracker.sites == NULL) {
+        CY_PANIC("tracking allocator: unable to allocate site table");
+    }
+
+    return tracker;
+}
+
+cy_inline void cy_alloc_tracker_deinit(CyAllocTracker *tracker)
+{
+    if (tracker == NULL) {
+        return;
+    }
+
+    cy_free(cy_heap_allocator(), tracker->sites);
+    cy_mem_set(tracker, 0, cy_sizeof(*tracker));
+}
+
+// NOTE(cya): consumes the call site captured for the current allocation
+cy_internal i32 cy__alloc_tracker_site_index(CyAllocTracker *tracker)
+{
+    CyPrivAllocSiteLoc loc = cy__alloc_site;
+    cy__alloc_site = (CyPrivAllocSiteLoc){0};
+    if (loc.file == NULL) {
+        loc.file = "<unknown>";
+    }
+
+    const isize mask = CY_ALLOC_TRACKER_MAX_SITES - 1;
+    uintptr hash = ((uintptr)loc.file >> 3) ^ ((uintptr)loc.line * 0x9E3779B1U);
+    isize idx = (isize)(hash & (uintptr)mask);
+    for (isize probe = 0; probe <= mask; probe++) {
+        CyAllocSite *site = &tracker->sites[idx];
+        if (site->file == NULL) {
+            site->file = loc.file;
+            site->line = loc.line;
+            return (i32)idx;
+        } else if (site->file == loc.file && site->line == loc.line) {
+            return (i32)idx;
+        }
+
+        idx = (idx + 1) & mask;
+    }
+
+    CyAllocSite *overflow = &tracker->sites[CY_ALLOC_TRACKER_MAX_SITES];
+    overflow->file = "<other>";
+    return CY_ALLOC_TRACKER_MAX_SITES;
+}
+
+cy_internal void cy__alloc_tracker_add(
+    CyAllocTracker *tracker, i32 site_idx, isize bytes
+) {
+    CyAllocSite *site = &tracker->sites[site_idx];
+    site->bytes_in_flight += bytes;
+    site->peak_bytes = CY_MAX(site->peak_bytes, site->bytes_in_flight);
+    tracker->bytes_in_flight += bytes;
+    tracker->peak_bytes = CY_MAX(tracker->peak_bytes, tracker->bytes_in_flight);
+    if (bytes > 0) {
+        site->bytes_total += bytes;
+        tracker->bytes_total += bytes;
+    }
+}
+
+cy_internal cy_inline isize cy__alloc_tracker_padding(isize align)
+{
+    return cy_align_forward_size(cy_sizeof(CyPrivTrackHeader), align);
+}
+
+CY_ALLOCATOR_PROC(cy_alloc_tracker_allocator_proc)
+{
+    CyAllocTracker *tracker = allocator_data;
+    CyAllocator backing = tracker->backing;
+    isize header_align = cy_sizeof(isize);
+    align = CY_MAX(align, header_align);
+
+    void *ptr = NULL;
+    switch (type) {
+    case CY_ALLOCATION_ALLOC: {
+        i32 site_idx = cy__alloc_tracker_site_index(tracker);
+        isize padding = cy__alloc_tracker_padding(align);
+        u8 *base = backing.proc(
+            backing.data, CY_ALLOCATION_ALLOC,
+            padding + size, align,
+            NULL, 0,
+            flags
+        );
+        CY_VALIDATE_PTR(base);
+
+        ptr = base + padding;
+        CyPrivTrackHeader *header = (CyPrivTrackHeader*)ptr - 1;
+        *header = (CyPrivTrackHeader){
+            .size = size,
+            .site = site_idx,
+            .padding = (i32)padding,
+        };
+
+        tracker->alloc_count += 1;
+        tracker->sites[site_idx].allocs += 1;
+        cy__alloc_tracker_add(tracker, site_idx, size);
+    } break;
+    case CY_ALLOCATION_ALLOC_BATCH: {
+        CyPrivAllocSiteLoc loc = cy__alloc_site;
+        void **ptrs = old_mem;
+        for (isize i = 0; i < old_size; i++) {
+            cy__alloc_site = loc;
+            ptrs[i] = cy_alloc_tracker_allocator_proc(
+                allocator_data, CY_ALLOCATION_ALLOC,
+                size, align,
+                NULL, 0,
+                flags
+            );
+            if (ptrs[i] == NULL) {
+                while (i-- > 0) {
+                    cy_free(cy_alloc_tracker_allocator(tracker), ptrs[i]);
+                }
+
+                return NULL;
+            }
+        }
+
+        ptr = ptrs;
+    } break;
+    case CY_ALLOCATION_FREE: {
+        CY_VALIDATE_PTR(old_mem);
+
+        CyPrivTrackHeader *header = (CyPrivTrackHeader*)old_mem - 1;
+        tracker->free_count += 1;
+        cy__alloc_tracker_add(tracker, header->site, -header->size);
+
+        cy_free(backing, (u8*)old_mem - header->padding);
+    } break;
+    case CY_ALLOCATION_RESIZE: {
+        // NOTE(cya): calling the procs in parentheses from here on so the
+        // call site captured by the caller doesn't get overwritten
+        CyAllocator a = cy_alloc_tracker_allocator(tracker);
+        if (old_mem == NULL) {
+            return (cy_alloc_align)(a, size, align);
+        } else if (size == 0) {
+            cy_free(a, old_mem);
+            break;
+        }
+
+        CyPrivTrackHeader *header = (CyPrivTrackHeader*)old_mem - 1;
+        CyPrivTrackHeader old_header = *header;
+        isize padding = cy__alloc_tracker_padding(align);
+        if (padding != old_header.padding) {
+            ptr = (cy_alloc_align)(a, size, align);
+            CY_VALIDATE_PTR(ptr);
+
+            cy_mem_copy(ptr, old_mem, CY_MIN(old_header.size, size));
+            cy_free(a, old_mem);
+            break;
+        }
+
+        // NOTE(cya): resizes get attributed to the site resizing
+        i32 site_idx = cy__alloc_tracker_site_index(tracker);
+        u8 *base = (cy_resize_align)(
+            backing, (u8*)old_mem - padding,
+            padding + old_header.size, padding + size, align
+        );
+        CY_VALIDATE_PTR(base);
+
+        ptr = base + padding;
+        header = (CyPrivTrackHeader*)ptr - 1;
+        *header = (CyPrivTrackHeader){
+            .size = size,
+            .site = site_idx,
+            .padding = (i32)padding,
+        };
+
+        tracker->resize_count += 1;
+        tracker->sites[site_idx].resizes += 1;
+        cy__alloc_tracker_add(tracker, old_header.site, -old_header.size);
+        cy__alloc_tracker_add(tracker, site_idx, size);
+    } break;
+    case CY_ALLOCATION_FREE_ALL: {
+        cy_free_all(backing); // NOTE(cya): the site table isn't in there
+
+        tracker->bytes_in_flight = 0;
+        for (isize i = 0; i <= CY_ALLOC_TRACKER_MAX_SITES; i++) {
+            tracker->sites[i].bytes_in_flight = 0;
+        }
+    } break;
+    case CY_ALLOCATION_ALLOC_ALL: {
+        // NOTE(cya): passed through untracked
+        ptr = backing.proc(
+            backing.data, type, size, align, old_mem, old_size, flags
+        );
+    } break;
+    }
+
+    return ptr;
+}
+
+void cy_alloc_tracker_report(const CyAllocTracker *tracker)
+{
+    CyAllocator heap = cy_heap_allocator();
+    isize site_cap = CY_ALLOC_TRACKER_MAX_SITES + 1;
+    const CyAllocSite **sorted = (cy_alloc)(
+        heap, site_cap * cy_sizeof(const CyAllocSite*)
+    );
+    if (sorted == NULL) {
+        return;
+    }
+
+    // NOTE(cya): insertion sort by bytes in flight (then total bytes)
+    isize count = 0;
+    for (isize i = 0; i < site_cap; i++) {
+        const CyAllocSite *site = &tracker->sites[i];
+        if (site->file == NULL) {
+            continue;
+        }
+
+        isize j = count++;
+        for (; j > 0; j--) {
+            const CyAllocSite *other = sorted[j - 1];
+            b32 is_greater = site->bytes_in_flight > other->bytes_in_flight ||
+                (site->bytes_in_flight == other->bytes_in_flight &&
+                    site->bytes_total > other->bytes_total);
+            if (!is_greater) {
+                break;
+            }
+
+            sorted[j] = other;
+        }
+
+        sorted[j] = site;
+    }
+
+    cy_printf(
+        "allocations: %td, frees: %td, resizes: %td\n"
+        "bytes in flight: %td (peak: %td, total: %td)\n",
+        tracker->alloc_count, tracker->free_count, tracker->resize_count,
+        tracker->bytes_in_flight, tracker->peak_bytes, tracker->bytes_total
+    );
+    cy_printf(
+        "%14s %14s %14s %10s %10s  %s\n",
+        "in flight", "peak", "total", "allocs", "resizes", "site"
+    );
+    for (isize i = 0; i < count; i++) {
+        const CyAllocSite *site = sorted[i];
+        cy_printf(
+            "%14td %14td %14td %10td %10td  %s:%d\n",
+            site->bytes_in_flight, site->peak_bytes, site->bytes_total,
+            site->allocs, site->resizes, site->file, site->line
+        );
+    }
+
+    cy_free(heap, (void*)sorted);
+}
+
+/* ============================== Char procs =============================== */
+const char *cy_char_first_occurence(const char *str, char c)
+{
+    for (; *str != c; str++) {
+        if (*str == '\0')  {
+            return NULL;
+        }
+    }
+
+    return str;
+}
+
+const char *cy_char_last_occurence(const char *str, char c)
+{
+    const char *res = NULL;
+    do {
+        if (*str == c) {
+            res = str;
+        }
+    } while (*str++ != '\0');
 
-/* =============================== Allocators =============================== */
-cy_inline void *cy_alloc_align(CyAllocator a, isize size, isize align)
+    return res;
+}
+
+cy_inline b32 cy_char_is_digit(char c)
 {
-    return a.proc(
-        a.data, CY_ALLOCATION_ALLOC,
-        size, align,
-        NULL, 0,
-        CY_DEFAULT_ALLOCATOR_FLAGS
-    );
+    return (u8)(c - '0') < 10;
+}
+
+cy_inline b32 cy_char_is_hex_digit(char c)
+{
+    return cy_char_is_digit(c) ||
+        CY_IS_IN_RANGE_INCL(c, 'a', 'f') ||
+        CY_IS_IN_RANGE_INCL(c, 'A', 'F');
 }
 
-cy_inline void *cy_alloc(CyAllocator a, isize size)
+cy_inline b32 cy_char_is_lower(char c)
 {
-    return cy_alloc_align(a, size, CY_DEFAULT_ALIGNMENT);
+    return CY_IS_IN_RANGE_INCL(c, 'a', 'z');
 }
 
-cy_inline void cy_free(CyAllocator a, void *ptr)
+cy_inline b32 cy_char_is_upper(char c)
 {
-    if (ptr != NULL) {
-        a.proc(
-            a.data, CY_ALLOCATION_FREE,
-            0, 0,
-            ptr, 0,
-            CY_DEFAULT_ALLOCATOR_FLAGS
-        );
+    return c - 0x41 < 26;
+}
+
+cy_inline b32 cy_char_is_in_set(char c, const char *cut_set)
+{
+    while (*cut_set != '\0') {
+        if (c == *cut_set++) {
+            return true;
+        }
     }
+
+    return false;
 }
 
-cy_inline void cy_free_all(CyAllocator a)
+cy_inline CyCharSet cy_char_set_create(const char *chars)
 {
-    a.proc(
-        a.data, CY_ALLOCATION_FREE_ALL,
-        0, 0,
-        NULL, 0,
-        CY_DEFAULT_ALLOCATOR_FLAGS
-    );
+    return cy_char_set_create_len(chars, -1);
 }
 
-cy_inline void *cy_resize_align(
-    CyAllocator a, void *ptr, isize old_size, isize new_size, isize align
-) {
-    return a.proc(
-        a.data, CY_ALLOCATION_RESIZE,
-        new_size, align,
-        ptr, old_size,
-        CY_DEFAULT_ALLOCATOR_FLAGS
-    );
+CyCharSet cy_char_set_create_len(const char *chars, isize len)
+{
+    if (len < 0) {
+        len = cy_str_len(chars);
+    }
+
+    CyCharSet set = {0};
+    for (isize i = 0; i < len; i++) {
+        cy_char_set_add(&set, (u8)chars[i]);
+    }
+
+    return set;
+}
+
+void cy_char_set_add(CyCharSet *set, u8 c)
+{
+    if (cy_char_set_has(set, c)) {
+        return;
+    }
+
+    set->bits[c >> 6] |= (u64)1 << (c & 63);
+
+    // NOTE(cya): row = low nibble, bit = high nibble (one table per half)
+    u8 hi = c >> 4;
+    set->nibbles[hi >> 3][c & 0xF] |= (u8)(1 << (hi & 7));
+
+    if (set->char_count < cy_sizeof(set->chars)) {
+        set->chars[set->char_count] = c;
+    }
+
+    set->char_count += 1;
 }
 
-cy_inline void *cy_resize(CyAllocator a, void *ptr, isize old_size, isize new_size)
+cy_inline b32 cy_char_set_has(const CyCharSet *set, u8 c)
 {
-    return cy_resize_align(a, ptr, old_size, new_size, CY_DEFAULT_ALIGNMENT);
+    return (set->bits[c >> 6] >> (c & 63)) & 1;
 }
 
-cy_inline void *cy_default_resize_align(
-    CyAllocator a, void *old_mem, isize old_size, isize new_size, isize align
-) {
-    if (old_mem == NULL) {
-        return cy_alloc_align(a, new_size, align);
+cy_inline char cy_char_to_lower(char c) {
+    return cy_char_is_upper(c) ? c + ('a' - 'A') : c;
+}
+
+cy_inline char cy_char_to_upper(char c) {
+    return cy_char_is_lower(c) ? c - ('a' - 'A') : c;
+}
+
+cy_inline i64 cy_digit_to_i64(char digit)
+{
+    return cy_char_is_digit(digit) ? digit - '0' : digit - 'W';
+}
+
+cy_inline i64 cy_hex_digit_to_i64(char digit)
+{
+    if (cy_char_is_digit(digit)) {
+        return digit - '0';
+    } else if (CY_IS_IN_RANGE_INCL(digit, 'a', 'f')) {
+        return 10 + digit - 'a';
+    } else if (CY_IS_IN_RANGE_INCL(digit, 'A', 'F')) {
+        return 10 + digit - 'A';
     }
-    if (new_size == 0) {
-        cy_free(a, old_mem);
-        return NULL;
+
+    return -1;
+}
+
+/* ============================ C-String procs ============================== */
+/*
+ * SIMD scans for the C-string procs: loads past the end of a string are always
+ * aligned to the vector size (or checked against the page size), so they never
+ * touch a page the string isn't in. AVX2 gets picked at runtime when the CPU
+ * has it, and targets without SSE2 use the word-at-a-time versions
+ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CY__SIMD_SSE2 1
+    #include <emmintrin.h>
+
+    #if !defined(CY_NO_AVX2)
+        #define CY__SIMD_AVX2 1
+        #include <immintrin.h>
+    #endif
+#endif
+
+#if defined(CY_COMPILER_MSVC)
+    #include <intrin.h>
+
+    #define CY__TARGET_AVX2
+    #define CY__NO_SANITIZE_ADDRESS
+#else
+    #define CY__TARGET_AVX2 __attribute__((target("avx2")))
+    #define CY__NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+
+#define CY__PAGE_SIZE 4096
+
+// NOTE(cya): whether a `size`-byte load at p stays inside p's page
+#define CY__LOAD_FITS_PAGE(p, size) \
+    (((uintptr)(p) & (CY__PAGE_SIZE - 1)) <= CY__PAGE_SIZE - (size))
+
+// NOTE(cya): index of the lowest set bit (n can't be 0)
+cy_internal cy_inline isize cy__u32_trailing_zeros(u32 n)
+{
+#if defined(CY_COMPILER_MSVC)
+    unsigned long idx;
+    _BitScanForward(&idx, n);
+    return (isize)idx;
+#else
+    return __builtin_ctz(n);
+#endif
+}
+
+cy_internal cy_inline isize cy__u64_trailing_zeros(u64 n)
+{
+#if defined(CY_COMPILER_MSVC) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, n);
+    return (isize)idx;
+#elif defined(CY_COMPILER_MSVC)
+    u32 lo = (u32)n;
+    u32 hi = (u32)(n >> 32);
+    return (lo != 0) ?
+        cy__u32_trailing_zeros(lo) : 32 + cy__u32_trailing_zeros(hi);
+#else
+    return __builtin_ctzll(n);
+#endif
+}
+
+#if defined(CY__SIMD_AVX2)
+// NOTE(cya): 0 until detected, then 1 + whether the CPU has it (threads
+// racing to detect it just store the same value)
+cy_global volatile u32 cy__cpu_avx2;
+
+cy_internal b32 cy__cpu_has_avx2(void)
+{
+    u32 cached = cy__atomic_load_u32_acquire(&cy__cpu_avx2);
+    if (cached == 0) {
+    #if defined(CY_COMPILER_MSVC)
+        int info[4];
+        __cpuid(info, 0);
+        b32 has_avx2 = false;
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            b32 os_saves_ymm = (info[2] & CY_BIT(27)) && (info[2] & CY_BIT(28))
+                && (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(info, 7, 0);
+            has_avx2 = os_saves_ymm && (info[1] & CY_BIT(5));
+        }
+    #else
+        __builtin_cpu_init();
+        b32 has_avx2 = __builtin_cpu_supports("avx2");
+    #endif
+
+        cached = 1 + (has_avx2 != 0);
+        cy__atomic_store_u32_release(&cy__cpu_avx2, cached);
     }
-    if (new_size <= old_size) {
-        return old_mem;
+
+    return cached - 1;
+}
+#endif
+
+#if defined(CY__SIMD_SSE2)
+cy_internal cy_inline u32 cy__sse2_zero_mask(__m128i v)
+{
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+}
+
+CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_len_sse2(const char *str)
+{
+    // NOTE(cya): the bytes before str in the first block are shifted out
+    isize ofs = (isize)((uintptr)str & 15);
+    const __m128i *p = (const __m128i*)(str - ofs);
+    u32 mask = cy__sse2_zero_mask(_mm_load_si128(p)) >> ofs;
+    if (mask != 0) {
+        return cy__u32_trailing_zeros(mask);
     }
 
-    void *new_mem = cy_alloc_align(a, new_size, align);
-    if (new_mem == NULL) {
-        return NULL;
+    for (;;) {
+        mask = cy__sse2_zero_mask(_mm_load_si128(++p));
+        if (mask != 0) {
+            return (const char*)p - str + cy__u32_trailing_zeros(mask);
+        }
     }
+}
 
-    cy_mem_move(new_mem, old_mem, old_size);
-    cy_free(a, old_mem);
-    return new_mem;
+CY__NO_SANITIZE_ADDRESS
+cy_internal char *cy__str_copy_sse2(char *dst, const char *src)
+{
+    // NOTE(cya): same first block as in cy_str_len, the rest is aligned
+    isize ofs = (isize)((uintptr)src & 15);
+    const char *block = src - ofs;
+    __m128i v = _mm_load_si128((const __m128i*)block);
+    u32 mask = cy__sse2_zero_mask(v) >> ofs;
+    if (mask != 0) {
+        isize len = cy__u32_trailing_zeros(mask);
+        cy_mem_copy(dst, src, len + 1);
+        return dst + len;
+    }
+
+    cy_mem_copy(dst, src, 16 - ofs);
+    dst += 16 - ofs, src = block + 16;
+    for (;; dst += 16, src += 16) {
+        v = _mm_load_si128((const __m128i*)src);
+        mask = cy__sse2_zero_mask(v);
+        if (mask != 0) {
+            isize len = cy__u32_trailing_zeros(mask);
+            cy_mem_copy(dst, src, len + 1);
+            return dst + len;
+        }
+
+        _mm_storeu_si128((__m128i*)dst, v);
+    }
 }
 
-cy_inline void *cy_default_resize(
-    CyAllocator a, void *old_mem, isize old_size, isize new_size
+CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_compare_sse2(const char *a, const char *b)
+{
+    for (;;) {
+        if (!CY__LOAD_FITS_PAGE(a, 16) || !CY__LOAD_FITS_PAGE(b, 16)) {
+            if (*a != *b || *a == '\0') {
+                return *(const u8*)a - *(const u8*)b;
+            }
+
+            a += 1, b += 1;
+            continue;
+        }
+
+        __m128i va = _mm_loadu_si128((const __m128i*)a);
+        __m128i vb = _mm_loadu_si128((const __m128i*)b);
+        u32 diff = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFF;
+        u32 mask = diff | cy__sse2_zero_mask(va);
+        if (mask != 0) {
+            isize i = cy__u32_trailing_zeros(mask);
+            return ((const u8*)a)[i] - ((const u8*)b)[i];
+        }
+
+        a += 16, b += 16;
+    }
+}
+
+CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_compare_n_sse2(
+    const char *a, const char *b, isize len
 ) {
-    return cy_default_resize_align(
-        a, old_mem,
-        old_size, new_size,
-        CY_DEFAULT_ALIGNMENT
+    // NOTE(cya): the strings may end right after the first difference, so
+    // blocks that would cross into the next page go byte by byte
+    while (len >= 16) {
+        if (!CY__LOAD_FITS_PAGE(a, 16) || !CY__LOAD_FITS_PAGE(b, 16)) {
+            if (*a != *b) {
+                return *(const u8*)a - *(const u8*)b;
+            }
+
+            a += 1, b += 1, len -= 1;
+            continue;
+        }
+
+        __m128i va = _mm_loadu_si128((const __m128i*)a);
+        __m128i vb = _mm_loadu_si128((const __m128i*)b);
+        u32 diff = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFF;
+        if (diff != 0) {
+            isize i = cy__u32_trailing_zeros(diff);
+            return ((const u8*)a)[i] - ((const u8*)b)[i];
+        }
+
+        a += 16, b += 16, len -= 16;
+    }
+
+    for (; len > 0; a++, b++, len--) {
+        if (*a != *b) {
+            return *(const u8*)a - *(const u8*)b;
+        }
+    }
+
+    return 0;
+}
+// NOTE(cya): one bit per byte of every zero wchar_t lane (16 or 32 bits)
+cy_internal cy_inline u32 cy__sse2_zero_wchar_mask(__m128i v)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i eq = (sizeof(wchar_t) == 2) ?
+        _mm_cmpeq_epi16(v, zero) : _mm_cmpeq_epi32(v, zero);
+    return (u32)_mm_movemask_epi8(eq);
+}
+
+CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__wcs_len_sse2(const wchar_t *str)
+{
+    isize ofs = (isize)((uintptr)str & 15);
+    const __m128i *p = (const __m128i*)((const char*)str - ofs);
+    u32 mask = cy__sse2_zero_wchar_mask(_mm_load_si128(p)) >> ofs;
+    if (mask != 0) {
+        return cy__u32_trailing_zeros(mask) / cy_sizeof(wchar_t);
+    }
+
+    for (;;) {
+        mask = cy__sse2_zero_wchar_mask(_mm_load_si128(++p));
+        if (mask != 0) {
+            isize bytes = (const char*)p - (const char*)str;
+            return (bytes + cy__u32_trailing_zeros(mask)) / cy_sizeof(wchar_t);
+        }
+    }
+}
+#endif
+
+#if defined(CY__SIMD_AVX2)
+CY__TARGET_AVX2
+cy_internal cy_inline u32 cy__avx2_zero_mask(__m256i v)
+{
+    return (u32)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(v, _mm256_setzero_si256())
     );
 }
 
-cy_inline void *cy_alloc_copy_align(
-    CyAllocator a, const void *src, isize size, isize align
-) {
-    return cy_mem_copy(cy_alloc_align(a, size, align), src, size);
+CY__TARGET_AVX2 CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_len_avx2(const char *str)
+{
+    isize ofs = (isize)((uintptr)str & 31);
+    const __m256i *p = (const __m256i*)(str - ofs);
+    u32 mask = cy__avx2_zero_mask(_mm256_load_si256(p)) >> ofs;
+    if (mask != 0) {
+        return cy__u32_trailing_zeros(mask);
+    }
+
+    for (;;) {
+        mask = cy__avx2_zero_mask(_mm256_load_si256(++p));
+        if (mask != 0) {
+            return (const char*)p - str + cy__u32_trailing_zeros(mask);
+        }
+    }
 }
 
-cy_inline void *cy_alloc_copy(CyAllocator a, const void *src, isize size)
+CY__TARGET_AVX2 CY__NO_SANITIZE_ADDRESS
+cy_internal char *cy__str_copy_avx2(char *dst, const char *src)
 {
-    return cy_alloc_copy_align(a, src, size, CY_DEFAULT_ALIGNMENT);
+    // NOTE(cya): same first block as in cy_str_len, the rest is aligned
+    isize ofs = (isize)((uintptr)src & 31);
+    const char *block = src - ofs;
+    __m256i v = _mm256_load_si256((const __m256i*)block);
+    u32 mask = cy__avx2_zero_mask(v) >> ofs;
+    if (mask != 0) {
+        isize len = cy__u32_trailing_zeros(mask);
+        cy_mem_copy(dst, src, len + 1);
+        return dst + len;
+    }
+
+    cy_mem_copy(dst, src, 32 - ofs);
+    dst += 32 - ofs, src = block + 32;
+    for (;; dst += 32, src += 32) {
+        v = _mm256_load_si256((const __m256i*)src);
+        mask = cy__avx2_zero_mask(v);
+        if (mask != 0) {
+            isize len = cy__u32_trailing_zeros(mask);
+            cy_mem_copy(dst, src, len + 1);
+            return dst + len;
+        }
+
+        _mm256_storeu_si256((__m256i*)dst, v);
+    }
 }
 
-cy_inline char *cy_alloc_string_len(CyAllocator a, const char *str, isize len)
+CY__TARGET_AVX2 CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_compare_avx2(const char *a, const char *b)
 {
-    char *res = cy_alloc_copy(a, str, len);
-    res[len] = '\0';
-    return res;
+    for (;;) {
+        if (!CY__LOAD_FITS_PAGE(a, 32) || !CY__LOAD_FITS_PAGE(b, 32)) {
+            if (*a != *b || *a == '\0') {
+                return *(const u8*)a - *(const u8*)b;
+            }
+
+            a += 1, b += 1;
+            continue;
+        }
+
+        __m256i va = _mm256_loadu_si256((const __m256i*)a);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+        u32 diff = ~(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        u32 mask = diff | cy__avx2_zero_mask(va);
+        if (mask != 0) {
+            isize i = cy__u32_trailing_zeros(mask);
+            return ((const u8*)a)[i] - ((const u8*)b)[i];
+        }
+
+        a += 32, b += 32;
+    }
+}
+
+CY__TARGET_AVX2 CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__str_compare_n_avx2(
+    const char *a, const char *b, isize len
+) {
+    while (len >= 32) {
+        if (!CY__LOAD_FITS_PAGE(a, 32) || !CY__LOAD_FITS_PAGE(b, 32)) {
+            if (*a != *b) {
+                return *(const u8*)a - *(const u8*)b;
+            }
+
+            a += 1, b += 1, len -= 1;
+            continue;
+        }
+
+        __m256i va = _mm256_loadu_si256((const __m256i*)a);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+        u32 diff = ~(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if (diff != 0) {
+            isize i = cy__u32_trailing_zeros(diff);
+            return ((const u8*)a)[i] - ((const u8*)b)[i];
+        }
+
+        a += 32, b += 32, len -= 32;
+    }
+
+    return cy__str_compare_n_sse2(a, b, len);
+}
+CY__TARGET_AVX2
+cy_internal cy_inline u32 cy__avx2_zero_wchar_mask(__m256i v)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i eq = (sizeof(wchar_t) == 2) ?
+        _mm256_cmpeq_epi16(v, zero) : _mm256_cmpeq_epi32(v, zero);
+    return (u32)_mm256_movemask_epi8(eq);
+}
+
+CY__TARGET_AVX2 CY__NO_SANITIZE_ADDRESS
+cy_internal isize cy__wcs_len_avx2(const wchar_t *str)
+{
+    isize ofs = (isize)((uintptr)str & 31);
+    const __m256i *p = (const __m256i*)((const char*)str - ofs);
+    u32 mask = cy__avx2_zero_wchar_mask(_mm256_load_si256(p)) >> ofs;
+    if (mask != 0) {
+        return cy__u32_trailing_zeros(mask) / cy_sizeof(wchar_t);
+    }
+
+    for (;;) {
+        mask = cy__avx2_zero_wchar_mask(_mm256_load_si256(++p));
+        if (mask != 0) {
+            isize bytes = (const char*)p - (const char*)str;
+            return (bytes + cy__u32_trailing_zeros(mask)) / cy_sizeof(wchar_t);
+        }
+    }
 }
+#endif
 
-cy_inline char *cy_alloc_string(CyAllocator a, const char *str)
+CY__NO_SANITIZE_ADDRESS
+cy_inline isize cy_str_len(const char *str)
 {
-    return cy_alloc_string_len(a, str, cy_str_len(str));
-}
+    if (str == NULL) {
+        return 0;
+    }
 
-cy_inline CyAllocator cy_null_allocator(void)
-{
-    return (CyAllocator){
-        .proc = cy_null_allocator_proc,
-    };
-}
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__str_len_avx2(str);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_len_sse2(str);
+#else
+    const char *begin = str;
+    while (!CY__IS_WORD_ALIGNED(str)) {
+        if (*str == '\0') {
+            return str - begin;
+        }
 
-CY_ALLOCATOR_PROC(cy_null_allocator_proc)
-{
-    CY_UNUSED(allocator_data);
-    CY_UNUSED(size);
-    CY_UNUSED(align);
-    CY_UNUSED(old_size);
-    CY_UNUSED(flags);
+        str += 1;
+    }
 
-    void *ptr = NULL;
-    switch(type) {
-    case CY_ALLOCATION_FREE: {
-        CY_ASSERT_MSG(old_mem == NULL, "null allocator: invalid pointer");
-    } break;
-    default: break;
+    const isize *w = (const isize*)str;
+    while (!CY__HAS_ZERO_BYTE(*w)) {
+        w += 1;
     }
 
-    return ptr;
+    str = (const char*)w;
+    while (*str != '\0') {
+        str += 1;
+    }
+
+    return str - begin;
+#endif
 }
 
-cy_inline CyAllocator cy_heap_allocator(void)
+CY__NO_SANITIZE_ADDRESS
+cy_inline isize cy_wcs_len(const wchar_t *str)
 {
-    return (CyAllocator){
-        .proc = cy_heap_allocator_proc,
-    };
-}
+    if (str == NULL) {
+        return 0;
+    }
 
-#if defined(CY_OS_WINDOWS)
-    #include <malloc.h>
+    const wchar_t *begin = str;
+    if (!CY__IS_ALIGNED(str, cy_sizeof(wchar_t))) {
+        // NOTE(cya): lanes would straddle the blocks, so no shortcuts here
+        while (*str != 0) {
+            str += 1;
+        }
 
-    #define malloc_align(s, a) _aligned_malloc((usize)s, (usize)a)
-    #define realloc_align(alloc, mem, old_size, new_size, align) \
-        _aligned_realloc(mem, (usize)new_size, (usize)align)
-    #define free_align(p, a) _aligned_free(p)
+        return str - begin;
+    }
+
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__wcs_len_avx2(str);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__wcs_len_sse2(str);
 #else
-extern int posix_memalign(void**, size_t, size_t);
+    while (!CY__IS_WORD_ALIGNED(str)) {
+        if (*str == 0) {
+            return str - begin;
+        }
 
-void *malloc_align(isize size, isize align)
-{
-    void *ptr = NULL;
-    if (posix_memalign(&ptr, align, size) != 0) {
-        return NULL;
+        str += 1;
     }
 
-    return ptr;
-}
+    const usize *w = (const usize*)str;
+    if (sizeof(wchar_t) == 2) {
+        while (!CY__HAS_ZERO_U16(*w)) {
+            w += 1;
+        }
+    } else {
+        while (!CY__HAS_ZERO_U32(*w)) {
+            w += 1;
+        }
+    }
 
-    #define realloc_align cy_default_resize_align
-    #define free_align(p, a) free(p)
+    str = (const wchar_t*)w;
+    while (*str != 0) {
+        str += 1;
+    }
+
+    return str - begin;
 #endif
+}
 
-CY_ALLOCATOR_PROC(cy_heap_allocator_proc)
+CY__NO_SANITIZE_ADDRESS
+cy_inline char *cy_str_copy(char *dst, const char *src)
 {
-#if defined(CY_OS_WINDOWS)
-    CY_UNUSED(old_size);
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__str_copy_avx2(dst, src);
+    }
 #endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_copy_sse2(dst, src);
+#else
+    while (!CY__IS_WORD_ALIGNED(src)) {
+        if (*src == '\0') {
+            *dst = '\0';
+            return dst;
+        }
 
-    CY_UNUSED(allocator_data);
-    CY_UNUSED(old_size);
+        *dst++ = *src++;
+    }
 
-    void *ptr = NULL;
-    switch(type) {
-    case CY_ALLOCATION_ALLOC: {
-        ptr = malloc_align(size, align);
-        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
-            cy_mem_zero(ptr, size);
-        }
-    } break;
-    case CY_ALLOCATION_ALLOC_ALL: {
-    } break;
-    case CY_ALLOCATION_FREE: {
-        free_align(old_mem, align);
-    } break;
-    case CY_ALLOCATION_FREE_ALL: {
-    } break;
-    case CY_ALLOCATION_RESIZE: {
-        void *new_ptr = realloc_align(
-            cy_heap_allocator(), old_mem,
-            old_size, size, align
-        );
-        CY_VALIDATE_PTR(new_ptr);
-        ptr = new_ptr;
-    } break;
+    isize *wd = (isize*)dst;
+    const isize *ws = (const isize*)src;
+    while (!CY__HAS_ZERO_BYTE(*ws)) {
+        *wd++ = *ws++;
     }
 
-    return ptr;
+    dst = (char*)wd;
+    src = (const char*)ws;
+    while (*src != '\0') {
+        *dst++ = *src++;
+    }
+
+    *dst = '\0';
+    return dst;
+#endif
 }
 
-/* ---------------------------- Static Allocator ---------------------------- */
-cy_inline CyAllocator cy_static_allocator(CyBuffer *buf)
+CY__NO_SANITIZE_ADDRESS
+cy_inline isize cy_str_compare(const char *a, const char *b)
 {
-    return (CyAllocator){
-        .proc = cy_static_allocator_proc,
-        .data = buf,
-    };
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__str_compare_avx2(a, b);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_compare_sse2(a, b);
+#else
+    while (*a != '\0' && *a == *b) {
+        a += 1, b += 1;
+    }
+
+    return *(const u8*)a - *(const u8*)b;
+#endif
 }
 
-cy_inline CyBuffer cy_static_buf_init(void *backing_buf, isize size)
+cy_inline isize cy_str_compare_n(const char *a, const char *b, isize len)
 {
-    return (CyBuffer){
-        .memory = backing_buf,
-        .size = size,
-    };
+#if defined(CY__SIMD_AVX2)
+    if (len >= 32 && cy__cpu_has_avx2()) {
+        return cy__str_compare_n_avx2(a, b, len);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_compare_n_sse2(a, b, len);
+#else
+    while (len > 0) {
+        if (*a != *b) {
+            return *(const u8*)a - *(const u8*)b;
+        }
+
+        a += 1, b += 1;
+        len -= 1;
+    }
+
+    return 0;
+#endif
 }
 
-CY_ALLOCATOR_PROC(cy_static_allocator_proc)
+cy_inline b32 cy_str_has_prefix(const char *str, const char *prefix)
 {
-    CY_UNUSED(align);
-    CY_UNUSED(old_mem);
-    CY_UNUSED(old_size);
-
-    CyBuffer *buf = allocator_data;
-    void *ptr = NULL;
-    switch (type) {
-    case CY_ALLOCATION_ALLOC: {
-        CY_ASSERT_MSG(size == buf->size, "static_allocator: invalid size");
-    } // NOTE(cya): fallthrough
-    case CY_ALLOCATION_ALLOC_ALL: {
-        ptr = buf->memory;
-        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
-            cy_mem_zero(ptr, size);
+    while (*prefix != '\0') {
+        if (*str++ != *prefix++) {
+            return false;
         }
-    } break;
-    case CY_ALLOCATION_FREE:
-    case CY_ALLOCATION_FREE_ALL:
-    case CY_ALLOCATION_RESIZE: {
-        CY_PANIC("static allocator: unsupported operation");
-    } break;
     }
 
-    return ptr;
+    return true;
 }
 
-/* ---------------------- Virtual Memory (VM) Allocator --------------------- */
-CyAllocator cy_virtual_memory_allocator(void)
+cy_inline char *cy_str_reverse(char *str)
 {
-    return (CyAllocator){
-        .proc = cy_virtual_memory_allocator_proc,
-    };
+    char *s = str, *e = str + cy_str_len(str) - 1;
+    while (s < e) {
+        CY_SWAP(char, *s, *e);
+        s += 1, e -= 1;
+    }
+
+    return str;
 }
 
-cy_internal uintptr *cy__vm_header_from_alloc_start(void *ptr)
+cy_inline char *cy_str_reverse_n(char *str, isize len)
 {
-    return (uintptr*)((u8*)ptr - cy_sizeof(uintptr));
+    char *s = str, *e = str + len - 1;
+    while (s < e) {
+        CY_SWAP(char, *s, *e);
+        s += 1, e -= 1;
+    }
+
+    return str;
 }
 
-CY_ALLOCATOR_PROC(cy_virtual_memory_allocator_proc)
+cy_inline void cy_str_to_lower(char *str)
 {
-    CY_UNUSED(allocator_data);
-    CY_UNUSED(flags);
-    CY_UNUSED(old_size);
+    if (str == NULL) {
+        return;
+    }
 
-    void *ptr = NULL;
-    switch (type) {
-    case CY_ALLOCATION_ALLOC: {
-        CY_ASSERT_MSG(size > 0, "VM allocator: invalid allocation size");
+    for (; *str != '\0'; str++) {
+        *str = cy_char_to_lower(*str);
+    }
+}
 
-        isize alignment = CY_MAX(align, cy_sizeof(uintptr));
-        isize total_size = size + alignment - 1;
-        CyMemoryBlock *block = cy_virtual_memory_alloc(total_size);
-        if (block == NULL) {
-            CY_PANIC("VM allocator: out of virtual memory");
-            break;
-        }
+cy_inline void cy_str_to_upper(char *str)
+{
+    if (str == NULL) {
+        return;
+    }
 
-        ptr = cy_align_forward_ptr(block->start, alignment);
-        uintptr *header = cy__vm_header_from_alloc_start(ptr);
-        *header = (uintptr)block;
+    for (; *str != '\0'; str++) {
+        *str = cy_char_to_upper(*str);
+    }
+}
+
+cy_inline const char *cy_parse_error_as_str(CyParseError err)
+{
+    const char *str = "";
+    switch (err) {
+    case CY_PARSE_ERROR_NONE: {
+        str = "success";
     } break;
-    case CY_ALLOCATION_FREE: {
-        uintptr *header = cy__vm_header_from_alloc_start(old_mem);
-        CyMemoryBlock *block = (CyMemoryBlock*)(*header);
-        cy_virtual_memory_free(block);
+    case CY_PARSE_ERROR_INVALID: {
+        str = "no digits to parse";
     } break;
-    case CY_ALLOCATION_RESIZE: {
-        uintptr *header = cy__vm_header_from_alloc_start(old_mem);
-        CyMemoryBlock *block = (CyMemoryBlock*)(*header);
+    case CY_PARSE_ERROR_OVERFLOW: {
+        str = "value out of range";
+    } break;
+    }
 
-        CyMemoryBlock *new_block = cy_virtual_memory_resize(block, size);
-        if (new_block == NULL) {
-            break;
-        }
+    return str;
+}
 
-        ptr = new_block->start;
-        header = cy__vm_header_from_alloc_start(ptr);
-        *header = (uintptr)new_block;
-    } break;
-    case CY_ALLOCATION_ALLOC_ALL:
-    case CY_ALLOCATION_FREE_ALL: {
-        CY_PANIC("VM allocator: unsupported operation");
-    } break;
+u64 cy_str_to_u64(const char *str, i32 base, isize *len_out)
+{
+    u64 res;
+    isize len;
+    cy__parse_u64((const u8*)str, -1, base, &res, &len);
+    if (len_out != NULL) {
+        *len_out = len;
     }
 
-    return ptr;
+    return res;
 }
 
-/* ---------------------------- Arena Allocator ----------------------------- */
-cy_inline CyAllocator cy_arena_allocator(CyArena *arena)
+i64 cy_str_to_i64(const char *str, i32 base, isize *len_out)
 {
-    return (CyAllocator){
-        .proc = cy_arena_allocator_proc,
-        .data = arena,
-    };
+    i64 res;
+    isize len;
+    cy__parse_i64((const u8*)str, -1, base, &res, &len);
+    if (len_out != NULL) {
+        *len_out = len;
+    }
+
+    return res;
 }
 
-#ifndef CY_ARENA_DEFAULT_SIZE
-    #define CY_ARENA_DEFAULT_SIZE CY_KB(16)
-#endif
+CyParseError cy_str_to_u64_report(
+    const char *str, i32 base, u64 *value, isize *len_out
+) {
+    u64 res;
+    isize len;
+    CyParseError err = cy__parse_u64((const u8*)str, -1, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
+    }
+    if (len_out != NULL) {
+        *len_out = len;
+    }
 
-#ifndef CY_ARENA_GROWTH_FACTOR
-    #define CY_ARENA_GROWTH_FACTOR 2.0
-#endif
+    return err;
+}
 
-cy_inline CyMemoryBlock *cy_arena_insert_block(CyArena *arena, isize size)
+CyParseError cy_str_to_i64_report(
+    const char *str, i32 base, i64 *value, isize *len_out
+) {
+    i64 res;
+    isize len;
+    CyParseError err = cy__parse_i64((const u8*)str, -1, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
+    }
+    if (len_out != NULL) {
+        *len_out = len;
+    }
+
+    return err;
+}
+
+isize cy_str_parse_u64(u64 n, i32 base, char *dst)
 {
-    CY_VALIDATE_PTR(arena);
+    isize len = cy__u64_digit_count(n, base);
+    cy__u64_write_digits(n, base, cy__num_to_char_table_upper, dst + len);
+    dst[len] = '\0';
 
-    isize align = CY_DEFAULT_ALIGNMENT;
-    isize block_padding = cy_sizeof(CyMemoryBlock) + align - 1;
-    isize new_block_size = block_padding + size;
-    CyMemoryBlock *new_block = cy_alloc(arena->backing, new_block_size);
-    CY_VALIDATE_PTR(new_block);
+    return len;
+}
 
-    new_block->start = cy_align_forward_ptr(new_block + 1, align);
-    new_block->size = size;
-    new_block->prev = arena->cur_block;
-    arena->cur_block = new_block;
+isize cy_str_parse_i64(i64 n, i32 base, char *dst)
+{
+    char *c = dst;
+    if (n < 0) {
+        *c++ = '-';
+    }
 
-    return new_block;
+    // NOTE(cya): negating in unsigned so INT64_MIN doesn't overflow
+    u64 v = (n < 0) ? 0 - (u64)n : (u64)n;
+    return (c - dst) + cy_str_parse_u64(v, base, c);
 }
 
-cy_inline CyArena cy_arena_init(CyAllocator backing, isize initial_size)
+cy_inline f32 cy_str_to_f32(const char *str, isize *len_out)
 {
-    CY_ASSERT_NOT_NULL(backing.proc);
+    return (f32)cy_str_to_f64(str, len_out);
+}
 
-    isize default_size = CY_ARENA_DEFAULT_SIZE;
-    if (initial_size == 0) {
-        initial_size = default_size;
+f64 cy_str_to_f64(const char *str, isize *len_out)
+{
+    f64 res;
+    isize len = cy__scan_f64(str, &res);
+    if (len_out != NULL) {
+        *len_out = len;
     }
 
-    CyArena arena = {.backing = backing};
-    cy_arena_insert_block(&arena, initial_size);
-    return arena;
+    return res;
 }
 
-cy_inline void cy_arena_deinit(CyArena *arena)
+isize cy_str_parse_f32(f32 n, char *dst)
 {
-    if (arena == NULL) {
-        return;
+    char *cur = dst;
+    if (CY_IS_NAN(n)) {
+        return cy_str_copy(cur, "NaN") - dst;
     }
 
-    CyMemoryBlock *cur_block = arena->cur_block;
-    while (cur_block != NULL) {
-        CyMemoryBlock *prev = cur_block->prev;
-        cy_free(arena->backing, cur_block);
-        cur_block = prev;
+    if (cy__f32_to_bits(n) >> 31) {
+        *cur++ = '-';
+        n = -n;
     }
 
-    cy_mem_set(arena, 0, cy_sizeof(*arena));
+    if (CY_IS_INF(n)) {
+        return cy_str_copy(cur, "Inf") - dst;
+    }
+
+    CyPrivDecimalFloat dec = {0};
+    if (n != 0.0f) {
+        dec = cy__f32_shortest(n);
+    }
+
+    cur += cy__f64_format_general(cur, dec, 9, false, false);
+    *cur = '\0';
+
+    return cur - dst;
 }
 
-CY_ALLOCATOR_PROC(cy_arena_allocator_proc)
+// NOTE(cya):
+// * this writes the shortest representation that parses back to the exact
+// same value, in the same notation as the %r format specifier
+// * make sure you write this to a buffer with at least 32 bytes of capacity
+// (including the null terminator)
+isize cy_str_parse_f64(f64 n, char *dst)
 {
-    CyArena *arena = (CyArena*)allocator_data;
-    CyAllocator a = cy_arena_allocator(arena);
-    void *ptr = NULL;
-    switch(type) {
-    case CY_ALLOCATION_ALLOC: {
-        CyMemoryBlock *cur_block = arena->cur_block;
-        u8 *start = cur_block->start;
-        u8 *end = start + cur_block->offset;
-        u8 *aligned_end = cy_align_forward_ptr(end, align);
-        while (aligned_end + size > start + cur_block->size) {
-            if (cur_block->prev == NULL) {
-                // NOTE(cya): out of memory in this block!
-                f64 cur_size = (f64)cur_block->size;
-                isize new_size = (isize)(cur_size * CY_ARENA_GROWTH_FACTOR);
-
-                cur_block = cy_arena_insert_block(arena, new_size);
-                CY_VALIDATE_PTR(cur_block);
-
-                end = (u8*)cur_block->start + cur_block->offset;
-                aligned_end = cy_align_forward_ptr(end, align);
-                break;
-            }
+    char *cur = dst;
+    if (CY_IS_NAN(n)) {
+        return cy_str_copy(cur, "NaN") - dst;
+    }
 
-            cur_block = cur_block->prev;
-            end = (u8*)cur_block->start + cur_block->offset;
-            aligned_end = cy_align_forward_ptr(end, align);
-        }
+    if (cy__f64_to_bits(n) >> 63) {
+        *cur++ = '-';
+        n = -n;
+    }
 
-        isize aligned_offset = aligned_end - (u8*)cur_block->start;
+    if (CY_IS_INF(n)) {
+        return cy_str_copy(cur, "Inf") - dst;
+    }
 
-        cur_block->prev_offset = aligned_offset;
-        cur_block->offset = aligned_offset + size;
+    CyPrivDecimalFloat dec = {0};
+    if (n != 0.0) {
+        dec = cy__f64_shortest(n);
+    }
 
-        ptr = aligned_end;
-        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
-            cy_mem_zero(ptr, size);
-        }
-    } break;
-    case CY_ALLOCATION_ALLOC_ALL: {
-        CyAllocator backing = arena->backing;
-        CyMemoryBlock *cur_block = arena->cur_block->prev, *prev;
-        while (cur_block != NULL) {
-            prev = cur_block->prev;
-            cy_free(backing, cur_block);
-            cur_block = prev;
-        }
+    cur += cy__f64_format_general(cur, dec, 17, false, false);
+    *cur = '\0';
 
-        cur_block = arena->cur_block;
-        isize remaining = cur_block->size - cur_block->offset;
-        ptr = cy_alloc_align(backing, remaining, align);
-        CY_VALIDATE_PTR(ptr);
+    return cur - dst;
+}
 
-        ptr = cy_align_forward_ptr(ptr, align);
-    } break;
-    case CY_ALLOCATION_FREE: {
-    } break;
-    case CY_ALLOCATION_FREE_ALL: {
-        CyMemoryBlock *cur_block = arena->cur_block, *prev = cur_block->prev;
-        while (prev != NULL) {
-            cur_block = prev;
-            prev = prev->prev;
-            cy_free(arena->backing, cur_block);
+/* ------------------------------- Char sets -------------------------------- */
+/*
+ * Set lookups: AVX2 does the bitmap lookup for any set by splitting bytes into
+ * nibbles (the low one picks a row, the high one a bit in it) and SSE2 just
+ * compares against every char for sets of up to 16 of them, which is what
+ * whitespace and delimiter sets usually look like
+ */
+cy_internal isize cy__char_set_find_scalar(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    for (isize i = 0; i < len; i++) {
+        if (cy_char_set_has(set, s[i]) == member) {
+            return i;
         }
+    }
 
-        cur_block = arena->cur_block;
-        cy_mem_set(cur_block, 0, cy_sizeof(*cur_block) + cur_block->size);
-    } break;
-    case CY_ALLOCATION_RESIZE: {
-        CY_ASSERT(cy_is_power_of_two(align));
+    return len;
+}
 
-        u8 *old_memory = old_mem;
-        if (old_memory == NULL || old_size == 0) {
-            return cy_alloc_align(a, size, align);
+cy_internal isize cy__char_set_find_last_scalar(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    for (isize i = len - 1; i >= 0; i--) {
+        if (cy_char_set_has(set, s[i]) == member) {
+            return i;
         }
+    }
 
-        CyMemoryBlock *cur_block = arena->cur_block;
-        u8 *start = cur_block->start;
-        isize prev_offset = 0;
-        b32 is_in_range = false, found_node = false;
-        while (cur_block != NULL) {
-            is_in_range = old_memory >= start &&
-                old_memory < (start + cur_block->size);
-            if (is_in_range) {
-                prev_offset = cur_block->prev_offset;
-                found_node = start + prev_offset == old_memory &&
-                    (cur_block->offset - cur_block->prev_offset == old_size);
-                break;
-            }
+    return -1;
+}
 
-            cur_block = cur_block->prev;
-            start = cur_block->start;
-        }
+#if defined(CY__SIMD_SSE2)
+typedef struct {
+    __m128i chars[16];
+    i32 count;
+} CyPrivCharSetSse2;
 
-        if (!is_in_range) {
-            CY_PANIC("arena allocator: out-of-bounds reallocation");
-            break;
-        } else if (!found_node) {
-            // NOTE(cya): is in valid space but is not the latest allocation
-            // (this might result in some odd behavior in some edge cases)
-            void *new_mem = cy_alloc_align(a, size, align);
-            CY_VALIDATE_PTR(new_mem);
+cy_internal cy_inline void cy__char_set_sse2_init(
+    CyPrivCharSetSse2 *v, const CyCharSet *set
+) {
+    v->count = set->char_count;
+    for (i32 i = 0; i < set->char_count; i++) {
+        v->chars[i] = _mm_set1_epi8((char)set->chars[i]);
+    }
+}
+
+// NOTE(cya): one bit per byte of the block that's in the set
+cy_internal cy_inline u32 cy__char_set_mask_sse2(
+    const CyPrivCharSetSse2 *v, __m128i block
+) {
+    __m128i hits = _mm_setzero_si128();
+    for (i32 i = 0; i < v->count; i++) {
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, v->chars[i]));
+    }
+
+    return (u32)_mm_movemask_epi8(hits);
+}
+
+cy_internal isize cy__char_set_find_sse2(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    CyPrivCharSetSse2 v;
+    cy__char_set_sse2_init(&v, set);
+
+    u32 flip = member ? 0 : 0xFFFF;
+    isize i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(s + i));
+        u32 mask = cy__char_set_mask_sse2(&v, block) ^ flip;
+        if (mask != 0) {
+            return i + cy__u32_trailing_zeros(mask);
+        }
+    }
 
-            cy_mem_copy(new_mem, old_mem, CY_MIN(old_size, size));
-            ptr = new_mem;
-            break;
+    return i + cy__char_set_find_scalar(s + i, len - i, set, member);
+}
+
+cy_internal isize cy__char_set_find_last_sse2(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    CyPrivCharSetSse2 v;
+    cy__char_set_sse2_init(&v, set);
+
+    u32 flip = member ? 0 : 0xFFFF;
+    isize i = len;
+    for (; i >= 16; i -= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(s + i - 16));
+        u32 mask = cy__char_set_mask_sse2(&v, block) ^ flip;
+        if (mask != 0) {
+            return i - 16 + cy__u64_bit_len(mask) - 1;
         }
+    }
 
-        intptr aligned_offset = cy_align_forward_size(prev_offset, align);
-        u8 *new_memory = start + aligned_offset;
-        if (new_memory + size < start + cur_block->size) {
-            cur_block->offset = aligned_offset + size;
-            if (cur_block->offset < cur_block->prev_offset + old_size) {
-                cy_mem_set(start + cur_block->offset, 0, old_size - size);
-            }
+    return cy__char_set_find_last_scalar(s, i, set, member);
+}
+#endif
 
-            cur_block->prev_offset = aligned_offset;
-        } else {
-            void *new_ptr = cy_alloc_align(a, size, align);
-            CY_VALIDATE_PTR(new_ptr);
+#if defined(CY__SIMD_AVX2)
+typedef struct {
+    __m256i rows_lo;
+    __m256i rows_hi;
+    __m256i bits;
+    __m256i nibble_mask;
+} CyPrivCharSetAvx2;
+
+CY__TARGET_AVX2
+cy_internal cy_inline void cy__char_set_avx2_init(
+    CyPrivCharSetAvx2 *v, const CyCharSet *set
+) {
+    cy_persist const u8 bits[16] = {
+        1, 2, 4, 8, 16, 32, 64, 128,
+        1, 2, 4, 8, 16, 32, 64, 128,
+    };
 
-            cy_mem_move(new_ptr, old_memory, CY_MIN(old_size, size));
-            new_memory = new_ptr;
+    v->rows_lo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)set->nibbles[0])
+    );
+    v->rows_hi = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)set->nibbles[1])
+    );
+    v->bits = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)bits)
+    );
+    v->nibble_mask = _mm256_set1_epi8(0xF);
+}
+
+CY__TARGET_AVX2
+cy_internal cy_inline u32 cy__char_set_mask_avx2(
+    const CyPrivCharSetAvx2 *v, __m256i block
+) {
+    __m256i lo = _mm256_and_si256(block, v->nibble_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), v->nibble_mask);
+
+    __m256i row = _mm256_blendv_epi8(
+        _mm256_shuffle_epi8(v->rows_lo, lo),
+        _mm256_shuffle_epi8(v->rows_hi, lo),
+        _mm256_cmpgt_epi8(hi, _mm256_set1_epi8(7))
+    );
+    __m256i bit = _mm256_shuffle_epi8(v->bits, hi);
+    __m256i hits = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return (u32)_mm256_movemask_epi8(hits);
+}
+
+CY__TARGET_AVX2
+cy_internal isize cy__char_set_find_avx2(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    CyPrivCharSetAvx2 v;
+    cy__char_set_avx2_init(&v, set);
+
+    u32 flip = member ? 0 : 0xFFFFFFFF;
+    isize i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(s + i));
+        u32 mask = cy__char_set_mask_avx2(&v, block) ^ flip;
+        if (mask != 0) {
+            return i + cy__u32_trailing_zeros(mask);
         }
+    }
 
-        ptr = new_memory;
-    } break;
+    return i + cy__char_set_find_scalar(s + i, len - i, set, member);
+}
+
+CY__TARGET_AVX2
+cy_internal isize cy__char_set_find_last_avx2(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+    CyPrivCharSetAvx2 v;
+    cy__char_set_avx2_init(&v, set);
+
+    u32 flip = member ? 0 : 0xFFFFFFFF;
+    isize i = len;
+    for (; i >= 32; i -= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(s + i - 32));
+        u32 mask = cy__char_set_mask_avx2(&v, block) ^ flip;
+        if (mask != 0) {
+            return i - 32 + cy__u64_bit_len(mask) - 1;
+        }
     }
 
-    return ptr;
+    return cy__char_set_find_last_scalar(s, i, set, member);
 }
 
-/* -----------------------------Stack Allocator ----------------------------- */
-cy_inline CyAllocator cy_stack_allocator(CyStack *stack)
+CY__TARGET_AVX2
+cy_internal u64 cy__char_set_block_mask_avx2(
+    const u8 *p, const CyCharSet *set
+) {
+    CyPrivCharSetAvx2 v;
+    cy__char_set_avx2_init(&v, set);
+
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    return (u64)cy__char_set_mask_avx2(&v, lo) |
+        ((u64)cy__char_set_mask_avx2(&v, hi) << 32);
+}
+
+CY__TARGET_AVX2
+cy_internal u64 cy__byte_block_mask_avx2(const u8 *p, u8 c)
 {
-    return (CyAllocator){
-        .data = stack,
-        .proc = cy_stack_allocator_proc,
-    };
+    __m256i needle = _mm256_set1_epi8((char)c);
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    u32 lo_mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle));
+    u32 hi_mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle));
+    return (u64)lo_mask | ((u64)hi_mask << 32);
 }
+#endif
 
-#ifndef CY_STACK_DEFAULT_SIZE
-    #define CY_STACK_DEFAULT_SIZE CY_KB(16)
+// NOTE(cya): index of the first byte whose membership is `member` (or len)
+cy_internal isize cy__char_set_find(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+#if defined(CY__SIMD_AVX2)
+    if (len >= 32 && cy__cpu_has_avx2()) {
+        return cy__char_set_find_avx2(s, len, set, member);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    if (len >= 16 && set->char_count <= cy_sizeof(set->chars)) {
+        return cy__char_set_find_sse2(s, len, set, member);
+    }
 #endif
 
-#ifndef CY_STACK_GROWTH_FACTOR
-    #define CY_STACK_GROWTH_FACTOR 2.0
+    return cy__char_set_find_scalar(s, len, set, member);
+}
+
+// NOTE(cya): index of the last byte whose membership is `member` (or -1)
+cy_internal isize cy__char_set_find_last(
+    const u8 *s, isize len, const CyCharSet *set, b32 member
+) {
+#if defined(CY__SIMD_AVX2)
+    if (len >= 32 && cy__cpu_has_avx2()) {
+        return cy__char_set_find_last_avx2(s, len, set, member);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    if (len >= 16 && set->char_count <= cy_sizeof(set->chars)) {
+        return cy__char_set_find_last_sse2(s, len, set, member);
+    }
 #endif
 
-cy_inline CyStackNode *cy_stack_insert_node(CyStack *stack, isize size)
+    return cy__char_set_find_last_scalar(s, len, set, member);
+}
+
+// NOTE(cya): bit i is set if p[i] is in the set, 64 bytes at p
+cy_internal u64 cy__char_set_block_mask(const u8 *p, const CyCharSet *set)
 {
-    CY_VALIDATE_PTR(stack);
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__char_set_block_mask_avx2(p, set);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    if (set->char_count <= cy_sizeof(set->chars)) {
+        CyPrivCharSetSse2 v;
+        cy__char_set_sse2_init(&v, set);
+
+        u64 mask = 0;
+        for (isize i = 0; i < 64; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(p + i));
+            mask |= (u64)cy__char_set_mask_sse2(&v, block) << i;
+        }
 
-    isize node_padding = cy_sizeof(CyStackNode) + CY_DEFAULT_ALIGNMENT;
-    isize new_node_size = node_padding + size;
-    CyStackNode *new_node = cy_alloc(stack->backing, new_node_size);
-    CY_VALIDATE_PTR(new_node);
+        return mask;
+    }
+#endif
 
-    new_node->buf = cy_align_forward_ptr(new_node + 1, CY_DEFAULT_ALIGNMENT);
-    new_node->size = size;
-    new_node->next = stack->state.first_node;
-    stack->state.first_node = new_node;
+    u64 mask = 0;
+    for (isize i = 0; i < 64; i++) {
+        mask |= (u64)cy_char_set_has(set, p[i]) << i;
+    }
 
-    return new_node;
+    return mask;
 }
 
-cy_inline CyStack cy_stack_init(CyAllocator backing, isize initial_size)
+// NOTE(cya): bit i is set if p[i] == c, 64 bytes at p
+cy_internal u64 cy__byte_block_mask(const u8 *p, u8 c)
 {
-    isize default_size = CY_STACK_DEFAULT_SIZE;
-    if (initial_size == 0) {
-        initial_size = default_size;
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__byte_block_mask_avx2(p, c);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    __m128i needle = _mm_set1_epi8((char)c);
+    u64 mask = 0;
+    for (isize i = 0; i < 64; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(p + i));
+        mask |= (u64)(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)) << i;
     }
 
-    CyStack stack = {
-        .backing = backing,
-    };
-    stack.state.first_node = cy_stack_insert_node(&stack, initial_size);
-    return stack;
+    return mask;
+#else
+    u64 mask = 0;
+    for (isize i = 0; i < 64; i++) {
+        mask |= (u64)(p[i] == c) << i;
+    }
+
+    return mask;
+#endif
 }
 
-cy_inline void cy_stack_deinit(CyStack *stack)
-{
-    if (stack == NULL) {
-        return;
-    }
+/* ---------------------------- Substring search ---------------------------- */
+/*
+ * The filter finds the positions where both the first and the last byte of the
+ * needle match (a block at a time) and only compares the middle for those.
+ * That's the fastest thing there is when it has SIMD to work with, but every
+ * candidate can cost a compare as long as the needle, so long needles switch
+ * over to Two-Way when there are too many of them to keep the search linear
+ */
+#if defined(CY__SIMD_SSE2)
+    #define CY__STR_FIND_TWO_WAY_MIN_LEN 64
+#else
+    #define CY__STR_FIND_TWO_WAY_MIN_LEN 4
+#endif
 
-    CyStackNode *cur_node = stack->state.first_node;
-    while (cur_node != NULL) {
-        CyStackNode *next = cur_node->next;
-        cy_free(stack->backing, cur_node);
-        cur_node = next;
+cy_internal cy_inline b32 cy__str_find_matches_at(
+    const u8 *s, const u8 *needle, isize needle_len
+) {
+    return needle_len <= 2 ||
+        cy_mem_compare(s + 1, needle + 1, needle_len - 2) == 0;
+}
+
+cy_internal isize cy__str_find_scalar(
+    const u8 *s, isize len, const u8 *needle, isize needle_len, isize start
+) {
+    u8 first = needle[0], last = needle[needle_len - 1];
+    for (isize i = start; i <= len - needle_len; i++) {
+        if (
+            s[i] == first && s[i + needle_len - 1] == last &&
+            cy__str_find_matches_at(s + i, needle, needle_len)
+        ) {
+            return i;
+        }
     }
 
-    cy_mem_set(stack, 0, cy_sizeof(*stack));
+    return -1;
 }
 
-CY_ALLOCATOR_PROC(cy_stack_allocator_proc)
-{
-    CY_UNUSED(flags);
-    CY_ASSERT(cy_is_power_of_two(align));
+cy_internal isize cy__str_find_last_scalar(
+    const u8 *s, const u8 *needle, isize needle_len, isize start
+) {
+    u8 first = needle[0], last = needle[needle_len - 1];
+    for (isize i = start; i >= 0; i--) {
+        if (
+            s[i] == first && s[i + needle_len - 1] == last &&
+            cy__str_find_matches_at(s + i, needle, needle_len)
+        ) {
+            return i;
+        }
+    }
 
-    CyStack *stack = (CyStack*)allocator_data;
-    CyAllocator a = cy_stack_allocator(stack);
-    void *ptr = NULL;
-    switch(type) {
-    case CY_ALLOCATION_ALLOC: {
-        CyStackNode *cur_node = stack->state.first_node;
-        u8 *cur_addr = cur_node->buf + cur_node->offset;
-        CyStackHeader *header;
-        isize padding = cy_calc_header_padding(
-            (uintptr)cur_addr, align, cy_sizeof(*header)
-        );
-        u8 *alloc_end = cur_addr + padding + size;
-        while (alloc_end > cur_node->buf + cur_node->size) {
-            if (cur_node->next == NULL) {
-                f64 largest_node_size = (f64)stack->state.first_node->size;
-                isize new_size = (isize)
-                    (largest_node_size * CY_STACK_GROWTH_FACTOR);
-                isize max_alloc_size = align + cy_sizeof(*header) + size;
-
-                cur_node = cy_stack_insert_node(
-                    stack, CY_MAX(new_size, max_alloc_size)
-                );
-                CY_VALIDATE_PTR(cur_node);
-            } else {
-                cur_node = cur_node->next;
+    return -1;
+}
+
+#if defined(CY__SIMD_SSE2)
+cy_internal isize cy__str_find_sse2(
+    const u8 *s, isize len, const u8 *needle, isize needle_len,
+    isize slack, isize *resume
+) {
+    __m128i first = _mm_set1_epi8((char)needle[0]);
+    __m128i last = _mm_set1_epi8((char)needle[needle_len - 1]);
+
+    isize i = 0, work = 0;
+    for (; i + needle_len - 1 + 16 <= len; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(s + i + needle_len - 1));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)
+        ));
+        while (mask != 0) {
+            isize pos = i + cy__u32_trailing_zeros(mask);
+            if (cy__str_find_matches_at(s + pos, needle, needle_len)) {
+                return pos;
             }
 
-            cur_addr = cur_node->buf + cur_node->offset;
-            padding = cy_calc_header_padding(
-                (uintptr)cur_addr, align, cy_sizeof(*header)
-            );
-            alloc_end = cur_addr + padding + size;
+            work += needle_len;
+            mask &= mask - 1;
         }
+        if (work - i > slack) {
+            *resume = i + 16;
+            return -1;
+        }
+    }
 
-        ptr = cur_addr + padding;
-        header = (CyStackHeader*)ptr - 1;
-        header->padding = padding;
-        header->prev_offset = cur_node->offset;
+    return cy__str_find_scalar(s, len, needle, needle_len, i);
+}
 
-        cur_node->prev_offset = header->prev_offset;
-        cur_node->offset += size + padding;
-    } break;
-    case CY_ALLOCATION_ALLOC_ALL: {
-        CyAllocator backing = stack->backing;
-        CyStackNode *cur_node = stack->state.first_node->next, *next;
-        while (cur_node != NULL) {
-            next = cur_node->next;
-            cy_free(backing, cur_node);
-            cur_node = next;
+cy_internal isize cy__str_find_last_sse2(
+    const u8 *s, isize len, const u8 *needle, isize needle_len,
+    isize slack, isize *resume
+) {
+    __m128i first = _mm_set1_epi8((char)needle[0]);
+    __m128i last = _mm_set1_epi8((char)needle[needle_len - 1]);
+
+    // NOTE(cya): `i` is the last candidate position the next block covers
+    isize i = len - needle_len, work = 0;
+    for (; i >= 15; i -= 16) {
+        const u8 *block = s + i - 15;
+        __m128i a = _mm_loadu_si128((const __m128i*)block);
+        __m128i b = _mm_loadu_si128((const __m128i*)(block + needle_len - 1));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)
+        ));
+        while (mask != 0) {
+            isize bit = cy__u64_bit_len(mask) - 1;
+            if (cy__str_find_matches_at(block + bit, needle, needle_len)) {
+                return i - 15 + bit;
+            }
+
+            work += needle_len;
+            mask &= ~((u32)1 << bit);
+        }
+        if (work - (len - needle_len - i) > slack) {
+            *resume = i - 16 + needle_len;
+            return -1;
         }
+    }
 
-        cur_node = stack->state.first_node;
-        isize remaining = cur_node->size - cur_node->offset;
-        ptr = cy_alloc_align(backing, remaining, align);
-        CY_VALIDATE_PTR(ptr);
+    return cy__str_find_last_scalar(s, needle, needle_len, i);
+}
+#endif
 
-        ptr = cy_align_forward_ptr(ptr, align);
-    } break;
-    case CY_ALLOCATION_FREE: {
-        CY_VALIDATE_PTR(old_mem);
+#if defined(CY__SIMD_AVX2)
+CY__TARGET_AVX2
+cy_internal isize cy__str_find_avx2(
+    const u8 *s, isize len, const u8 *needle, isize needle_len,
+    isize slack, isize *resume
+) {
+    __m256i first = _mm256_set1_epi8((char)needle[0]);
+    __m256i last = _mm256_set1_epi8((char)needle[needle_len - 1]);
+
+    isize i = 0, work = 0;
+    for (; i + needle_len - 1 + 32 <= len; i += 32) {
+        const u8 *tail = s + i + needle_len - 1;
+        __m256i a = _mm256_loadu_si256((const __m256i*)(s + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)tail);
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)
+        ));
+        while (mask != 0) {
+            isize pos = i + cy__u32_trailing_zeros(mask);
+            if (cy__str_find_matches_at(s + pos, needle, needle_len)) {
+                return pos;
+            }
 
-        CyStackNode *cur_node = stack->state.first_node;
-        u8 *start = cur_node->buf;
-        u8 *end = start + cur_node->size;
-        u8 *cur_addr = old_mem;
-        if (!(start <= cur_addr && cur_addr < end)) {
-            CY_PANIC("stack allocator: out-of-bounds pointer");
-            break;
+            work += needle_len;
+            mask &= mask - 1;
         }
-        if (cur_addr >= start + cur_node->offset) {
-            break; // NOTE(cya): allowing double-frees
+        if (work - i > slack) {
+            *resume = i + 32;
+            return -1;
         }
+    }
 
-        CyStackHeader *header = (CyStackHeader*)(uintptr)cur_addr - 1;
-        isize prev_offset = cur_addr - header->padding - start;
-        if (prev_offset != header->prev_offset) {
-            CY_PANIC("stack allocator: out-of-order deallocation");
-            break;
+    return cy__str_find_scalar(s, len, needle, needle_len, i);
+}
+
+CY__TARGET_AVX2
+cy_internal isize cy__str_find_last_avx2(
+    const u8 *s, isize len, const u8 *needle, isize needle_len,
+    isize slack, isize *resume
+) {
+    __m256i first = _mm256_set1_epi8((char)needle[0]);
+    __m256i last = _mm256_set1_epi8((char)needle[needle_len - 1]);
+
+    isize i = len - needle_len, work = 0;
+    for (; i >= 31; i -= 32) {
+        const u8 *block = s + i - 31;
+        __m256i a = _mm256_loadu_si256((const __m256i*)block);
+        __m256i b = _mm256_loadu_si256(
+            (const __m256i*)(block + needle_len - 1)
+        );
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)
+        ));
+        while (mask != 0) {
+            isize bit = cy__u64_bit_len(mask) - 1;
+            if (cy__str_find_matches_at(block + bit, needle, needle_len)) {
+                return i - 31 + bit;
+            }
+
+            work += needle_len;
+            mask &= ~((u32)1 << bit);
+        }
+        if (work - (len - needle_len - i) > slack) {
+            *resume = i - 32 + needle_len;
+            return -1;
         }
+    }
 
-        cur_node->offset = cur_node->prev_offset;
-        cur_node->prev_offset = header->prev_offset;
-    } break;
-    case CY_ALLOCATION_FREE_ALL: {
-        CyStackNode *cur_node = stack->state.first_node, *next = cur_node->next;
-        while (next != NULL) {
-            cur_node = next;
-            next = next->next;
-            cy_free(stack->backing, cur_node);
+    return cy__str_find_last_scalar(s, needle, needle_len, i);
+}
+#endif
+
+/*
+ * The filter charges every candidate that doesn't pan out the needle's length
+ * and gives up once that's `slack` bytes more than the text it went through,
+ * returning -1 with `resume` (which has to start out negative) set to where
+ * Two-Way should pick up from: an offset going forwards, the length of the
+ * prefix left going backwards. Scalar builds give up on long needles right
+ * away, the skip table already beats checking every position there
+ *
+ * NOTE(cya): expects 0 < needle_len <= len
+ */
+cy_internal cy_inline isize cy__str_find_slack(isize needle_len)
+{
+    if (needle_len < CY__STR_FIND_TWO_WAY_MIN_LEN) {
+        return ISIZE_MAX;
+    }
+
+    return CY_MIN(needle_len, ISIZE_MAX / 16) * 16;
+}
+
+cy_internal isize cy__str_find(
+    const u8 *s, isize len, const u8 *needle, isize needle_len, isize *resume
+) {
+    isize slack = cy__str_find_slack(needle_len);
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__str_find_avx2(s, len, needle, needle_len, slack, resume);
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_find_sse2(s, len, needle, needle_len, slack, resume);
+#else
+    if (slack != ISIZE_MAX) {
+        *resume = 0;
+        return -1;
+    }
+
+    return cy__str_find_scalar(s, len, needle, needle_len, 0);
+#endif
+}
+
+cy_internal isize cy__str_find_last(
+    const u8 *s, isize len, const u8 *needle, isize needle_len, isize *resume
+) {
+    isize slack = cy__str_find_slack(needle_len);
+#if defined(CY__SIMD_AVX2)
+    if (cy__cpu_has_avx2()) {
+        return cy__str_find_last_avx2(
+            s, len, needle, needle_len, slack, resume
+        );
+    }
+#endif
+#if defined(CY__SIMD_SSE2)
+    return cy__str_find_last_sse2(s, len, needle, needle_len, slack, resume);
+#else
+    if (slack != ISIZE_MAX) {
+        *resume = len;
+        return -1;
+    }
+
+    return cy__str_find_last_scalar(s, needle, needle_len, len - needle_len);
+#endif
+}
+
+/*
+ * Two-Way (Crochemore-Perrin) string matching, plus a skip on the byte under
+ * the needle's last position like musl's memmem. Every proc takes a `step` so
+ * the same code searches backwards: with a step of -1 the needle and the text
+ * point to their last bytes and indices count from the end
+ */
+cy_internal isize cy__str_two_way_max_suffix(
+    const u8 *needle, isize needle_len, isize step, b32 flip, isize *period
+) {
+    isize i = -1, j = 0, k = 1, p = 1;
+    while (j + k < needle_len) {
+        u8 a = needle[(i + k) * step], b = needle[(j + k) * step];
+        if (a == b) {
+            if (k == p) {
+                j += p;
+                k = 1;
+            } else {
+                k += 1;
+            }
+        } else if ((a > b) != flip) {
+            j += k;
+            k = 1;
+            p = j - i;
+        } else {
+            i = j++;
+            k = p = 1;
         }
+    }
 
-        cur_node = stack->state.first_node;
-        cy_mem_set(cur_node->buf, 0, cur_node->size);
-        cur_node->prev_offset = cur_node->offset = 0;
-        cur_node->next = NULL;
-    } break;
-    case CY_ALLOCATION_RESIZE: {
-        if (old_mem == NULL || old_size == 0) {
-            return cy_alloc_align(a, size, align);
-        } else if (size == 0) {
-            cy_free(a, old_mem);
+    *period = p;
+    return i;
+}
+
+// NOTE(cya): skips are clamped, which only costs speed
+cy_internal CyPrivTwoWay cy__str_two_way_init(
+    const u8 *needle, isize needle_len, isize step, u32 *skip
+) {
+    u32 max_skip = (u32)CY_MIN(needle_len, (isize)U32_MAX);
+    for (isize i = 0; i < 256; i++) {
+        skip[i] = max_skip;
+    }
+    for (isize i = 0; i < needle_len; i++) {
+        u32 dist = (u32)CY_MIN(needle_len - 1 - i, (isize)U32_MAX);
+        skip[needle[i * step]] = dist;
+    }
+
+    isize period, flipped_period;
+    isize pos = cy__str_two_way_max_suffix(
+        needle, needle_len, step, false, &period
+    );
+    isize flipped_pos = cy__str_two_way_max_suffix(
+        needle, needle_len, step, true, &flipped_period
+    );
+    if (flipped_pos > pos) {
+        pos = flipped_pos;
+        period = flipped_period;
+    }
+
+    b32 periodic = true;
+    for (isize i = 0; i <= pos; i++) {
+        if (needle[i * step] != needle[(i + period) * step]) {
+            periodic = false;
             break;
         }
+    }
+
+    CyPrivTwoWay two_way = {
+        .critical_pos = pos,
+        .period = period,
+        .memory = needle_len - period,
+    };
+    if (!periodic) {
+        two_way.period = CY_MAX(pos, needle_len - pos - 1) + 1;
+        two_way.memory = 0;
+    }
+
+    return two_way;
+}
+
+cy_internal isize cy__str_two_way(
+    const u8 *s, isize len, const u8 *needle, isize needle_len, isize step,
+    const CyPrivTwoWay *two_way, const u32 *skip
+) {
+    isize pos = two_way->critical_pos, mem = 0;
+    for (isize i = 0; i <= len - needle_len;) {
+        isize shift = skip[s[(i + needle_len - 1) * step]];
+        if (shift != 0) {
+            i += CY_MAX(shift, mem);
+            mem = 0;
+            continue;
+        }
 
-        CyStackNode *cur_node = stack->state.first_node;
-        u8 *start = cur_node->buf;
-        u8 *end = start + cur_node->size;
-        u8 *cur_addr = old_mem;
-        if (!(start <= cur_addr && cur_addr < end)) {
-            CY_PANIC("stack allocator: out-of-bounds reallocation");
-            break;
+        isize k = CY_MAX(pos + 1, mem);
+        while (k < needle_len && needle[k * step] == s[(i + k) * step]) {
+            k += 1;
         }
-        if (cur_addr >= start + cur_node->offset) {
-            CY_PANIC("stack allocator: out-of-order reallocation");
-            break;
+        if (k < needle_len) {
+            i += k - pos;
+            mem = 0;
+            continue;
         }
 
-        b32 unchanged = old_size == size &&
-            old_mem == cy_align_forward_ptr(old_mem, align);
-        if (unchanged) {
-            return old_mem;
+        k = pos + 1;
+        while (k > mem && needle[(k - 1) * step] == s[(i + k - 1) * step]) {
+            k -= 1;
         }
-
-        CyStackHeader *header = (CyStackHeader*)(uintptr)cur_addr - 1;
-        isize cur_padding = header->padding;
-        u8 *alloc_start = cur_addr - cur_padding;
-        isize new_padding = cy_calc_header_padding(
-            (uintptr)alloc_start, align, cy_sizeof(*header)
-        );
-        if (size < old_size && new_padding == cur_padding) {
-            cur_node->offset -= (old_size - size);
-            return cy_align_forward_ptr(old_mem, align);
+        if (k <= mem) {
+            return i;
         }
 
-        isize prev_offset = (isize)(cur_addr - cur_padding - start);
-        isize new_offset = (isize)(alloc_start + new_padding + size - start);
-        if (new_offset <= cur_node->size) {
-            u8 *new_addr = alloc_start + new_padding;
-            header = (CyStackHeader*)(uintptr)new_addr - 1;
-            header->padding = new_padding;
-            header->prev_offset = prev_offset;
+        i += two_way->period;
+        mem = two_way->memory;
+    }
 
-            cur_node->offset = new_offset;
-            ptr = alloc_start;
-            break;
-        }
+    return -1;
+}
 
-        // NOTE(cya): not enough memory on current node
-        f64 largest_node_size = (f64)stack->state.first_node->size;
-        isize new_size = (isize)(largest_node_size * CY_STACK_GROWTH_FACTOR);
-        isize max_alloc_size = align + cy_sizeof(*header) + size;
+cy_internal isize cy__str_find_last_two_way(
+    const u8 *s, isize len, const u8 *needle, isize needle_len
+) {
+    u32 skip[256];
+    const u8 *needle_end = needle + needle_len - 1;
+    CyPrivTwoWay two_way = cy__str_two_way_init(
+        needle_end, needle_len, -1, skip
+    );
+    isize idx = cy__str_two_way(
+        s + len - 1, len, needle_end, needle_len, -1, &two_way, skip
+    );
+    return (idx < 0) ? -1 : len - idx - needle_len;
+}
 
-        CyStackNode *prev_node = cur_node;
-        cur_node = cy_stack_insert_node(
-            stack, CY_MAX(new_size, max_alloc_size)
-        );
-        CY_VALIDATE_PTR(cur_node);
+/* ================================ Strings ================================= */
+cy_inline isize cy_string_len(CyString str)
+{
+    return (str == NULL) ? 0 : CY_STRING_HEADER(str)->len;
+}
 
-        cur_addr = cur_node->buf;
-        new_padding = cy_calc_header_padding(
-            (uintptr)cur_addr, align, cy_sizeof(*header)
-        );
+cy_inline isize cy_string_cap(CyString str)
+{
+    return (str == NULL) ? 0 : CY_STRING_HEADER(str)->cap;
+}
 
-        ptr = cur_addr + new_padding;
-        cy_mem_copy(ptr, old_mem, old_size);
+cy_inline isize cy_string_alloc_size(CyString str)
+{
+    return cy_sizeof(CyStringHeader) + cy_string_cap(str) + 1;
+}
 
-        // NOTE(cya): manually freeing memory from old node to avoid bounds
-        // checking from free procedure
-        CyStackHeader *old_header = (CyStackHeader*)old_mem - 1;
-        prev_node->offset = prev_node->prev_offset;
-        prev_node->prev_offset = old_header->prev_offset;
+cy_inline isize cy_string_available_space(CyString str)
+{
+    CyStringHeader *h = CY_STRING_HEADER(str);
+    if (h->cap > h->len) {
+        return h->cap - h->len;
+    }
 
-        header = (CyStackHeader*)ptr - 1;
-        header->padding = new_padding;
-        header->prev_offset = cur_node->offset;
+    return 0;
+}
 
-        cur_node->offset += new_padding + size;
-    } break;
+cy_inline void cy__string_set_len(CyString str, isize len)
+{
+    if (str == NULL) {
+        return;
     }
 
-    return ptr;
+    CY_STRING_HEADER(str)->len = len;
 }
 
-/* ----------------------------- Pool Allocator ----------------------------- */
-cy_inline CyAllocator cy_pool_allocator(CyPool *pool)
+cy_inline void cy__string_set_cap(CyString str, isize cap)
 {
-    return (CyAllocator){
-        .proc = cy_pool_allocator_proc,
-        .data = pool,
+    if (str == NULL) {
+        return;
+    }
+
+    CY_STRING_HEADER(str)->cap = cap;
+}
+
+CyString cy_string_create_reserve(CyAllocator a, isize cap)
+{
+    isize header_size = cy_sizeof(CyStringHeader);
+    isize total_size = header_size + cap + 1;
+    void *ptr = cy_alloc(a, total_size);
+    CY_VALIDATE_PTR(ptr);
+
+    cy_mem_zero(ptr, total_size);
+
+    CyStringHeader *header = ptr;
+    *header = (CyStringHeader){
+        .alloc = a,
+        .len = 0,
+        .cap = cap,
     };
+
+    return (CyString)ptr + header_size;
 }
 
+CyString cy_string_create_len(CyAllocator a, const char *str, isize len)
+{
+    isize header_size = cy_sizeof(CyStringHeader);
+    isize total_size = header_size + len + 1;
+    void *ptr = cy_alloc(a, total_size);
+    CY_VALIDATE_PTR(ptr);
+
+    if (str == NULL) {
+        cy_mem_zero(ptr, total_size);
+    }
 
-cy_inline CyPool cy_pool_init(CyAllocator backing, isize chunks, isize chunk_size)
+    CyStringHeader *header = ptr;
+    *header = (CyStringHeader){
+        .alloc = a,
+        .len = len,
+        .cap = len,
+    };
+
+    CyString string = (CyString)ptr + header_size;
+    if (len > 0 && str != NULL) {
+        cy_mem_copy(string, str, len);
+    }
+
+    string[len] = '\0';
+    return string;
+}
+
+cy_inline CyString cy_string_create(CyAllocator a, const char *str)
 {
-    return cy_pool_init_align(
-        backing, chunks, chunk_size, CY_DEFAULT_ALIGNMENT
-    );
+    return cy_string_create_len(a, str, cy_str_len(str));
 }
 
-cy_inline CyPool cy_pool_init_align(
-    CyAllocator backing, isize chunks, isize chunk_size, isize chunk_align
-) {
-    CyPool pool = {0};
-    if (chunk_size < cy_sizeof(uintptr)) {
-        CY_PANIC("pool allocator: chunk size is too small");
-        return pool;
+cy_inline CyString cy_string_create_view(CyAllocator a, CyStringView str)
+{
+    return cy_string_create_len(a, (const char*)str.text, str.len);
+}
+
+CyString cy_string_reserve_space_for(CyString str, isize extra_len)
+{
+    isize available = cy_string_available_space(str);
+    if (available >= extra_len) {
+        return str;
     }
 
-    isize chunk_size_total = chunk_size + chunk_align;
-    isize buf_size = chunks * chunk_size_total;
-    void *buf = cy_alloc_align(backing, buf_size, chunk_align);
-    if (buf == NULL) {
-        buf_size = 0;
-        chunk_size = 0;
+    void *mem = CY_STRING_HEADER(str);
+    CyStringHeader *header = mem;
+    CyAllocator a = header->alloc;
+
+    isize new_cap = cy_string_len(str) + extra_len;
+    isize old_size = cy_sizeof(*header) + cy_string_cap(str) + 1;
+    isize new_size = cy_sizeof(*header) + new_cap + 1;
+
+    void *new_mem = cy_resize(a, mem, old_size, new_size);
+    CY_VALIDATE_PTR(new_mem);
+
+    header = new_mem;
+    header->alloc = a;
+
+    str = (CyString)(header + 1);
+    cy__string_set_cap(str, new_cap);
+    return str;
+}
+
+CyString cy_string_shrink(CyString str)
+{
+    CY_VALIDATE_PTR(str);
+
+    isize len = cy_string_len(str), cap = cy_string_cap(str);
+    isize header_size = cy_sizeof(CyStringHeader);
+    isize size = header_size + cap + 1;
+    isize new_size = header_size + len + 1;
+    void *ptr = str - header_size;
+    if (new_size < size) {
+        ptr = cy_resize(CY_STRING_HEADER(str)->alloc, ptr, size, new_size);
+        str = (CyString)ptr + header_size;
+        cy__string_set_cap(str, len);
     }
 
-    pool = (CyPool){
-        .backing = backing,
-        .memory = buf,
-        .free_list_head = buf,
-        .chunks = chunks,
-        .chunk_size = chunk_size,
-        .chunk_align = chunk_align,
-    };
-    CyAllocator a = cy_pool_allocator(&pool);
-    cy_free_all(a);
+    return str;
+}
 
-    return pool;
+cy_inline void cy_string_free(CyString str)
+{
+    if (str != NULL) {
+        cy_free(CY_STRING_HEADER(str)->alloc, CY_STRING_HEADER(str));
+    }
 }
 
-cy_inline void cy_pool_deinit(CyPool *pool)
+CyString cy_string_append_len(CyString str, const char *other, isize len)
 {
-    if (pool == NULL) {
-        return;
+    if (len > 0) {
+        isize cur_len = cy_string_len(str);
+
+        str = cy_string_reserve_space_for(str, len);
+        CY_VALIDATE_PTR(str);
+
+        cy_mem_copy(str + cur_len, other, len);
+
+        isize new_len = cur_len + len;
+        str[new_len] = '\0';
+
+        cy__string_set_len(str, new_len);
     }
 
-    cy_free(pool->backing, pool->memory);
-    cy_mem_set(pool, 0, cy_sizeof(*pool));
+    return str;
 }
 
-CY_ALLOCATOR_PROC(cy_pool_allocator_proc)
+cy_inline CyString cy_string_append(CyString str, const CyString other)
 {
-    CY_UNUSED(old_size);
+    return cy_string_append_len(str, other, cy_string_len(other));
+}
 
-    CyPool *pool = allocator_data;
-    void *ptr = NULL;
-    switch (type) {
-    case CY_ALLOCATION_ALLOC: {
-        CY_ASSERT(size == pool->chunk_size);
-        CY_ASSERT(align == pool->chunk_align);
-        if (pool->free_list_head == NULL) {
-            CY_PANIC("pool allocator: out of memory");
-            break;
-        }
+cy_inline CyString cy_string_append_c(CyString str, const char *other)
+{
+    return cy_string_append_len(str, other, cy_str_len(other));
+}
 
-        ptr = pool->free_list_head;
+cy_inline CyString cy_string_append_rune(CyString str, Rune r)
+{
+    // TODO(cya): utf-8 encode rune
+    return cy_string_append_len(str, (const char*)&r, 1);
+}
 
-        uintptr *next_free = (uintptr*)pool->free_list_head;
-        pool->free_list_head = (void*)*next_free;
-        if (flags & CY_ALLOCATOR_CLEAR_TO_ZERO) {
-            cy_mem_zero(ptr, size);
-        }
-    } break;
-    case CY_ALLOCATION_FREE: {
-        if (old_mem == NULL) {
-            break;
-        }
+cy_inline CyString cy_string_append_fmt(CyString str, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    str = cy_string_append_fmt_va(str, fmt, va);
+    va_end(va);
+
+    return str;
+}
+
+typedef struct {
+    CyString str;
+    isize base_len;
+} CyPrivFmtStringSink;
+
+// NOTE(cya): doubles the string's capacity (the header's len isn't updated
+// until the formatting is done, so it's still the length before it started)
+cy_internal CY__FMT_FLUSH_PROC(cy__fmt_flush_string)
+{
+    CyPrivFmtStringSink *sink = w->sink;
+    isize cap = cy_string_cap(sink->str);
+    isize new_cap = CY_MAX(cap * 2, sink->base_len + w->written + 64);
+    CyString str = cy_string_reserve_space_for(
+        sink->str, new_cap - sink->base_len
+    );
+    if (str == NULL) {
+        return false;
+    }
+
+    sink->str = str;
+    w->buf = str + sink->base_len;
+    w->end = w->buf + w->written;
+    w->limit = new_cap - sink->base_len;
+
+    return true;
+}
 
-        isize chunk_size_total = pool->chunk_size + pool->chunk_align;
-        isize pool_size = pool->chunks * chunk_size_total;
-        void *pool_end = (void*)((uintptr)pool->memory + (uintptr)pool_size);
-        if (old_mem < pool->memory || old_mem > pool_end) {
-            CY_PANIC("pool allocator: out-of-bounds free");
-            break;
-        }
+// NOTE(cya): formats straight into the string's spare capacity
+CyString cy_string_append_fmt_va(CyString str, const char *fmt, va_list va)
+{
+    CyPrivFmtStringSink sink = {
+        .str = str,
+        .base_len = cy_string_len(str),
+    };
+    CyPrivFmtWriter w;
+    cy__fmt_writer_init(
+        &w, str + sink.base_len, cy_string_available_space(str) + 1
+    );
+    w.flush = cy__fmt_flush_string;
+    w.sink = &sink;
 
-        uintptr *next_free = (uintptr*)old_mem;
-        *next_free = (uintptr)pool->free_list_head;
-        pool->free_list_head = (void*)next_free;
-    } break;
-    case CY_ALLOCATION_FREE_ALL: {
-        isize chunk_size_total = pool->chunk_size + pool->chunk_align;
-        void *cur_chunk = pool->memory;
-        for (isize i = 0; i < pool->chunks - 1; i++) {
-            uintptr *next = (uintptr*)cur_chunk;
-            *next = (uintptr)cur_chunk + (uintptr)chunk_size_total;
-            cur_chunk = (void*)(*next);
-        }
+    b32 ok = cy__fmt_format(&w, fmt, va) && !w.flush_failed;
+    cy__fmt_writer_finish(&w);
 
-        uintptr *end = (uintptr*)cur_chunk;
-        *end = (uintptr)NULL; // NOTE(cya): free list tail
-    } break;
-    case CY_ALLOCATION_ALLOC_ALL:
-    case CY_ALLOCATION_RESIZE: {
-        CY_PANIC("pool allocator: unsupported operation");
-    } break;
+    if (!ok) {
+        return NULL;
     }
 
-    return ptr;
+    str = sink.str;
+    cy__string_set_len(str, sink.base_len + w.written);
+    return str;
 }
 
-/* ============================== Char procs =============================== */
-const char *cy_char_first_occurence(const char *str, char c)
+cy_inline CyString cy_string_append_view(CyString str, CyStringView view)
 {
-    for (; *str != c; str++) {
-        if (*str == '\0')  {
-            return NULL;
-        }
+    return cy_string_append_len(str, (const char*)view.text, view.len);
+}
+
+CyString cy_string_prepend_len(CyString str, const char *other, isize len)
+{
+    if (len > 0) {
+        isize cur_len = cy_string_len(str);
+
+        str = cy_string_reserve_space_for(str, len);
+        CY_VALIDATE_PTR(str);
+
+        isize new_len = cur_len + len;
+        cy_mem_move(str + len, str, cur_len);
+        cy_mem_copy(str, other, len);
+
+        str[new_len] = '\0';
+        cy__string_set_len(str, new_len);
     }
 
     return str;
 }
 
-const char *cy_char_last_occurence(const char *str, char c)
+cy_inline CyString cy_string_prepend(CyString str, const CyString other)
 {
-    const char *res = NULL;
-    do {
-        if (*str == c) {
-            res = str;
-        }
-    } while (*str++ != '\0');
+    return cy_string_prepend_len(str, other, cy_string_len(other));
+}
 
-    return res;
+cy_inline CyString cy_string_prepend_c(CyString str, const char *other)
+{
+    return cy_string_prepend_len(str, other, cy_str_len(other));
 }
 
-cy_inline b32 cy_char_is_digit(char c)
+cy_inline CyString cy_string_prepend_rune(CyString str, Rune r)
 {
-    return (u8)(c - '0') < 10;
+    // TODO(cya): utf-8 encode rune
+    isize width = 1;
+    return cy_string_prepend_len(str, (const char*)&r, width);
 }
 
-cy_inline b32 cy_char_is_hex_digit(char c)
+cy_inline CyString cy_string_prepend_fmt(CyString str, const char *fmt, ...)
 {
-    return cy_char_is_digit(c) ||
-        CY_IS_IN_RANGE_INCL(c, 'a', 'f') ||
-        CY_IS_IN_RANGE_INCL(c, 'A', 'F');
+    va_list va;
+    va_start(va, fmt);
+    str = cy_string_prepend_fmt_va(str, fmt, va);
+    va_end(va);
+
+    return str;
 }
 
-cy_inline b32 cy_char_is_lower(char c)
+CyString cy_string_prepend_fmt_va(CyString str, const char *fmt, va_list va)
 {
-    return CY_IS_IN_RANGE_INCL(c, 'a', 'z');
+    isize old_len = cy_string_len(str);
+    str = cy_string_append_fmt_va(str, fmt, va);
+    CY_VALIDATE_PTR(str);
+
+    // NOTE(cya): rotates the appended text to the front (in place)
+    isize len = cy_string_len(str), fmt_len = len - old_len;
+    if (fmt_len > 0 && old_len > 0) {
+        cy_str_reverse_n(str, len);
+        cy_str_reverse_n(str, fmt_len);
+        cy_str_reverse_n(str + fmt_len, old_len);
+    }
+
+    return str;
 }
 
-cy_inline b32 cy_char_is_upper(char c)
+cy_inline CyString cy_string_prepend_view(CyString str, CyStringView view)
 {
-    return c - 0x41 < 26;
+    return cy_string_prepend_len(str, (const char*)view.text, view.len);
 }
 
-cy_inline b32 cy_char_is_in_set(char c, const char *cut_set)
+CyString cy_string_pad_right(CyString str, isize width, Rune r)
 {
-    while (*cut_set != '\0') {
-        if (c == *cut_set++) {
-            return true;
-        }
+    // TODO(cya): calculate width with utf8_width proc (to be implemented)
+    isize str_width = cy_utf8_codepoints(str);
+    isize rune_width = 1;
+    while (str_width < width) {
+        str = cy_string_append_rune(str, r);
+        str_width += rune_width;
     }
 
-    return false;
+    return str;
 }
 
-cy_inline char cy_char_to_lower(char c) {
-    return cy_char_is_upper(c) ? c + ('a' - 'A') : c;
-}
+CyString cy_string_set(CyString str, const char *c_str)
+{
+    isize new_len = cy_str_len(c_str);
+    if (cy_string_cap(str) < new_len) {
+        str = cy_string_reserve_space_for(str, new_len - cy_string_len(str));
+        CY_VALIDATE_PTR(str);
+    }
 
-cy_inline char cy_char_to_upper(char c) {
-    return cy_char_is_lower(c) ? c - ('a' - 'A') : c;
+    cy_mem_copy(str, c_str, new_len + 1);
+    cy__string_set_len(str, new_len);
+
+    return str;
 }
 
-cy_inline i64 cy_digit_to_i64(char digit)
+CyString cy_string_dup(CyAllocator a, const CyString src)
 {
-    return cy_char_is_digit(digit) ? digit - '0' : digit - 'W';
+    return cy_string_create_len(a, src, cy_string_len(src));
 }
 
-cy_inline i64 cy_hex_digit_to_i64(char digit)
+b32 cy_string_are_equal(const CyString a, const CyString b)
 {
-    if (cy_char_is_digit(digit)) {
-        return digit - '0';
-    } else if (CY_IS_IN_RANGE_INCL(digit, 'a', 'f')) {
-        return 10 + digit - 'a';
-    } else if (CY_IS_IN_RANGE_INCL(digit, 'A', 'F')) {
-        return 10 + digit - 'A';
+    isize a_len = cy_string_len(a);
+    isize b_len = cy_string_len(b);
+    if (a_len != b_len) {
+        return false;
     }
 
-    return -1;
+    return cy_mem_compare(a, b, a_len) == 0;
 }
 
-/* ============================ C-String procs ============================== */
-cy_inline isize cy_str_len(const char *str)
+CyString cy__string_trim_internal(CyString str, const char *cut_set, i32 flags)
 {
-    if (str == NULL) {
-        return 0;
+    CyCharSet set = cy_char_set_create(cut_set);
+    CyStringView view = cy_string_view_create(str);
+    if (flags & CY__STRING_TRIM_LEADING) {
+        view = cy_string_view_trim_leading(view, &set);
     }
-
-    const char *begin = str;
-    while (!CY__IS_WORD_ALIGNED(str)) {
-        if (*str == '\0') {
-            return str - begin;
-        }
-
-        str += 1;
+    if (flags & CY__STRING_TRIM_TRAILING) {
+        view = cy_string_view_trim_trailing(view, &set);
     }
 
-    const isize *w = (const isize*)str;
-    while (!CY__HAS_ZERO_BYTE(*w)) {
-        w += 1;
+    if (view.text != (const u8*)str) {
+        cy_mem_move(str, view.text, view.len);
     }
 
-    str = (const char*)w;
-    while (*str != '\0') {
-        str += 1;
-    }
+    str[view.len] = '\0';
+    cy__string_set_len(str, view.len);
+    return str;
+}
 
-    return str - begin;
+cy_inline CyString cy_string_trim(CyString str, const char *char_set)
+{
+    return cy__string_trim_internal(
+        str, char_set, CY__STRING_TRIM_LEADING | CY__STRING_TRIM_TRAILING
+    );
 }
 
-cy_inline isize cy_wcs_len(const wchar_t *str)
+cy_inline CyString cy_string_trim_leading(CyString str, const char *char_set)
 {
-    if (str == NULL) {
-        return 0;
-    }
+    return cy__string_trim_internal(str, char_set, CY__STRING_TRIM_LEADING);
+}
 
-    const wchar_t *begin = str;
-    while (!CY__IS_WORD_ALIGNED(str)) {
-        if (*str == '\0') {
-            return str - begin;
-        }
+cy_inline CyString cy_string_trim_trailing(CyString str, const char *char_set)
+{
+    return cy__string_trim_internal(str, char_set, CY__STRING_TRIM_TRAILING);
+}
 
-        str += 1;
-    }
+#define CY__WHITESPACE " \t\r\n\v\f"
 
-    const isize *w = (const isize*)str;
-    while (!CY__HAS_ZERO_BYTE(*w)) {
-        w += 1;
-    }
+cy_inline CyString cy_string_trim_whitespace(CyString str)
+{
+    return cy_string_trim(str, CY__WHITESPACE);
+}
 
-    str = (const wchar_t*)w;
-    while (*str != '\0') {
-        str += 1;
+cy_inline CyString cy_string_trim_leading_whitespace(CyString str)
+{
+    return cy_string_trim_leading(str, CY__WHITESPACE);
+}
+
+cy_inline CyString cy_string_trim_trailing_whitespace(CyString str)
+{
+    return cy_string_trim_trailing(str, CY__WHITESPACE);
+}
+
+/* ----------------------------- String views ------------------------------- */
+CyStringView cy_string_view_create_len(const char *str, isize len)
+{
+    if (len < 0) {
+        len = cy_str_len(str);
     }
 
-    return str - begin;
+    return (CyStringView){
+        .text = (const u8*)str,
+        .len = len,
+    };
+}
+
+CyStringView cy_string_view_create(CyString str)
+{
+    return cy_string_view_create_len(str, cy_string_len(str));
+}
+
+CyStringView cy_string_view_create_c(const char *str)
+{
+    return cy_string_view_create_len(str, cy_str_len(str));
+}
+
+CyStringView cy_string_view_substring(
+    CyStringView str, isize begin_idx, isize end_idx
+) {
+    isize max = str.len, lo = begin_idx, hi = end_idx;
+    CY_ASSERT_MSG(lo <= hi && hi <= max, "%td..%td..%td", lo, hi, max);
+
+    return cy_string_view_create_len((const char*)str.text + lo, hi - lo);
+}
+
+cy_inline b32 cy_string_view_are_equal(CyStringView a, CyStringView b)
+{
+    return (a.len == b.len) && (cy_mem_compare(a.text, b.text, a.len) == 0);
+}
+
+cy_inline b32 cy_string_view_has_prefix(CyStringView str, const char *prefix)
+{
+    CyStringView other = cy_string_view_create_c(prefix);
+    return cy_string_view_are_equal(
+        cy_string_view_create_len((const char*)str.text, other.len), other
+    );
 }
 
-cy_inline char *cy_str_copy(char *dst, const char *src)
+b32 cy_string_view_contains(CyStringView str, const char *char_set)
 {
-    while (!CY__IS_WORD_ALIGNED(src)) {
-        if (*src == '\0') {
-            *dst = '\0';
-            return dst;
-        }
-
-        *dst++ = *src++;
-    }
+    // TODO(cya): unicode rune support
+    CyCharSet set = cy_char_set_create(char_set);
+    return cy_string_view_index_any(str, &set) >= 0;
+}
 
-    isize *wd = (isize*)dst;
-    const isize *ws = (const isize*)src;
-    while (!CY__HAS_ZERO_BYTE(*ws)) {
-        *wd++ = *ws++;
+CyParseError cy_string_view_to_u64(
+    CyStringView str, i32 base, u64 *value, isize *len_out
+) {
+    u64 res;
+    isize len;
+    CyParseError err = cy__parse_u64(str.text, str.len, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
     }
-
-    dst = (char*)wd;
-    src = (const char*)ws;
-    while (*src != '\0') {
-        *dst++ = *src++;
+    if (len_out != NULL) {
+        *len_out = len;
     }
 
-    *dst = '\0';
-    return dst;
+    return err;
 }
 
-cy_inline isize cy_str_compare(const char *a, const char *b) {
-    while (*a != '\0' && *a == *b) {
-        a += 1, b += 1;
+CyParseError cy_string_view_to_i64(
+    CyStringView str, i32 base, i64 *value, isize *len_out
+) {
+    i64 res;
+    isize len;
+    CyParseError err = cy__parse_i64(str.text, str.len, base, &res, &len);
+    if (value != NULL) {
+        *value = res;
+    }
+    if (len_out != NULL) {
+        *len_out = len;
     }
 
-    return *(const u8*)a - *(const u8*)b;
+    return err;
 }
 
-cy_inline isize cy_str_compare_n(const char *a, const char *b, isize len)
+isize cy_string_view_index_any(CyStringView str, const CyCharSet *set)
 {
-    while (len > 0) {
-        if (*a != *b) {
-            return *(const u8*)a - *(const u8*)b;
-        }
-
-        a += 1, b += 1;
-        len -= 1;
-    }
-
-    return 0;
+    isize idx = cy__char_set_find(str.text, str.len, set, true);
+    return (idx < str.len) ? idx : -1;
 }
 
-cy_inline b32 cy_str_has_prefix(const char *str, const char *prefix)
+isize cy_string_view_last_index_any(CyStringView str, const CyCharSet *set)
 {
-    while (*prefix != '\0') {
-        if (*str++ != *prefix++) {
-            return false;
-        }
-    }
+    return cy__char_set_find_last(str.text, str.len, set, true);
+}
 
-    return true;
+cy_inline isize cy_string_view_span(CyStringView str, const CyCharSet *set)
+{
+    return cy__char_set_find(str.text, str.len, set, false);
 }
 
-cy_inline char *cy_str_reverse(char *str)
+cy_inline isize cy_string_view_span_not(CyStringView str, const CyCharSet *set)
 {
-    char *s = str, *e = str + cy_str_len(str) - 1;
-    while (s < e) {
-        CY_SWAP(char, *s, *e);
-        s += 1, e -= 1;
-    }
+    return cy__char_set_find(str.text, str.len, set, true);
+}
 
-    return str;
+CyStringView cy_string_view_trim_leading(
+    CyStringView str, const CyCharSet *set
+) {
+    isize start = cy_string_view_span(str, set);
+    return cy_string_view_substring(str, start, str.len);
 }
 
-cy_inline char *cy_str_reverse_n(char *str, isize len)
-{
-    char *s = str, *e = str + len - 1;
-    while (s < e) {
-        CY_SWAP(char, *s, *e);
-        s += 1, e -= 1;
-    }
+CyStringView cy_string_view_trim_trailing(
+    CyStringView str, const CyCharSet *set
+) {
+    isize end = cy__char_set_find_last(str.text, str.len, set, false) + 1;
+    return cy_string_view_substring(str, 0, end);
+}
 
-    return str;
+cy_inline CyStringView cy_string_view_trim(
+    CyStringView str, const CyCharSet *set
+) {
+    return cy_string_view_trim_trailing(
+        cy_string_view_trim_leading(str, set), set
+    );
 }
 
-cy_inline void cy_str_to_lower(char *str)
-{
-    if (str == NULL) {
-        return;
-    }
+CyStringView cy_string_view_next_token(
+    CyStringView *str, const CyCharSet *delims
+) {
+    CyStringView rest = cy_string_view_trim_leading(*str, delims);
+    isize len = cy_string_view_span_not(rest, delims);
 
-    for (; *str != '\0'; str++) {
-        *str = cy_char_to_lower(*str);
-    }
+    *str = cy_string_view_substring(rest, len, rest.len);
+    return cy_string_view_substring(rest, 0, len);
 }
 
-cy_inline void cy_str_to_upper(char *str)
+// NOTE(cya): Two-Way over the rest of the string once the filter gave up
+cy_internal isize cy__string_searcher_index_from(
+    const CyStringSearcher *searcher, CyStringView str, isize start
+) {
+    CyStringView needle = searcher->needle;
+    isize idx = cy__str_two_way(
+        str.text + start, str.len - start, needle.text, needle.len, 1,
+        &searcher->two_way, searcher->skip
+    );
+    return (idx < 0) ? -1 : start + idx;
+}
+
+isize cy_string_view_index(CyStringView str, CyStringView needle)
 {
-    if (str == NULL) {
-        return;
+    if (needle.len == 0) {
+        return 0;
+    } else if (needle.len > str.len) {
+        return -1;
     }
 
-    for (; *str != '\0'; str++) {
-        *str = cy_char_to_upper(*str);
+    isize resume = -1;
+    isize idx = cy__str_find(
+        str.text, str.len, needle.text, needle.len, &resume
+    );
+    if (resume < 0) {
+        return idx;
     }
+
+    CyStringSearcher searcher = cy_string_searcher_create(needle);
+    return cy__string_searcher_index_from(&searcher, str, resume);
 }
 
-u64 cy_str_to_u64(const char *str, i32 base, isize *len_out)
+isize cy_string_view_last_index(CyStringView str, CyStringView needle)
 {
-    if (base == 0) {
-        base = (cy_str_has_prefix(str, "0x")) ?  16 : 10;
+    if (needle.len == 0) {
+        return str.len;
+    } else if (needle.len > str.len) {
+        return -1;
     }
 
-    u64 res;
-    isize len = cy__scan_u64(str, base, &res);
-    if (len_out != NULL) {
-        *len_out = len;
+    isize resume = -1;
+    isize idx = cy__str_find_last(
+        str.text, str.len, needle.text, needle.len, &resume
+    );
+    if (resume < 0) {
+        return idx;
     }
 
-    return res;
+    return cy__str_find_last_two_way(
+        str.text, resume, needle.text, needle.len
+    );
 }
 
-i64 cy_str_to_i64(const char *str, i32 base, isize *len_out)
+isize cy_string_view_count(CyStringView str, CyStringView needle)
 {
-    if (base == 0) {
-        const char *s = str;
-        if (*s == '-') {
-            s += 1;
-        }
-
-        base = (cy_str_has_prefix(s, "0x")) ? 16 : 10;
-    }
+    CyStringSearcher searcher = cy_string_searcher_create(needle);
+    return cy_string_searcher_count(&searcher, str);
+}
 
-    i64 res;
-    isize len = cy__scan_i64(str, base, &res);
-    if (len_out != NULL) {
-        *len_out = len;
+CyStringSearcher cy_string_searcher_create(CyStringView needle)
+{
+    CyStringSearcher searcher = {.needle = needle};
+    if (needle.len >= CY__STR_FIND_TWO_WAY_MIN_LEN) {
+        searcher.two_way = cy__str_two_way_init(
+            needle.text, needle.len, 1, searcher.skip
+        );
     }
 
-    return res;
+    return searcher;
 }
 
-// TODO(cya): rework the parsing procedures
+isize cy_string_searcher_index(
+    const CyStringSearcher *searcher, CyStringView str
+) {
+    CyStringView needle = searcher->needle;
+    if (needle.len == 0) {
+        return 0;
+    } else if (needle.len > str.len) {
+        return -1;
+    }
 
-isize cy_str_parse_u64(u64 n, i32 base, char *dst)
-{
-    char *c = dst;
-    if (n == 0) {
-        *c++ = '0';
-    } else {
-        while (n > 0) {
-            *c++ = cy__num_to_char_table_upper[n % (u64)base];
-            n /= (u64)base;
-        }
+    isize resume = -1;
+    isize idx = cy__str_find(
+        str.text, str.len, needle.text, needle.len, &resume
+    );
+    if (resume < 0) {
+        return idx;
     }
 
-    *c = '\0';
-    cy_str_reverse(dst);
+    return cy__string_searcher_index_from(searcher, str, resume);
+}
 
-    return c - dst;
+cy_inline isize cy_string_searcher_last_index(
+    const CyStringSearcher *searcher, CyStringView str
+) {
+    return cy_string_view_last_index(str, searcher->needle);
 }
 
-isize cy_str_parse_i64(i64 n, i32 base, char *dst)
-{
-    b32 negative = false;
-    if (n < 0) {
-        negative = true;
-        n = -n;
+isize cy_string_searcher_count(
+    const CyStringSearcher *searcher, CyStringView str
+) {
+    isize needle_len = searcher->needle.len;
+    if (needle_len == 0) {
+        return str.len + 1;
     }
 
-    u64 v = (u64)n;
-    char *c = dst;
-    if (v == 0) {
-        *c++ = '0';
-    } else {
-        while (v > 0) {
-            *c++ = cy__num_to_char_table_upper[v % (u64)base];
-            v /= (u64)base;
+    isize count = 0;
+    for (;;) {
+        isize idx = cy_string_searcher_index(searcher, str);
+        if (idx < 0) {
+            break;
         }
+
+        count += 1;
+        str = cy_string_view_substring(str, idx + needle_len, str.len);
     }
 
-    if (negative) {
-        *c++ = '-';
+    return count;
+}
+
+/* ------------------------------- Splitting -------------------------------- */
+// NOTE(cya): delimiter positions in the block at `p` (short blocks are fine)
+cy_internal u64 cy__string_split_block_mask(
+    const CyStringSplitIter *iter, const u8 *p
+) {
+    isize avail = iter->end - p;
+    if (avail >= 64) {
+        return (iter->kind == CY__STRING_SPLIT_BYTE) ?
+            cy__byte_block_mask(p, iter->delim) :
+            cy__char_set_block_mask(p, &iter->set);
     }
 
-    *c = '\0';
-    cy_str_reverse(dst);
+    u64 mask = 0;
+    for (isize i = 0; i < avail; i++) {
+        b32 hit = (iter->kind == CY__STRING_SPLIT_BYTE) ?
+            p[i] == iter->delim : cy_char_set_has(&iter->set, p[i]);
+        mask |= (u64)hit << i;
+    }
 
-    return c - dst;
+    return mask;
 }
 
-cy_inline f32 cy_str_to_f32(const char *str, isize *len_out)
+cy_internal CyStringSplitIter cy__string_split_create(
+    CyStringView str, u8 kind
+) {
+    CyStringSplitIter iter = {
+        .cur = str.text,
+        .end = str.text + str.len,
+        .block = str.text,
+        .kind = kind,
+    };
+    return iter;
+}
+
+CyStringSplitIter cy_string_split_by_byte(CyStringView str, u8 delim)
 {
-    return (f32)cy_str_to_f64(str, len_out);
+    CyStringSplitIter iter = cy__string_split_create(
+        str, CY__STRING_SPLIT_BYTE
+    );
+    iter.delim = delim;
+    iter.mask = cy__string_split_block_mask(&iter, iter.block);
+    return iter;
 }
 
-f64 cy_str_to_f64(const char *str, isize *len_out)
+CyStringSplitIter cy_string_split_by_separator(
+    CyStringView str, CyStringView separator
+) {
+    CyStringSplitIter iter = cy__string_split_create(
+        str, CY__STRING_SPLIT_SEPARATOR
+    );
+    iter.separator = separator;
+    return iter;
+}
+
+CyStringSplitIter cy_string_split_by_set(
+    CyStringView str, const CyCharSet *set
+) {
+    CyStringSplitIter iter = cy__string_split_create(
+        str, CY__STRING_SPLIT_SET
+    );
+    iter.set = *set;
+    iter.mask = cy__string_split_block_mask(&iter, iter.block);
+    return iter;
+}
+
+b32 cy_string_split_next(CyStringSplitIter *iter, CyStringView *token)
 {
-    const char *s = str;
-    i32 sign = 1;
-    if (*s == '-') {
-        sign = -sign;
-        s += 1;
-    } else if (*s == '+') {
-        s += 1;
+    if (iter->done) {
+        return false;
     }
 
-    f64 val;
-    for (val = 0.0; cy_char_is_digit(*s); s++) {
-        val = val * 10.0 + (*s - '0');
+    const u8 *start = iter->cur;
+    if (iter->kind == CY__STRING_SPLIT_SEPARATOR) {
+        CyStringView rest = {.text = start, .len = iter->end - start};
+        isize idx = (iter->separator.len == 0) ?
+            -1 : cy_string_view_index(rest, iter->separator);
+        if (idx < 0) {
+            *token = rest;
+            iter->done = true;
+        } else {
+            *token = cy_string_view_substring(rest, 0, idx);
+            iter->cur = start + idx + iter->separator.len;
+        }
+
+        return true;
     }
 
-    if (*s == '.') {
-        s += 1;
-        f64 place = 0.1;
-        while (cy_char_is_digit(*s)) {
-            val += (*s - '0') * place;
-            place *= 0.1;
-            s += 1;
+    while (iter->mask == 0) {
+        if (iter->end - iter->block <= 64) {
+            token->text = start;
+            token->len = iter->end - start;
+            iter->done = true;
+            return true;
         }
+
+        iter->block += 64;
+        iter->mask = cy__string_split_block_mask(iter, iter->block);
     }
 
-    i32 frac = 0;
-    f64 scale = 1.0;
-    if (*s == 'e' || *s == 'E') {
-        s += 1;
-        if (*s == '-') {
-            frac = 1;
-            s += 1;
-        } else if (*s == '+') {
-            s += 1;
-        }
+    const u8 *delim = iter->block + cy__u64_trailing_zeros(iter->mask);
+    iter->mask &= iter->mask - 1;
 
-        u32 exp;
-        for (exp = 0; cy_char_is_digit(*s); s++) {
-            exp = exp * 10 + (u32)(*s - '0');
-        }
+    token->text = start;
+    token->len = delim - start;
+    iter->cur = delim + 1;
+    return true;
+}
 
-        // NOTE(cya): faster exponent calc
-        while (exp >= 50) {
-            scale *= 1e50;
-            exp -= 50;
-        }
-        while (exp >= 8) {
-            scale *= 1e8;
-            exp -= 8;
-        }
-        while (exp >= 1) {
-            scale *= 10.0;
-            exp -= 1;
+/* ------------------- Multi-pattern search (Aho-Corasick) ------------------ */
+#define CY__AC_NONE U32_MAX
+// NOTE(cya): set on transitions into states that have matches (own or suffix)
+#define CY__AC_MATCH_BIT ((u32)1 << 31)
+
+CyAhoCorasick cy_aho_corasick_create(
+    CyArena *arena, const CyStringView *patterns, isize pattern_count
+) {
+    CyAhoCorasick ac = {.pattern_count = pattern_count};
+
+    b8 used[256] = {0};
+    isize max_states = 1;
+    for (isize i = 0; i < pattern_count; i++) {
+        for (isize j = 0; j < patterns[i].len; j++) {
+            used[patterns[i].text[j]] = true;
         }
-    }
 
-    f64 res = sign * frac == 0 ? (val * scale) : (val / scale);
-    if (len_out != NULL) {
-        *len_out = s - str;
+        max_states += patterns[i].len;
     }
 
-    return res;
-}
+    // NOTE(cya): class 0 is for all the bytes none of the patterns use
+    ac.class_count = 1;
+    for (isize c = 0; c < 256; c++) {
+        ac.classes[c] = used[c] ? (u8)ac.class_count++ : 0;
+    }
 
-isize cy_str_parse_f32(f32 n, char *dst)
-{
-    return cy_str_parse_f64((f64)n, dst);
-}
+    // NOTE(cya): with all 256 bytes used, class 0 is free and 0xFF wraps to it
+    if (ac.class_count > 256) {
+        ac.class_count = 256;
+    }
 
-typedef struct {
-    u32 integral;
-    u32 decimal;
-    i32 exponent;
-} CyPrivFloatParts;
+    isize classes = ac.class_count;
+    if (max_states > (isize)(CY__AC_MATCH_BIT / (u32)classes)) {
+        return (CyAhoCorasick){0};
+    }
 
-cy_internal cy_inline i16 cy__f64_normalize_decimal(f64 *val)
-{
-    const f64 exp_threshold_neg = 1e-5;
-    const f64 exp_threshold_pos = 1e7;
+    CyArenaTemp scratch = cy_arena_scratch_begin(&arena, 1);
+    CyArena *tmp = scratch.arena;
+    u32 *trie = cy_arena_push_array(tmp, u32, max_states * classes);
+    u32 *fail = cy_arena_push_array(tmp, u32, max_states);
+    u32 *queue = cy_arena_push_array(tmp, u32, max_states);
+    u32 *state_patterns = cy_arena_push_array(tmp, u32, max_states);
+    u32 *dict_links = cy_arena_push_array(tmp, u32, max_states);
+    if (
+        trie == NULL || fail == NULL || queue == NULL ||
+        state_patterns == NULL || dict_links == NULL
+    ) {
+        cy_arena_scratch_end(scratch);
+        return (CyAhoCorasick){0};
+    }
 
-    i16 exp = 0;
-    f64 value = *val;
-    if (value > exp_threshold_pos) {
-        CY__CALC_BIN_EXPS(INC, 10, 1e, value, exp);
-    } else if (value > 0.0 && value <= exp_threshold_neg) {
-        CY__CALC_BIN_EXPS(DEC, 10, 1e, value, exp);
+    ac.pattern_next = cy_arena_push_array(arena, u32, pattern_count);
+    ac.pattern_lens = cy_arena_push_array(arena, isize, pattern_count);
+    if (ac.pattern_next == NULL || ac.pattern_lens == NULL) {
+        cy_arena_scratch_end(scratch);
+        return (CyAhoCorasick){0};
     }
 
-    *val = value;
-    return exp;
-}
+    // NOTE(cya): a trie with dense rows first (0 means no edge yet)
+    for (isize i = 0; i < max_states; i++) {
+        state_patterns[i] = CY__AC_NONE;
+    }
 
-cy_internal cy_inline CyPrivFloatParts cy__f64_split(f64 val)
-{
-    i16 exponent = cy__f64_normalize_decimal(&val);
-    u32 integral = (u32)val;
-    f64 remainder = (val - (f64)integral) * 1e9;
-    u32 decimal = (u32)remainder;
+    isize state_count = 1;
+    for (isize i = 0; i < pattern_count; i++) {
+        ac.pattern_next[i] = CY__AC_NONE;
+        ac.pattern_lens[i] = patterns[i].len;
+        if (patterns[i].len == 0) {
+            continue;
+        }
 
-    remainder -= decimal;
-    if (remainder > 0.5) {
-        decimal += 1;
-        if (decimal > 1e9) {
-            decimal = 0;
-            integral += 1;
-            if (exponent != 0 && integral > 9) {
-                integral = 1;
-                exponent += 1;
+        u32 state = 0;
+        for (isize j = 0; j < patterns[i].len; j++) {
+            u8 c = ac.classes[patterns[i].text[j]];
+            u32 *edge = &trie[state * classes + c];
+            if (*edge == 0) {
+                *edge = (u32)state_count++;
             }
+
+            state = *edge;
         }
-    }
 
-    return (CyPrivFloatParts){
-        .integral = integral,
-        .decimal = decimal,
-        .exponent = exponent,
-    };
-}
+        // NOTE(cya): keep the earliest duplicate at the head of the chain
+        u32 *link = &state_patterns[state];
+        while (*link != CY__AC_NONE) {
+            link = &ac.pattern_next[*link];
+        }
 
-cy_internal cy_inline isize cy__f64_parse_decimal(u32 value, char *dst)
-{
-    isize width = 9;
-    while (value % 10 == 0 && width > 0) {
-        value /= 10;
-        width -= 1;
+        *link = (u32)i;
+    }
+
+    ac.state_patterns = cy_arena_push_array(arena, u32, state_count);
+    ac.dict_links = cy_arena_push_array(arena, u32, state_count);
+    ac.table = cy_arena_push_array(arena, u32, state_count * classes);
+    if (
+        ac.state_patterns == NULL || ac.dict_links == NULL ||
+        ac.table == NULL
+    ) {
+        cy_arena_scratch_end(scratch);
+        return (CyAhoCorasick){0};
+    }
+
+    /*
+     * Breadth-first, turning the trie into the DFA in place: a missing edge
+     * takes its failure state's transition, which is always complete by the
+     * time we get to it since failure states are shallower
+     */
+    isize head = 0, tail = 0;
+    queue[tail++] = 0;
+    while (head < tail) {
+        u32 state = queue[head++];
+        u32 *row = &trie[state * classes];
+        const u32 *fail_row = &trie[fail[state] * classes];
+        for (isize c = 0; c < classes; c++) {
+            if (row[c] == 0) {
+                row[c] = (state == 0) ? 0 : fail_row[c];
+                continue;
+            }
+
+            u32 child = row[c];
+            fail[child] = (state == 0) ? 0 : fail_row[c];
+
+            u32 f = fail[child];
+            dict_links[child] = (state_patterns[f] != CY__AC_NONE) ?
+                f : dict_links[f];
+            queue[tail++] = child;
+        }
     }
 
-    char *c = dst;
-    while (width-- > 0) {
-        *c++ = cy__num_to_char_table_upper[value % 10];
-        value /= 10;
+    /*
+     * Renumber the states in that same breadth-first order: scans spend most
+     * of their time near the root, so this packs the hot rows together instead
+     * of scattering them all over the table in insertion order
+     */
+    u32 *rank = fail;
+    for (isize i = 0; i < state_count; i++) {
+        rank[queue[i]] = (u32)i;
+    }
+
+    for (isize i = 0; i < state_count; i++) {
+        u32 state = queue[i];
+        for (isize c = 0; c < classes; c++) {
+            u32 next = trie[state * classes + c];
+            b32 has_match = state_patterns[next] != CY__AC_NONE ||
+                dict_links[next] != 0;
+            ac.table[i * classes + c] = (rank[next] * (u32)classes) |
+                (has_match ? CY__AC_MATCH_BIT : 0);
+        }
+
+        ac.state_patterns[i] = state_patterns[state];
+        ac.dict_links[i] = rank[dict_links[state]];
     }
 
-    *c = '\0';
-    cy_str_reverse(dst);
+    cy_arena_scratch_end(scratch);
 
-    return c - dst;
+    ac.state_count = state_count;
+    return ac;
 }
 
-// NOTE(cya):
-// * this doesn't allow for customizing the formatting of the value
-// (parses up to 9 significant decimal digits and normalizes the number)
-// * make sure you write this to a buffer with at least 23 bytes of capacity
-// (including the null terminator)
-isize cy_str_parse_f64(f64 n, char *dst)
-{
-    char *cur = dst;
-    if (CY_IS_NAN(n)) {
-        return cy_str_copy(cur, "NaN") - dst;
-    }
+// NOTE(cya): kept out of line so it doesn't eat into the scan loop's registers
+cy_internal cy_no_inline b32 cy__aho_corasick_report(
+    const CyAhoCorasick *ac, u32 state, isize end,
+    CyAhoCorasickMatchProc *proc, void *user_data
+) {
+    u32 s = state / (u32)ac->class_count;
+    do {
+        u32 p = ac->state_patterns[s];
+        for (; p != CY__AC_NONE; p = ac->pattern_next[p]) {
+            CyAhoCorasickMatch match = {
+                .pattern = p,
+                .begin = end - ac->pattern_lens[p],
+                .end = end,
+            };
+            if (!proc(user_data, match)) {
+                return false;
+            }
+        }
 
-    if (n < 0.0) {
-        *cur++ = '-';
-        n = -n;
-    }
+        s = ac->dict_links[s];
+    } while (s != 0);
 
-    if (CY_IS_INF(n)) {
-        return cy_str_copy(cur, "Inf") - dst;
-    }
+    return true;
+}
 
-    CyPrivFloatParts parts = cy__f64_split(n);
-    cur += cy_str_parse_u64(parts.integral, 10, cur);
-    if (parts.decimal > 0) {
-        *cur++ = '.';
-        cur += cy__f64_parse_decimal(parts.decimal, cur);
+b32 cy_aho_corasick_scan(
+    const CyAhoCorasick *ac, CyAhoCorasickStream *stream, CyStringView chunk,
+    CyAhoCorasickMatchProc *proc, void *user_data
+) {
+    const u32 *table = ac->table;
+    const u8 *classes = ac->classes;
+    const u8 *text = chunk.text;
+    usize state = stream->state;
+    for (isize i = 0; i < chunk.len; i++) {
+        u32 next = table[state + classes[text[i]]];
+        state = next & ~CY__AC_MATCH_BIT;
+        if (
+            (next & CY__AC_MATCH_BIT) != 0 &&
+            !cy__aho_corasick_report(
+                ac, (u32)state, stream->offset + i + 1, proc, user_data
+            )
+        ) {
+            stream->state = (u32)state;
+            stream->offset += i + 1;
+            return false;
+        }
     }
 
-    if (parts.exponent != 0) {
-        *cur++ = 'e';
-        cur += cy_str_parse_i64(parts.exponent, 10, cur);
-    }
+    stream->state = (u32)state;
+    stream->offset += chunk.len;
+    return true;
+}
 
-    *cur = '\0';
-    return cur - dst;
+cy_inline b32 cy_aho_corasick_find_all(
+    const CyAhoCorasick *ac, CyStringView str,
+    CyAhoCorasickMatchProc *proc, void *user_data
+) {
+    CyAhoCorasickStream stream = {0};
+    return cy_aho_corasick_scan(ac, &stream, str, proc, user_data);
 }
 
-/* ================================ Strings ================================= */
-cy_inline isize cy_string_len(CyString str)
+/* =========================== Strings (UTF-16) ============================= */
+#if defined(CY_OS_WINDOWS)
+#define CY__U16S_TO_BYTES(c) (isize)((c) * cy_sizeof(u16))
+
+cy_inline isize cy_string_16_len(CyString16 str)
 {
     return (str == NULL) ? 0 : CY_STRING_HEADER(str)->len;
 }
 
-cy_inline isize cy_string_cap(CyString str)
+cy_inline isize cy_string_16_cap(CyString16 str)
 {
     return (str == NULL) ? 0 : CY_STRING_HEADER(str)->cap;
 }
 
-cy_inline isize cy_string_alloc_size(CyString str)
+cy_inline isize cy_string_16_alloc_size(CyString16 str)
 {
-    return cy_sizeof(CyStringHeader) + cy_string_cap(str) + 1;
+    isize bytes = CY__U16S_TO_BYTES(cy_string_16_cap(str) + 1);
+    return cy_sizeof(CyStringHeader) + bytes;
 }
 
-cy_inline isize cy_string_available_space(CyString str)
+cy_inline isize cy_string_16_available_space(CyString16 str)
 {
     CyStringHeader *h = CY_STRING_HEADER(str);
     if (h->cap > h->len) {
@@ -4488,7 +10272,7 @@ cy_inline isize cy_string_available_space(CyString str)
     return 0;
 }
 
-cy_inline void cy__string_set_len(CyString str, isize len)
+cy_inline void cy__string_16_set_len(CyString16 str, isize len)
 {
     if (str == NULL) {
         return;
@@ -4497,7 +10281,7 @@ cy_inline void cy__string_set_len(CyString str, isize len)
     CY_STRING_HEADER(str)->len = len;
 }
 
-cy_inline void cy__string_set_cap(CyString str, isize cap)
+cy_inline void cy__string_16_set_cap(CyString16 str, isize cap)
 {
     if (str == NULL) {
         return;
@@ -4506,10 +10290,10 @@ cy_inline void cy__string_set_cap(CyString str, isize cap)
     CY_STRING_HEADER(str)->cap = cap;
 }
 
-CyString cy_string_create_reserve(CyAllocator a, isize cap)
+CyString16 cy_string_16_create_reserve(CyAllocator a, isize cap)
 {
     isize header_size = cy_sizeof(CyStringHeader);
-    isize total_size = header_size + cap + 1;
+    isize total_size = CY__U16S_TO_BYTES(header_size + cap + 1);
     void *ptr = cy_alloc(a, total_size);
     CY_VALIDATE_PTR(ptr);
 
@@ -4522,13 +10306,14 @@ CyString cy_string_create_reserve(CyAllocator a, isize cap)
         .cap = cap,
     };
 
-    return (CyString)ptr + header_size;
+    return (CyString16)(header + 1);
 }
 
-CyString cy_string_create_len(CyAllocator a, const char *str, isize len)
-{
+CyString16 cy_string_16_create_len(
+    CyAllocator a, const wchar_t *str, isize len
+) {
     isize header_size = cy_sizeof(CyStringHeader);
-    isize total_size = header_size + len + 1;
+    isize total_size = CY__U16S_TO_BYTES(header_size + len + 1);
     void *ptr = cy_alloc(a, total_size);
     CY_VALIDATE_PTR(ptr);
 
@@ -4543,28 +10328,28 @@ CyString cy_string_create_len(CyAllocator a, const char *str, isize len)
         .cap = len,
     };
 
-    CyString string = (CyString)ptr + header_size;
+    CyString16 string = (CyString16)((uintptr)ptr + (uintptr)header_size);
     if (len > 0 && str != NULL) {
-        cy_mem_copy(string, str, len);
+        cy_mem_copy(string, str, CY__U16S_TO_BYTES(len));
     }
 
     string[len] = '\0';
     return string;
 }
 
-cy_inline CyString cy_string_create(CyAllocator a, const char *str)
+cy_inline CyString16 cy_string_16_create(CyAllocator a, const wchar_t *str)
 {
-    return cy_string_create_len(a, str, cy_str_len(str));
+    return cy_string_16_create_len(a, str, cy_wcs_len(str));
 }
 
-cy_inline CyString cy_string_create_view(CyAllocator a, CyStringView str)
+cy_inline CyString16 cy_string_16_create_view(CyAllocator a, CyString16View str)
 {
-    return cy_string_create_len(a, (const char*)str.text, str.len);
+    return cy_string_16_create_len(a, (const wchar_t*)str.text, str.len);
 }
 
-CyString cy_string_reserve_space_for(CyString str, isize extra_len)
+CyString16 cy_string_16_reserve_space_for(CyString16 str, isize extra_len)
 {
-    isize available = cy_string_available_space(str);
+    isize available = cy_string_16_available_space(str);
     if (available >= extra_len) {
         return str;
     }
@@ -4573,9 +10358,11 @@ CyString cy_string_reserve_space_for(CyString str, isize extra_len)
     CyStringHeader *header = mem;
     CyAllocator a = header->alloc;
 
-    isize new_cap = cy_string_len(str) + extra_len;
-    isize old_size = cy_sizeof(*header) + cy_string_cap(str) + 1;
-    isize new_size = cy_sizeof(*header) + new_cap + 1;
+    isize header_size = cy_sizeof(*header);
+    isize old_cap = cy_string_16_cap(str);
+    isize new_cap = cy_string_16_len(str) + extra_len;
+    isize old_size = header_size + CY__U16S_TO_BYTES(old_cap + 1);
+    isize new_size = header_size + CY__U16S_TO_BYTES(new_cap + 1);
 
     void *new_mem = cy_resize(a, mem, old_size, new_size);
     CY_VALIDATE_PTR(new_mem);
@@ -4583,653 +10370,1181 @@ CyString cy_string_reserve_space_for(CyString str, isize extra_len)
     header = new_mem;
     header->alloc = a;
 
-    str = (CyString)(header + 1);
-    cy__string_set_cap(str, new_cap);
+    str = (CyString16)(header + 1);
+    cy__string_16_set_cap(str, new_cap);
     return str;
 }
 
-CyString cy_string_shrink(CyString str)
+CyString16 cy_string_16_shrink(CyString16 str)
 {
     CY_VALIDATE_PTR(str);
 
-    isize len = cy_string_len(str), cap = cy_string_cap(str);
+    isize len = cy_string_16_len(str), cap = cy_string_16_cap(str);
     isize header_size = cy_sizeof(CyStringHeader);
-    isize size = header_size + cap + 1;
-    isize new_size = header_size + len + 1;
-    void *ptr = str - header_size;
-    if (new_size < size) {
-        ptr = cy_resize(CY_STRING_HEADER(str)->alloc, ptr, size, new_size);
-        str = (CyString)ptr + header_size;
-        cy__string_set_cap(str, len);
+    isize old_size = header_size + CY__U16S_TO_BYTES(cap + 1);
+    isize new_size = header_size + CY__U16S_TO_BYTES(len + 1);
+    void *ptr = (u8*)str - header_size;
+    if (new_size < old_size) {
+        ptr = cy_resize(CY_STRING_HEADER(str)->alloc, ptr, old_size, new_size);
+        str = (CyString16)((uintptr)ptr + (uintptr)header_size);
+        cy__string_16_set_cap(str, len);
     }
 
     return str;
 }
 
-cy_inline void cy_string_free(CyString str)
+cy_inline CyString16 cy_string_16_resize(CyString16 str, isize new_cap)
+{
+    void *mem = CY_STRING_HEADER(str);
+    CyStringHeader *header = mem;
+    CyAllocator a = header->alloc;
+
+    isize header_size = cy_sizeof(*header);
+    isize old_cap = cy_string_16_cap(str);
+    isize old_size = header_size + CY__U16S_TO_BYTES(old_cap + 1);
+    isize new_size = header_size + CY__U16S_TO_BYTES(new_cap + 1);
+    void *new_mem = cy_resize(a, mem, old_size, new_size);
+    CY_VALIDATE_PTR(new_mem);
+
+    header = new_mem;
+    header->alloc = a;
+
+    str = (CyString16)(header + 1);
+    cy__string_16_set_cap(str, new_cap);
+    return str;
+}
+
+cy_inline void cy_string_16_free(CyString16 str)
 {
     if (str != NULL) {
         cy_free(CY_STRING_HEADER(str)->alloc, CY_STRING_HEADER(str));
     }
 }
 
-CyString cy_string_append_len(CyString str, const char *other, isize len)
+cy_inline void cy_string_16_clear(CyString16 str)
 {
+    if (str == NULL) {
+        return;
+    }
+
+    cy_mem_zero(str, CY__U16S_TO_BYTES(cy_string_16_cap(str)));
+    cy__string_16_set_len(str, 0);
+}
+
+CyString16 cy_string_16_append_len(
+    CyString16 str, const wchar_t *other, isize len
+) {
     if (len > 0) {
-        isize cur_len = cy_string_len(str);
+        isize cur_len = cy_string_16_len(str);
 
-        str = cy_string_reserve_space_for(str, len);
+        str = cy_string_16_reserve_space_for(str, len);
         CY_VALIDATE_PTR(str);
 
-        cy_mem_copy(str + cur_len, other, len);
+        cy_mem_copy(str + cur_len, other, CY__U16S_TO_BYTES(len));
 
         isize new_len = cur_len + len;
         str[new_len] = '\0';
 
-        cy__string_set_len(str, new_len);
+        cy__string_16_set_len(str, new_len);
     }
 
     return str;
 }
 
-cy_inline CyString cy_string_append(CyString str, const CyString other)
+cy_inline CyString16 cy_string_16_append(CyString16 str, const CyString16 other)
 {
-    return cy_string_append_len(str, other, cy_string_len(other));
+    return cy_string_16_append_len(str, other, cy_string_16_len(other));
 }
 
-cy_inline CyString cy_string_append_c(CyString str, const char *other)
+cy_inline CyString16 cy_string_16_append_c(CyString16 str, const wchar_t *other)
 {
-    return cy_string_append_len(str, other, cy_str_len(other));
+    return cy_string_16_append_len(str, other, cy_wcs_len(other));
 }
 
-cy_inline CyString cy_string_append_rune(CyString str, Rune r)
+cy_inline CyString16 cy_string_16_append_view(CyString16 str, CyString16View view)
 {
-    // TODO(cya): utf-8 encode rune
-    return cy_string_append_len(str, (const char*)&r, 1);
+    return cy_string_16_append_len(str, (const wchar_t*)view.text, view.len);
+}
+
+/* ---------------------------- String16 views ------------------------------ */
+cy_inline CyString16View cy_string_16_view_create_len(
+    const wchar_t *str, isize len
+) {
+    if (len < 0) {
+        len = cy_wcs_len(str);
+    }
+
+    return (CyString16View){
+        .text = (const u16*)str,
+        .len = len,
+    };
 }
 
-CyString cy_string_append_fmt(CyString str, const char *fmt, ...)
+cy_inline CyString16View cy_string_16_view_create(CyString16 str)
 {
-    va_list va;
-    va_start(va, fmt);
+    return cy_string_16_view_create_len(str, cy_string_16_len(str));
+}
 
-    CyAllocator a = CY_STRING_HEADER(str)->alloc;
-    char *buf = cy_aprintf_va(a, fmt, va);
+cy_inline CyString16View cy_string_16_view_create_c(const wchar_t *str)
+{
+    return cy_string_16_view_create_len(str, cy_wcs_len(str));
+}
 
-    va_end(va);
-    str = cy_string_append_c(str, buf);
-    cy_free(a, buf);
+CyString16View cy_string_16_view_substring(
+    CyString16View str, isize begin_idx, isize end_idx
+) {
+    isize max = str.len, lo = begin_idx, hi = end_idx;
+    CY_ASSERT_MSG(lo <= hi && hi <= max, "%td..%td..%td", lo, hi, max);
 
-    return str;
+    return cy_string_16_view_create_len((const wchar_t*)str.text + lo, hi - lo);
 }
 
-cy_inline CyString cy_string_append_view(CyString str, CyStringView view)
+cy_inline b32 cy_string_16_view_are_equal(CyString16View a, CyString16View b)
 {
-    return cy_string_append_len(str, (const char*)view.text, view.len);
+    return (a.len == b.len) && (
+        cy_mem_compare(a.text, b.text, CY__U16S_TO_BYTES(a.len)) == 0
+    );
 }
 
-CyString cy_string_prepend_len(CyString str, const char *other, isize len)
+cy_inline b32 cy_string_16_view_has_prefix(
+    CyString16View str, const wchar_t *prefix
+) {
+    CyString16View other = cy_string_16_view_create_c(prefix);
+    return cy_string_16_view_are_equal(
+        cy_string_16_view_create_len((const wchar_t*)str.text, other.len), other
+    );
+}
+
+b32 cy_string_16_view_contains(CyString16View str, const wchar_t *char_set)
 {
-    if (len > 0) {
-        isize cur_len = cy_string_len(str);
+    isize len = cy_wcs_len(char_set);
+    for (isize i = 0; i < str.len; i++) {
+        for (isize j = 0; j < len; j++) {
+            if (str.text[i] == char_set[j]) {
+                return true;
+            }
+        }
+    }
 
-        str = cy_string_reserve_space_for(str, len);
-        CY_VALIDATE_PTR(str);
+    return false;
+}
+#endif // CY_OS_WINDOWS
 
-        isize new_len = cur_len + len;
-        cy_mem_move(str + len, str, cur_len);
-        cy_mem_copy(str, other, len);
+/* ============================ Unicode helpers ============================= */
+// TODO(cya): implement
+#if 0
+cy_global u8 cy__utf8_class_table[32] = {
+    0, 0, 0, 0, // 0 = 0xxxx
+    0, 0, 0, 0, // 1 = 10xxx
+    0, 0, 0, 0, // 2 = 110xx
+    0, 0, 0, 0, // 3 = 1110x
+    1, 1, 1, 1, // 4 = 11110
+    1, 1, 1, 1, // 5 = 11111 (invalid)
+    2, 2, 2, 2,
+    3, 3, 4, 5,
+};
 
-        str[new_len] = '\0';
-        cy__string_set_len(str, new_len);
+isize cy_utf8_encode_rune(u8 buf[4], Rune r)
+{
+    return 0;
+}
+
+isize cy_utf8_decode(const u8 *str, Rune *codepoint_out)
+{
+    return 0;
+}
+#endif
+
+cy_inline isize cy_utf8_codepoints(const char *str)
+{
+    isize count = 0;
+    while (*str != '\0') {
+        u8 c = (u8)*str;
+        u8 inc = 0;
+        if (c < 0x80) {
+            inc = 1;
+        } else if ((c & 0xE0) == 0xC0) {
+            inc = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            inc = 3;
+        } else if ((c & 0xF8) == 0xF0) {
+            inc = 4;
+        } else {
+            return -1;
+        }
+
+        str += inc;
+        count += 1;
     }
 
-    return str;
+    return count;
 }
 
-cy_inline CyString cy_string_prepend(CyString str, const CyString other)
+/* ================================ Hashing ================================= */
+cy_global const u64 cy__hash_secret[4] = {
+    0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL,
+    0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL,
+};
+
+cy_internal cy_inline u64 cy__hash_mix(u64 a, u64 b)
 {
-    return cy_string_prepend_len(str, other, cy_string_len(other));
+    u64 hi;
+    u64 lo = cy__u64_mul_128(a, b, &hi);
+    return lo ^ hi;
 }
 
-cy_inline CyString cy_string_prepend_c(CyString str, const char *other)
+cy_internal cy_inline u64 cy__hash_read_64(const u8 *p)
 {
-    return cy_string_prepend_len(str, other, cy_str_len(other));
+    u64 v;
+    cy_mem_copy(&v, p, cy_sizeof(v));
+    return v;
 }
 
-cy_inline CyString cy_string_prepend_rune(CyString str, Rune r)
+cy_internal cy_inline u64 cy__hash_read_32(const u8 *p)
 {
-    // TODO(cya): utf-8 encode rune
-    isize width = 1;
-    return cy_string_prepend_len(str, (const char*)&r, width);
+    u32 v;
+    cy_mem_copy(&v, p, cy_sizeof(v));
+    return v;
 }
 
-cy_inline CyString cy_string_prepend_fmt(CyString str, const char *fmt, ...)
+cy_internal cy_inline u64 cy__hash_seed(u64 seed)
 {
-    va_list va;
-    va_start(va, fmt);
-
-    CyAllocator a = CY_STRING_HEADER(str)->alloc;
-    char *buf = cy_aprintf_va(a, fmt, va);
-
-    va_end(va);
-    str = cy_string_prepend_c(str, buf);
-    cy_free(a, buf);
+    return seed ^ cy__hash_mix(seed ^ cy__hash_secret[0], cy__hash_secret[1]);
+}
 
-    return str;
+// NOTE(cya): the three independent lanes the 48-byte blocks go through
+cy_internal cy_inline void cy__hash_block(u64 *lanes, const u8 *p)
+{
+    const u64 *secret = cy__hash_secret;
+    lanes[0] = cy__hash_mix(
+        cy__hash_read_64(p) ^ secret[1], cy__hash_read_64(p + 8) ^ lanes[0]
+    );
+    lanes[1] = cy__hash_mix(
+        cy__hash_read_64(p + 16) ^ secret[2],
+        cy__hash_read_64(p + 24) ^ lanes[1]
+    );
+    lanes[2] = cy__hash_mix(
+        cy__hash_read_64(p + 32) ^ secret[3],
+        cy__hash_read_64(p + 40) ^ lanes[2]
+    );
 }
 
-cy_inline CyString cy_string_prepend_view(CyString str, CyStringView view)
+cy_internal cy_inline u64 cy__hash_finish(u64 a, u64 b, u64 seed, isize len)
 {
-    return cy_string_prepend_len(str, (const char*)view.text, view.len);
+    const u64 *secret = cy__hash_secret;
+    u64 hi;
+    u64 lo = cy__u64_mul_128(a ^ secret[1], b ^ seed, &hi);
+    return cy__hash_mix(lo ^ secret[0] ^ (u64)len, hi ^ secret[1]);
 }
 
-CyString cy_string_pad_right(CyString str, isize width, Rune r)
+/*
+ * The last `rem` (< 48) bytes of an input longer than 16, the final reads are
+ * allowed to reach back before `p` into bytes that were already hashed
+ */
+cy_internal u64 cy__hash_tail(const u8 *p, isize rem, u64 seed, isize len)
 {
-    // TODO(cya): calculate width with utf8_width proc (to be implemented)
-    isize str_width = cy_utf8_codepoints(str);
-    isize rune_width = 1;
-    while (str_width < width) {
-        str = cy_string_append_rune(str, r);
-        str_width += rune_width;
+    for (; rem > 16; rem -= 16, p += 16) {
+        seed = cy__hash_mix(
+            cy__hash_read_64(p) ^ cy__hash_secret[1],
+            cy__hash_read_64(p + 8) ^ seed
+        );
     }
 
-    return str;
+    u64 a = cy__hash_read_64(p + rem - 16);
+    u64 b = cy__hash_read_64(p + rem - 8);
+    return cy__hash_finish(a, b, seed, len);
 }
 
-CyString cy_string_set(CyString str, const char *c_str)
+u64 cy_hash_bytes_seed(const void *data, isize len, u64 seed)
 {
-    isize new_len = cy_str_len(c_str);
-    if (cy_string_cap(str) < new_len) {
-        str = cy_string_reserve_space_for(str, new_len - cy_string_len(str));
-        CY_VALIDATE_PTR(str);
+    const u8 *p = (const u8*)data;
+    seed = cy__hash_seed(seed);
+    if (len <= 16) {
+        u64 a = 0, b = 0;
+        if (len >= 4) {
+            isize mid = (len >> 3) << 2;
+            a = (cy__hash_read_32(p) << 32) | cy__hash_read_32(p + mid);
+            b = (cy__hash_read_32(p + len - 4) << 32) |
+                cy__hash_read_32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((u64)p[0] << 16) | ((u64)p[len >> 1] << 8) | p[len - 1];
+        }
+
+        return cy__hash_finish(a, b, seed, len);
     }
 
-    cy_mem_copy(str, c_str, new_len + 1);
-    cy__string_set_len(str, new_len);
+    isize rem = len;
+    if (rem >= 48) {
+        u64 lanes[3] = {seed, seed, seed};
+        do {
+            cy__hash_block(lanes, p);
+            p += 48;
+            rem -= 48;
+        } while (rem >= 48);
 
-    return str;
+        seed = lanes[0] ^ lanes[1] ^ lanes[2];
+    }
+
+    return cy__hash_tail(p, rem, seed, len);
 }
 
-CyString cy_string_dup(CyAllocator a, const CyString src)
+cy_inline u64 cy_hash_bytes(const void *data, isize len)
 {
-    return cy_string_create_len(a, src, cy_string_len(src));
+    return cy_hash_bytes_seed(data, len, 0);
 }
 
-b32 cy_string_are_equal(const CyString a, const CyString b)
+cy_inline u64 cy_hash_string(CyString str)
 {
-    isize a_len = cy_string_len(a);
-    isize b_len = cy_string_len(b);
-    if (a_len != b_len) {
-        return false;
-    }
+    return cy_hash_bytes_seed(str, cy_string_len(str), 0);
+}
 
-    return cy_mem_compare(a, b, a_len) == 0;
+cy_inline u64 cy_hash_string_view(CyStringView str)
+{
+    return cy_hash_bytes_seed(str.text, str.len, 0);
 }
 
-CyString cy__string_trim_internal(CyString str, const char *cut_set, i32 flags)
+cy_inline u64 cy_hash_string_view_seed(CyStringView str, u64 seed)
 {
-    char *start, *new_start;
-    new_start = start = str;
-    char *end, *new_end;
-    new_end = end = str + cy_string_len(str) - 1;
-    if (flags & CY__STRING_TRIM_LEADING) {
-        while (
-            new_start <= end &&
-                cy_char_first_occurence(cut_set, *new_start) != NULL
-        ) {
-            new_start += 1;
-        }
-    }
-    if (flags & CY__STRING_TRIM_TRAILING) {
-        while (
-            new_end > new_start &&
-                cy_char_first_occurence(cut_set, *new_end) != NULL
-        ) {
-            new_end -= 1;
+    return cy_hash_bytes_seed(str.text, str.len, seed);
+}
+
+CyHashState cy_hash_state_init(u64 seed)
+{
+    u64 lane = cy__hash_seed(seed);
+    CyHashState state = {
+        .seed = seed,
+        .lanes = {lane, lane, lane},
+    };
+    return state;
+}
+
+void cy_hash_update(CyHashState *state, const void *data, isize len)
+{
+    const u8 *p = (const u8*)data;
+    u8 *pending = state->buf + 16;
+
+    // NOTE(cya): blocks get hashed as soon as they're full (never partially)
+    isize pending_len = state->len % 48;
+    state->len += len;
+    if (pending_len > 0) {
+        isize n = CY_MIN(len, 48 - pending_len);
+        cy_mem_copy(pending + pending_len, p, n);
+        p += n;
+        len -= n;
+        if (pending_len + n < 48) {
+            return;
         }
+
+        cy__hash_block(state->lanes, pending);
+        cy_mem_copy(state->buf, pending + 32, 16);
     }
 
-    isize len = (isize)(new_start > new_end ? 0 : new_end - new_start + 1);
-    if (str != new_start) {
-        cy_mem_move(str, new_start, len);
+    if (len >= 48) {
+        do {
+            cy__hash_block(state->lanes, p);
+            p += 48;
+            len -= 48;
+        } while (len >= 48);
+
+        cy_mem_copy(state->buf, p - 16, 16);
     }
 
-    str[len] = '\0';
-    cy__string_set_len(str, len);
-    return str;
+    cy_mem_copy(pending, p, len);
 }
 
-cy_inline CyString cy_string_trim(CyString str, const char *char_set)
+u64 cy_hash_final(const CyHashState *state)
 {
-    return cy__string_trim_internal(
-        str, char_set, CY__STRING_TRIM_LEADING | CY__STRING_TRIM_TRAILING
+    const u8 *pending = state->buf + 16;
+    if (state->len < 48) {
+        return cy_hash_bytes_seed(pending, state->len, state->seed);
+    }
+
+    const u64 *lanes = state->lanes;
+    return cy__hash_tail(
+        pending, state->len % 48, lanes[0] ^ lanes[1] ^ lanes[2], state->len
     );
 }
 
-cy_inline CyString cy_string_trim_leading(CyString str, const char *char_set)
-{
-    return cy__string_trim_internal(str, char_set, CY__STRING_TRIM_LEADING);
-}
+/* --------------------------------- CRC32C --------------------------------- */
+cy_global const u32 cy__crc32c_table[256] = {
+    0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C,
+    0x26A1E7E8, 0xD4CA64EB, 0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B,
+    0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24, 0x105EC76F, 0xE235446C,
+    0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+    0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC,
+    0xBC267848, 0x4E4DFB4B, 0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A,
+    0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35, 0xAA64D611, 0x580F5512,
+    0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+    0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD,
+    0x1642AE59, 0xE4292D5A, 0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A,
+    0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595, 0x417B1DBC, 0xB3109EBF,
+    0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+    0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F,
+    0xED03A29B, 0x1F682198, 0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927,
+    0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38, 0xDBFC821C, 0x2997011F,
+    0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+    0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E,
+    0x4767748A, 0xB50CF789, 0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859,
+    0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46, 0x7198540D, 0x83F3D70E,
+    0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+    0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE,
+    0xDDE0EB2A, 0x2F8B6829, 0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C,
+    0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93, 0x082F63B7, 0xFA44E0B4,
+    0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+    0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B,
+    0xB4091BFF, 0x466298FC, 0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C,
+    0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033, 0xA24BB5A6, 0x502036A5,
+    0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+    0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975,
+    0x0E330A81, 0xFC588982, 0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D,
+    0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622, 0x38CC2A06, 0xCAA7A905,
+    0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+    0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8,
+    0xE52CC12C, 0x1747422F, 0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF,
+    0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0, 0xD3D3E1AB, 0x21B862A8,
+    0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+    0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78,
+    0x7FAB5E8C, 0x8DC0DD8F, 0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE,
+    0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1, 0x69E9F0D5, 0x9B8273D6,
+    0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+    0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69,
+    0xD5CF889D, 0x27A40B9E, 0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E,
+    0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351,
+};
 
-cy_inline CyString cy_string_trim_trailing(CyString str, const char *char_set)
+cy_internal u32 cy__crc32c_sw(u32 crc, const u8 *p, isize len)
 {
-    return cy__string_trim_internal(str, char_set, CY__STRING_TRIM_TRAILING);
+    for (isize i = 0; i < len; i++) {
+        crc = cy__crc32c_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
 }
 
-#define CY__WHITESPACE " \t\r\n\v\f"
+// NOTE(cya): SSE4.2's crc32 instruction (x86-64 only, checked at runtime)
+#if defined(CY__SIMD_SSE2) && defined(CY_ARCH_64_BIT)
+#define CY__CRC32C_HW 1
 
-cy_inline CyString cy_string_trim_whitespace(CyString str)
-{
-    return cy_string_trim(str, CY__WHITESPACE);
-}
+#if defined(CY_COMPILER_MSVC)
+    #define CY__TARGET_SSE42
+#else
+    #include <nmmintrin.h>
 
-cy_inline CyString cy_string_trim_leading_whitespace(CyString str)
+    #define CY__TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+// NOTE(cya): cached the same way as cy__cpu_avx2
+cy_global volatile u32 cy__cpu_sse42;
+
+cy_internal b32 cy__cpu_has_sse42(void)
 {
-    return cy_string_trim_leading(str, CY__WHITESPACE);
+    u32 cached = cy__atomic_load_u32_acquire(&cy__cpu_sse42);
+    if (cached == 0) {
+    #if defined(CY_COMPILER_MSVC)
+        int info[4];
+        __cpuid(info, 1);
+        b32 has_sse42 = (info[2] & CY_BIT(20)) != 0;
+    #else
+        __builtin_cpu_init();
+        b32 has_sse42 = __builtin_cpu_supports("sse4.2");
+    #endif
+
+        cached = 1 + (has_sse42 != 0);
+        cy__atomic_store_u32_release(&cy__cpu_sse42, cached);
+    }
+
+    return cached - 1;
 }
 
-cy_inline CyString cy_string_trim_trailing_whitespace(CyString str)
+CY__TARGET_SSE42
+cy_internal u32 cy__crc32c_hw(u32 crc, const u8 *p, isize len)
 {
-    return cy_string_trim_trailing(str, CY__WHITESPACE);
+    u64 crc64 = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        crc64 = _mm_crc32_u64(crc64, cy__hash_read_64(p));
+    }
+
+    crc = (u32)crc64;
+    for (; len > 0; len--, p++) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+
+    return crc;
 }
+#endif
 
-/* ----------------------------- String views ------------------------------- */
-CyStringView cy_string_view_create_len(const char *str, isize len)
+u32 cy_crc32c(u32 crc, const void *data, isize len)
 {
-    if (len < 0) {
-        len = cy_str_len(str);
+    const u8 *p = (const u8*)data;
+    crc = ~crc;
+#if defined(CY__CRC32C_HW)
+    if (cy__cpu_has_sse42()) {
+        return ~cy__crc32c_hw(crc, p, len);
     }
+#endif
 
-    return (CyStringView){
-        .text = (const u8*)str,
-        .len = len,
-    };
+    return ~cy__crc32c_sw(crc, p, len);
 }
 
-CyStringView cy_string_view_create(CyString str)
+/* =============================== Hash maps ================================ */
+#define CY__HASH_MAP_GROUP 16
+#define CY__HASH_MAP_EMPTY 0x80
+#define CY__HASH_MAP_DELETED 0xFE
+
+// NOTE(cya): full slots have the high bit clear, empty and deleted ones set
+cy_internal cy_inline u32 cy__hash_map_match(const u8 *group, u8 h2)
 {
-    return cy_string_view_create_len(str, cy_string_len(str));
+#if defined(CY__SIMD_SSE2)
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    __m128i hits = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2));
+    return (u32)_mm_movemask_epi8(hits);
+#else
+    u32 mask = 0;
+    for (isize i = 0; i < CY__HASH_MAP_GROUP; i++) {
+        mask |= (u32)(group[i] == h2) << i;
+    }
+
+    return mask;
+#endif
 }
 
-CyStringView cy_string_view_create_c(const char *str)
+cy_internal cy_inline u32 cy__hash_map_match_free(const u8 *group)
 {
-    return cy_string_view_create_len(str, cy_str_len(str));
+#if defined(CY__SIMD_SSE2)
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    u32 mask = 0;
+    for (isize i = 0; i < CY__HASH_MAP_GROUP; i++) {
+        mask |= (u32)(group[i] >> 7) << i;
+    }
+
+    return mask;
+#endif
 }
 
-CyStringView cy_string_view_substring(
-    CyStringView str, isize begin_idx, isize end_idx
+cy_internal cy_inline u64 cy__hash_map_hash(
+    const CyHashMap *map, const void *key
 ) {
-    isize max = str.len, lo = begin_idx, hi = end_idx;
-    CY_ASSERT_MSG(lo <= hi && hi <= max, "%td..%td..%td", lo, hi, max);
+    return map->string_keys ?
+        cy_hash_string_view_seed(*(const CyStringView*)key, map->seed) :
+        cy_hash_bytes_seed(key, map->key_size, map->seed);
+}
 
-    return cy_string_view_create_len((const char*)str.text + lo, hi - lo);
+cy_internal cy_inline b32 cy__hash_map_keys_equal(
+    const CyHashMap *map, const void *a, const void *b
+) {
+    return map->string_keys ? cy_string_view_are_equal(
+        *(const CyStringView*)a, *(const CyStringView*)b
+    ) : cy_mem_compare(a, b, map->key_size) == 0;
 }
 
-cy_inline b32 cy_string_view_are_equal(CyStringView a, CyStringView b)
+cy_internal cy_inline u8 *cy__hash_map_slot(const CyHashMap *map, isize idx)
 {
-    return (a.len == b.len) && (cy_mem_compare(a.text, b.text, a.len) == 0);
+    return map->slots + idx * map->slot_size;
 }
 
-cy_inline b32 cy_string_view_has_prefix(CyStringView str, const char *prefix)
-{
-    CyStringView other = cy_string_view_create_c(prefix);
-    return cy_string_view_are_equal(
-        cy_string_view_create_len((const char*)str.text, other.len), other
-    );
+// NOTE(cya): the first group is mirrored past the end for wrapping loads
+cy_internal cy_inline void cy__hash_map_set_ctrl(
+    CyHashMap *map, isize idx, u8 ctrl
+) {
+    map->ctrl[idx] = ctrl;
+    if (idx < CY__HASH_MAP_GROUP) {
+        map->ctrl[map->cap + idx] = ctrl;
+    }
 }
 
-b32 cy_string_view_contains(CyStringView str, const char *char_set)
+cy_internal cy_inline isize cy__hash_map_capacity_for(isize cap)
 {
-    isize len = cy_str_len(char_set);
-    // TODO(cya): unicode rune support
-    for (isize i = 0; i < str.len; i++) {
-        for (isize j = 0; j < len; j++) {
-            if (str.text[i] == char_set[j]) {
-                return true;
+    return cap - cap / 8;
+}
+
+/*
+ * Probes a group at a time with triangular steps, which visits every group
+ * when the capacity is a power of two
+ */
+cy_internal isize cy__hash_map_find(
+    const CyHashMap *map, const void *key, u64 hash
+) {
+    if (map->cap == 0) {
+        return -1;
+    }
+
+    usize mask = (usize)map->cap - 1;
+    usize pos = (usize)(hash >> 7) & mask;
+    u8 h2 = (u8)(hash & 0x7F);
+    for (usize step = CY__HASH_MAP_GROUP;; step += CY__HASH_MAP_GROUP) {
+        const u8 *group = map->ctrl + pos;
+        u32 hits = cy__hash_map_match(group, h2);
+        for (; hits != 0; hits &= hits - 1) {
+            usize bit = (usize)cy__u32_trailing_zeros(hits);
+            isize idx = (isize)((pos + bit) & mask);
+            const u8 *slot = cy__hash_map_slot(map, idx);
+            if (
+                *(const u64*)slot == hash &&
+                cy__hash_map_keys_equal(map, slot + 8, key)
+            ) {
+                return idx;
             }
         }
-    }
-
-    return false;
-}
 
-/* =========================== Strings (UTF-16) ============================= */
-#if defined(CY_OS_WINDOWS)
-#define CY__U16S_TO_BYTES(c) (isize)((c) * cy_sizeof(u16))
+        if (cy__hash_map_match(group, CY__HASH_MAP_EMPTY) != 0) {
+            return -1;
+        }
 
-cy_inline isize cy_string_16_len(CyString16 str)
-{
-    return (str == NULL) ? 0 : CY_STRING_HEADER(str)->len;
+        pos = (pos + step) & mask;
+    }
 }
 
-cy_inline isize cy_string_16_cap(CyString16 str)
+cy_internal isize cy__hash_map_find_free(const CyHashMap *map, u64 hash)
 {
-    return (str == NULL) ? 0 : CY_STRING_HEADER(str)->cap;
-}
+    usize mask = (usize)map->cap - 1;
+    usize pos = (usize)(hash >> 7) & mask;
+    for (usize step = CY__HASH_MAP_GROUP;; step += CY__HASH_MAP_GROUP) {
+        u32 free_slots = cy__hash_map_match_free(map->ctrl + pos);
+        if (free_slots != 0) {
+            usize bit = (usize)cy__u32_trailing_zeros(free_slots);
+            return (isize)((pos + bit) & mask);
+        }
 
-cy_inline isize cy_string_16_alloc_size(CyString16 str)
-{
-    isize bytes = CY__U16S_TO_BYTES(cy_string_16_cap(str) + 1);
-    return cy_sizeof(CyStringHeader) + bytes;
+        pos = (pos + step) & mask;
+    }
 }
 
-cy_inline isize cy_string_16_available_space(CyString16 str)
+// NOTE(cya): moves every entry over by its cached hash (drops tombstones)
+cy_internal b32 cy__hash_map_resize(CyHashMap *map, isize cap)
 {
-    CyStringHeader *h = CY_STRING_HEADER(str);
-    if (h->cap > h->len) {
-        return h->cap - h->len;
+    isize ctrl_size = cy_align_forward_size(cap + CY__HASH_MAP_GROUP, 16);
+    u8 *mem = (u8*)cy_alloc_align(
+        map->alloc, ctrl_size + cap * map->slot_size, 16
+    );
+    if (mem == NULL) {
+        return false;
     }
 
-    return 0;
-}
+    CyHashMap old = *map;
+    map->ctrl = mem;
+    map->slots = mem + ctrl_size;
+    map->cap = cap;
+    map->growth_left = cy__hash_map_capacity_for(cap) - map->len;
+    cy_mem_set(map->ctrl, CY__HASH_MAP_EMPTY, cap + CY__HASH_MAP_GROUP);
 
-cy_inline void cy__string_16_set_len(CyString16 str, isize len)
-{
-    if (str == NULL) {
-        return;
-    }
+    for (isize i = 0; i < old.cap; i++) {
+        if (old.ctrl[i] & 0x80) {
+            continue;
+        }
 
-    CY_STRING_HEADER(str)->len = len;
-}
+        const u8 *src = cy__hash_map_slot(&old, i);
+        u64 hash = *(const u64*)src;
+        isize idx = cy__hash_map_find_free(map, hash);
+        cy__hash_map_set_ctrl(map, idx, (u8)(hash & 0x7F));
+        cy_mem_copy(cy__hash_map_slot(map, idx), src, map->slot_size);
+    }
 
-cy_inline void cy__string_16_set_cap(CyString16 str, isize cap)
-{
-    if (str == NULL) {
-        return;
+    if (old.cap > 0) {
+        cy_free(old.alloc, old.ctrl);
     }
 
-    CY_STRING_HEADER(str)->cap = cap;
+    return true;
 }
 
-CyString16 cy_string_16_create_reserve(CyAllocator a, isize cap)
+CyHashMap cy_hash_map_init(CyAllocator a, isize key_size, isize value_size)
 {
-    isize header_size = cy_sizeof(CyStringHeader);
-    isize total_size = CY__U16S_TO_BYTES(header_size + cap + 1);
-    void *ptr = cy_alloc(a, total_size);
-    CY_VALIDATE_PTR(ptr);
-
-    cy_mem_zero(ptr, total_size);
-
-    CyStringHeader *header = ptr;
-    *header = (CyStringHeader){
+    isize value_offset = 8 + cy_align_forward_size(key_size, 8);
+    CyHashMap map = {
         .alloc = a,
-        .len = 0,
-        .cap = cap,
+        .key_size = key_size,
+        .value_size = value_size,
+        .value_offset = value_offset,
+        .slot_size = value_offset + cy_align_forward_size(value_size, 8),
     };
-
-    return (CyString16)(header + 1);
+    return map;
 }
 
-CyString16 cy_string_16_create_len(
-    CyAllocator a, const wchar_t *str, isize len
-) {
-    isize header_size = cy_sizeof(CyStringHeader);
-    isize total_size = CY__U16S_TO_BYTES(header_size + len + 1);
-    void *ptr = cy_alloc(a, total_size);
-    CY_VALIDATE_PTR(ptr);
+CyHashMap cy_hash_map_init_string_keys(CyAllocator a, isize value_size)
+{
+    CyHashMap map = cy_hash_map_init(a, cy_sizeof(CyStringView), value_size);
+    map.string_keys = true;
+    return map;
+}
 
-    if (str == NULL) {
-        cy_mem_zero(ptr, total_size);
+void cy_hash_map_deinit(CyHashMap *map)
+{
+    if (map->cap > 0) {
+        cy_free(map->alloc, map->ctrl);
     }
 
-    CyStringHeader *header = ptr;
-    *header = (CyStringHeader){
-        .alloc = a,
-        .len = len,
-        .cap = len,
-    };
+    map->ctrl = map->slots = NULL;
+    map->cap = map->len = map->growth_left = 0;
+}
 
-    CyString16 string = (CyString16)((uintptr)ptr + (uintptr)header_size);
-    if (len > 0 && str != NULL) {
-        cy_mem_copy(string, str, CY__U16S_TO_BYTES(len));
+b32 cy_hash_map_reserve(CyHashMap *map, isize count)
+{
+    isize cap = CY__HASH_MAP_GROUP;
+    while (cy__hash_map_capacity_for(cap) < count) {
+        cap *= 2;
     }
 
-    string[len] = '\0';
-    return string;
-}
+    if (cap > map->cap) {
+        return cy__hash_map_resize(map, cap);
+    } else if (map->growth_left < count - map->len) {
+        return cy__hash_map_resize(map, map->cap);
+    }
 
-cy_inline CyString16 cy_string_16_create(CyAllocator a, const wchar_t *str)
-{
-    return cy_string_16_create_len(a, str, cy_wcs_len(str));
+    return true;
 }
 
-cy_inline CyString16 cy_string_16_create_view(CyAllocator a, CyString16View str)
+void cy_hash_map_clear(CyHashMap *map)
 {
-    return cy_string_16_create_len(a, (const wchar_t*)str.text, str.len);
+    if (map->cap > 0) {
+        isize ctrl_len = map->cap + CY__HASH_MAP_GROUP;
+        cy_mem_set(map->ctrl, CY__HASH_MAP_EMPTY, ctrl_len);
+    }
+
+    map->len = 0;
+    map->growth_left = cy__hash_map_capacity_for(map->cap);
 }
 
-CyString16 cy_string_16_reserve_space_for(CyString16 str, isize extra_len)
+void *cy_hash_map_get(const CyHashMap *map, const void *key)
 {
-    isize available = cy_string_16_available_space(str);
-    if (available >= extra_len) {
-        return str;
+    isize idx = cy__hash_map_find(map, key, cy__hash_map_hash(map, key));
+    return (idx < 0) ?
+        NULL : cy__hash_map_slot(map, idx) + map->value_offset;
+}
+
+void *cy_hash_map_get_or_insert(
+    CyHashMap *map, const void *key, b32 *inserted
+) {
+    u64 hash = cy__hash_map_hash(map, key);
+    isize idx = cy__hash_map_find(map, key, hash);
+    if (inserted != NULL) {
+        *inserted = idx < 0;
+    }
+    if (idx >= 0) {
+        return cy__hash_map_slot(map, idx) + map->value_offset;
+    }
+
+    // NOTE(cya): reusing a tombstone doesn't take up any more room
+    idx = (map->cap > 0) ? cy__hash_map_find_free(map, hash) : -1;
+    if (
+        idx < 0 ||
+        (map->growth_left == 0 && map->ctrl[idx] == CY__HASH_MAP_EMPTY)
+    ) {
+        // NOTE(cya): mostly tombstones means a same-size rehash is enough
+        isize cap = map->cap;
+        if (cap == 0) {
+            cap = CY__HASH_MAP_GROUP;
+        } else if (map->len >= cy__hash_map_capacity_for(cap) / 2) {
+            cap *= 2;
+        }
+        if (!cy__hash_map_resize(map, cap)) {
+            return NULL;
+        }
+
+        idx = cy__hash_map_find_free(map, hash);
     }
 
-    void *mem = CY_STRING_HEADER(str);
-    CyStringHeader *header = mem;
-    CyAllocator a = header->alloc;
+    if (map->ctrl[idx] == CY__HASH_MAP_EMPTY) {
+        map->growth_left -= 1;
+    }
 
-    isize header_size = cy_sizeof(*header);
-    isize old_cap = cy_string_16_cap(str);
-    isize new_cap = cy_string_16_len(str) + extra_len;
-    isize old_size = header_size + CY__U16S_TO_BYTES(old_cap + 1);
-    isize new_size = header_size + CY__U16S_TO_BYTES(new_cap + 1);
+    cy__hash_map_set_ctrl(map, idx, (u8)(hash & 0x7F));
+    map->len += 1;
 
-    void *new_mem = cy_resize(a, mem, old_size, new_size);
-    CY_VALIDATE_PTR(new_mem);
+    u8 *slot = cy__hash_map_slot(map, idx);
+    *(u64*)slot = hash;
+    cy_mem_copy(slot + 8, key, map->key_size);
+    return cy_mem_zero(slot + map->value_offset, map->value_size);
+}
 
-    header = new_mem;
-    header->alloc = a;
+void *cy_hash_map_put(CyHashMap *map, const void *key, const void *value)
+{
+    void *dst = cy_hash_map_get_or_insert(map, key, NULL);
+    CY_VALIDATE_PTR(dst);
 
-    str = (CyString16)(header + 1);
-    cy__string_16_set_cap(str, new_cap);
-    return str;
+    return cy_mem_copy(dst, value, map->value_size);
 }
 
-CyString16 cy_string_16_shrink(CyString16 str)
+b32 cy_hash_map_remove(CyHashMap *map, const void *key)
 {
-    CY_VALIDATE_PTR(str);
+    isize idx = cy__hash_map_find(map, key, cy__hash_map_hash(map, key));
+    if (idx < 0) {
+        return false;
+    }
 
-    isize len = cy_string_16_len(str), cap = cy_string_16_cap(str);
-    isize header_size = cy_sizeof(CyStringHeader);
-    isize old_size = header_size + CY__U16S_TO_BYTES(cap + 1);
-    isize new_size = header_size + CY__U16S_TO_BYTES(len + 1);
-    void *ptr = (u8*)str - header_size;
-    if (new_size < old_size) {
-        ptr = cy_resize(CY_STRING_HEADER(str)->alloc, ptr, old_size, new_size);
-        str = (CyString16)((uintptr)ptr + (uintptr)header_size);
-        cy__string_16_set_cap(str, len);
+    cy__hash_map_set_ctrl(map, idx, CY__HASH_MAP_DELETED);
+    map->len -= 1;
+    return true;
+}
+
+b32 cy_hash_map_next(
+    const CyHashMap *map, isize *idx, void **key, void **value
+) {
+    for (isize i = *idx; i < map->cap; i++) {
+        if ((map->ctrl[i] & 0x80) == 0) {
+            u8 *slot = cy__hash_map_slot(map, i);
+            *key = slot + 8;
+            *value = slot + map->value_offset;
+            *idx = i + 1;
+            return true;
+        }
     }
 
-    return str;
+    *idx = map->cap;
+    return false;
 }
 
-cy_inline CyString16 cy_string_16_resize(CyString16 str, isize new_cap)
-{
-    void *mem = CY_STRING_HEADER(str);
-    CyStringHeader *header = mem;
-    CyAllocator a = header->alloc;
+/* ============================ String interning ============================ */
+#define CY__INTERN_SEGMENT_BASE 64
+#define CY__INTERN_MIN_CAP 128
 
-    isize header_size = cy_sizeof(*header);
-    isize old_cap = cy_string_16_cap(str);
-    isize old_size = header_size + CY__U16S_TO_BYTES(old_cap + 1);
-    isize new_size = header_size + CY__U16S_TO_BYTES(new_cap + 1);
-    void *new_mem = cy_resize(a, mem, old_size, new_size);
-    CY_VALIDATE_PTR(new_mem);
+cy_internal cy_inline CyPrivInternEntry *cy__interner_entry(
+    CyInterner *interner, u32 id
+) {
+    u64 n = id / CY__INTERN_SEGMENT_BASE + 1;
+    i32 seg = cy__u64_bit_len(n) - 1;
+    isize first = CY__INTERN_SEGMENT_BASE * (((isize)1 << seg) - 1);
+    void *entries = cy__atomic_load_ptr_acquire(
+        (void *volatile*)&interner->segments[seg]
+    );
+    return (CyPrivInternEntry*)entries + ((isize)id - first);
+}
 
-    header = new_mem;
-    header->alloc = a;
+cy_internal u32 cy__interner_lookup(
+    CyInterner *interner, const CyPrivInternTable *table,
+    CyStringView str, u64 hash
+) {
+    if (table == NULL) {
+        return CY_INTERN_NONE;
+    }
 
-    str = (CyString16)(header + 1);
-    cy__string_16_set_cap(str, new_cap);
-    return str;
+    usize mask = table->mask;
+    for (usize pos = (usize)hash & mask;; pos = (pos + 1) & mask) {
+        u32 slot = cy__atomic_load_u32_acquire(&table->slots[pos]);
+        if (slot == 0) {
+            return CY_INTERN_NONE;
+        }
+
+        const CyPrivInternEntry *entry = cy__interner_entry(interner, slot - 1);
+        if (entry->hash == hash && cy_string_view_are_equal(entry->str, str)) {
+            return slot - 1;
+        }
+    }
 }
 
-cy_inline void cy_string_16_free(CyString16 str)
-{
-    if (str != NULL) {
-        cy_free(CY_STRING_HEADER(str)->alloc, CY_STRING_HEADER(str));
+cy_internal void cy__interner_table_put(
+    CyPrivInternTable *table, u64 hash, u32 id
+) {
+    usize pos = (usize)hash & table->mask;
+    while (table->slots[pos] != 0) {
+        pos = (pos + 1) & table->mask;
     }
+
+    cy__atomic_store_u32_release(&table->slots[pos], id + 1);
 }
 
-cy_inline void cy_string_16_clear(CyString16 str)
-{
-    if (str == NULL) {
-        return;
+/*
+ * Readers holding on to the old table just won't see entries added after the
+ * swap (and inserts recheck under the lock), so it stays in the arena as is
+ */
+cy_internal CyPrivInternTable *cy__interner_grow(
+    CyInterner *interner, CyPrivInternTable *old, u32 count
+) {
+    isize cap = (old == NULL) ? CY__INTERN_MIN_CAP : (isize)(old->mask + 1) * 2;
+    CyPrivInternTable *table = cy_arena_push_struct(
+        interner->arena, CyPrivInternTable
+    );
+    u32 *slots = cy_arena_push_array(interner->arena, u32, cap);
+    if (table == NULL || slots == NULL) {
+        return NULL;
     }
 
-    cy_mem_zero(str, CY__U16S_TO_BYTES(cy_string_16_cap(str)));
-    cy__string_16_set_len(str, 0);
+    table->mask = (usize)cap - 1;
+    table->slots = slots;
+    for (u32 id = 0; id < count; id++) {
+        u64 hash = cy__interner_entry(interner, id)->hash;
+        cy__interner_table_put(table, hash, id);
+    }
+
+    cy__atomic_store_ptr_release((void *volatile*)&interner->table, table);
+    return table;
 }
 
-CyString16 cy_string_16_append_len(
-    CyString16 str, const wchar_t *other, isize len
+cy_internal u32 cy__interner_insert_locked(
+    CyInterner *interner, CyStringView str, u64 hash
 ) {
-    if (len > 0) {
-        isize cur_len = cy_string_16_len(str);
+    CyPrivInternTable *table = interner->table;
+    u32 id = (u32)interner->count;
+    if (id == CY_INTERN_NONE - 1) {
+        return CY_INTERN_NONE;
+    }
 
-        str = cy_string_16_reserve_space_for(str, len);
-        CY_VALIDATE_PTR(str);
+    // NOTE(cya): keeping it under half full keeps the linear probes short
+    if (table == NULL || (usize)(id + 1) * 2 > table->mask + 1) {
+        table = cy__interner_grow(interner, table, id);
+        if (table == NULL) {
+            return CY_INTERN_NONE;
+        }
+    }
 
-        cy_mem_copy(str + cur_len, other, CY__U16S_TO_BYTES(len));
+    i32 seg = cy__u64_bit_len(id / CY__INTERN_SEGMENT_BASE + 1) - 1;
+    if (interner->segments[seg] == NULL) {
+        isize len = (isize)CY__INTERN_SEGMENT_BASE << seg;
+        CyPrivInternEntry *entries = cy_arena_push_array(
+            interner->arena, CyPrivInternEntry, len
+        );
+        if (entries == NULL) {
+            return CY_INTERN_NONE;
+        }
 
-        isize new_len = cur_len + len;
-        str[new_len] = '\0';
+        cy__atomic_store_ptr_release(
+            (void *volatile*)&interner->segments[seg], entries
+        );
+    }
 
-        cy__string_16_set_len(str, new_len);
+    char *text = (char*)cy_arena_push(interner->arena, str.len + 1, 1);
+    if (text == NULL) {
+        return CY_INTERN_NONE;
     }
 
-    return str;
+    cy_mem_copy(text, str.text, str.len);
+    text[str.len] = '\0';
+
+    CyPrivInternEntry *entry = cy__interner_entry(interner, id);
+    entry->hash = hash;
+    entry->str = cy_string_view_create_len(text, str.len);
+
+    // NOTE(cya): the entry (and count) are done by the time the slot shows up
+    cy__atomic_store_release(&interner->count, id + 1);
+    cy__interner_table_put(table, hash, id);
+    return id;
 }
 
-cy_inline CyString16 cy_string_16_append(CyString16 str, const CyString16 other)
+CyInterner cy_interner_init(CyArena *arena)
 {
-    return cy_string_16_append_len(str, other, cy_string_16_len(other));
+    CyInterner interner = {.arena = arena};
+    return interner;
 }
 
-cy_inline CyString16 cy_string_16_append_c(CyString16 str, const wchar_t *other)
+u32 cy_interner_intern(CyInterner *interner, CyStringView str)
 {
-    return cy_string_16_append_len(str, other, cy_wcs_len(other));
+    u64 hash = cy_hash_string_view(str);
+    CyPrivInternTable *table = (CyPrivInternTable*)cy__atomic_load_ptr_acquire(
+        (void *volatile*)&interner->table
+    );
+    u32 id = cy__interner_lookup(interner, table, str, hash);
+    if (id != CY_INTERN_NONE) {
+        return id;
+    }
+
+    while (!cy__atomic_cas(&interner->lock, 0, 1)) {
+        while (cy__atomic_load_acquire(&interner->lock) != 0) {}
+    }
+
+    // NOTE(cya): someone else might've added it (or grown the table) meanwhile
+    id = cy__interner_lookup(interner, interner->table, str, hash);
+    if (id == CY_INTERN_NONE) {
+        id = cy__interner_insert_locked(interner, str, hash);
+    }
+
+    cy__atomic_store_release(&interner->lock, 0);
+    return id;
 }
 
-cy_inline CyString16 cy_string_16_append_view(CyString16 str, CyString16View view)
+CyStringView cy_interner_intern_view(CyInterner *interner, CyStringView str)
 {
-    return cy_string_16_append_len(str, (const wchar_t*)view.text, view.len);
+    u32 id = cy_interner_intern(interner, str);
+    return (id == CY_INTERN_NONE) ?
+        (CyStringView){0} : cy_interner_get(interner, id);
 }
 
-/* ---------------------------- String16 views ------------------------------ */
-cy_inline CyString16View cy_string_16_view_create_len(
-    const wchar_t *str, isize len
-) {
-    if (len < 0) {
-        len = cy_wcs_len(str);
-    }
+u32 cy_interner_find(CyInterner *interner, CyStringView str)
+{
+    CyPrivInternTable *table = (CyPrivInternTable*)cy__atomic_load_ptr_acquire(
+        (void *volatile*)&interner->table
+    );
+    return cy__interner_lookup(interner, table, str, cy_hash_string_view(str));
+}
 
-    return (CyString16View){
-        .text = (const u16*)str,
-        .len = len,
-    };
+cy_inline CyStringView cy_interner_get(CyInterner *interner, u32 id)
+{
+    CY_ASSERT(id < cy_interner_count(interner));
+    return cy__interner_entry(interner, id)->str;
 }
 
-cy_inline CyString16View cy_string_16_view_create(CyString16 str)
+cy_inline isize cy_interner_count(CyInterner *interner)
 {
-    return cy_string_16_view_create_len(str, cy_string_16_len(str));
+    return (isize)cy__atomic_load_acquire(&interner->count);
 }
 
-cy_inline CyString16View cy_string_16_view_create_c(const wchar_t *str)
+/* ================================= Arrays ================================= */
+#define CY__ARRAY_MIN_CAP 8
+
+cy_internal cy_inline isize cy__array_alloc_size(isize item_size, isize cap)
 {
-    return cy_string_16_view_create_len(str, cy_wcs_len(str));
+    return cy_sizeof(CyArrayHeader) + item_size * cap;
 }
 
-CyString16View cy_string_16_view_substring(
-    CyString16View str, isize begin_idx, isize end_idx
-) {
-    isize max = str.len, lo = begin_idx, hi = end_idx;
-    CY_ASSERT_MSG(lo <= hi && hi <= max, "%td..%td..%td", lo, hi, max);
+void *cy__array_create(CyAllocator a, isize item_size, isize cap)
+{
+    CY_ASSERT(item_size > 0 && cap >= 0);
+    void *ptr = cy_alloc(a, cy__array_alloc_size(item_size, cap));
+    CY_VALIDATE_PTR(ptr);
 
-    return cy_string_16_view_create_len((const wchar_t*)str.text + lo, hi - lo);
+    CyArrayHeader *header = ptr;
+    *header = (CyArrayHeader){
+        .alloc = a,
+        .len = 0,
+        .cap = cap,
+    };
+
+    return header + 1;
 }
 
-cy_inline b32 cy_string_16_view_are_equal(CyString16View a, CyString16View b)
+void *cy__array_reserve_space_for(void *arr, isize item_size, isize extra_len)
 {
-    return (a.len == b.len) && (
-        cy_mem_compare(a.text, b.text, CY__U16S_TO_BYTES(a.len)) == 0
+    CY_VALIDATE_PTR(arr);
+
+    CyArrayHeader *header = CY_ARRAY_HEADER(arr);
+    isize len = header->len, cap = header->cap;
+    if (cap - len >= extra_len) {
+        return arr;
+    }
+
+    isize max_cap = (ISIZE_MAX - cy_sizeof(*header)) / item_size;
+    if (extra_len > max_cap - len) {
+        return NULL;
+    }
+
+    // NOTE(cya): doubling keeps pushes amortized O(1), and since growth goes
+    // through cy_resize an arena (last allocation) or the VM allocator can
+    // usually extend the block in place instead of copying it
+    isize new_cap = CY_MAX(cap, CY__ARRAY_MIN_CAP / 2);
+    new_cap = (new_cap > max_cap / 2) ? max_cap : new_cap * 2;
+    new_cap = CY_MAX(new_cap, len + extra_len);
+
+    CyAllocator a = header->alloc;
+    void *new_mem = cy_resize(
+        a, header,
+        cy__array_alloc_size(item_size, cap),
+        cy__array_alloc_size(item_size, new_cap)
     );
+    CY_VALIDATE_PTR(new_mem);
+
+    header = new_mem;
+    header->alloc = a;
+    header->cap = new_cap;
+    return header + 1;
 }
 
-cy_inline b32 cy_string_16_view_has_prefix(
-    CyString16View str, const wchar_t *prefix
+void *cy__array_insert(
+    void *arr, isize item_size, isize idx, const void *items, isize count
 ) {
-    CyString16View other = cy_string_16_view_create_c(prefix);
-    return cy_string_16_view_are_equal(
-        cy_string_16_view_create_len((const wchar_t*)str.text, other.len), other
-    );
+    CY_ASSERT(idx >= 0 && idx <= cy_array_len(arr) && count >= 0);
+    arr = cy__array_reserve_space_for(arr, item_size, count);
+    CY_VALIDATE_PTR(arr);
+
+    CyArrayHeader *header = CY_ARRAY_HEADER(arr);
+    u8 *at = (u8*)arr + idx * item_size;
+    isize bytes = count * item_size;
+    if (idx < header->len) {
+        cy_mem_move(at + bytes, at, (header->len - idx) * item_size);
+    }
+    if (items != NULL) {
+        cy_mem_copy(at, items, bytes);
+    } else {
+        cy_mem_zero(at, bytes);
+    }
+
+    header->len += count;
+    return arr;
 }
 
-b32 cy_string_16_view_contains(CyString16View str, const wchar_t *char_set)
+void cy__array_remove(void *arr, isize item_size, isize idx, isize count)
 {
-    isize len = cy_wcs_len(char_set);
-    for (isize i = 0; i < str.len; i++) {
-        for (isize j = 0; j < len; j++) {
-            if (str.text[i] == char_set[j]) {
-                return true;
-            }
-        }
+    CyArrayHeader *header = CY_ARRAY_HEADER(arr);
+    CY_ASSERT(idx >= 0 && count >= 0 && count <= header->len - idx);
+
+    u8 *at = (u8*)arr + idx * item_size;
+    isize tail = header->len - idx - count;
+    if (tail > 0) {
+        cy_mem_move(at, at + count * item_size, tail * item_size);
     }
 
-    return false;
+    header->len -= count;
 }
-#endif // CY_OS_WINDOWS
 
-/* ============================ Unicode helpers ============================= */
-// TODO(cya): implement
-#if 0
-cy_global u8 cy__utf8_class_table[32] = {
-    0, 0, 0, 0, // 0 = 0xxxx
-    0, 0, 0, 0, // 1 = 10xxx
-    0, 0, 0, 0, // 2 = 110xx
-    0, 0, 0, 0, // 3 = 1110x
-    1, 1, 1, 1, // 4 = 11110
-    1, 1, 1, 1, // 5 = 11111 (invalid)
-    2, 2, 2, 2,
-    3, 3, 4, 5,
-};
+void cy__array_remove_swap(void *arr, isize item_size, isize idx)
+{
+    CyArrayHeader *header = CY_ARRAY_HEADER(arr);
+    CY_ASSERT(idx >= 0 && idx < header->len);
 
-isize cy_utf8_encode_rune(u8 buf[4], Rune r)
+    isize last = --header->len;
+    if (idx != last) {
+        u8 *items = arr;
+        u8 *dst = items + idx * item_size, *src = items + last * item_size;
+        cy_mem_copy(dst, src, item_size);
+    }
+}
+
+void *cy__array_resize(void *arr, isize item_size, isize len)
 {
-    return 0;
+    CY_VALIDATE_PTR(arr);
+    CY_ASSERT(len >= 0);
+
+    isize cur_len = CY_ARRAY_HEADER(arr)->len;
+    if (len > cur_len) {
+        return cy__array_insert(arr, item_size, cur_len, NULL, len - cur_len);
+    }
+
+    CY_ARRAY_HEADER(arr)->len = len;
+    return arr;
 }
 
-isize cy_utf8_decode(const u8 *str, Rune *codepoint_out)
+void *cy__array_shrink(void *arr, isize item_size)
 {
-    return 0;
+    CY_VALIDATE_PTR(arr);
+
+    CyArrayHeader *header = CY_ARRAY_HEADER(arr);
+    isize len = header->len, cap = header->cap;
+    if (len < cap) {
+        CyAllocator a = header->alloc;
+        void *ptr = cy_resize(
+            a, header,
+            cy__array_alloc_size(item_size, cap),
+            cy__array_alloc_size(item_size, len)
+        );
+        CY_VALIDATE_PTR(ptr);
+
+        header = ptr;
+        header->alloc = a;
+        header->cap = len;
+    }
+
+    return header + 1;
 }
-#endif
 
-cy_inline isize cy_utf8_codepoints(const char *str)
+cy_inline isize cy_array_len(const void *arr)
 {
-    isize count = 0;
-    while (*str != '\0') {
-        u8 c = (u8)*str;
-        u8 inc = 0;
-        if (c < 0x80) {
-            inc = 1;
-        } else if ((c & 0xE0) == 0xC0) {
-            inc = 2;
-        } else if ((c & 0xF0) == 0xE0) {
-            inc = 3;
-        } else if ((c & 0xF8) == 0xF0) {
-            inc = 4;
-        } else {
-            return -1;
-        }
+    return (arr == NULL) ? 0 : CY_ARRAY_HEADER(arr)->len;
+}
 
-        str += inc;
-        count += 1;
+cy_inline isize cy_array_cap(const void *arr)
+{
+    return (arr == NULL) ? 0 : CY_ARRAY_HEADER(arr)->cap;
+}
+
+cy_inline void cy_array_clear(void *arr)
+{
+    if (arr != NULL) {
+        CY_ARRAY_HEADER(arr)->len = 0;
     }
+}
 
-    return count;
+cy_inline void cy_array_free(void *arr)
+{
+    if (arr != NULL) {
+        cy_free(CY_ARRAY_HEADER(arr)->alloc, CY_ARRAY_HEADER(arr));
+    }
 }
 
 #if defined(CY_COMPILER_MSVC)
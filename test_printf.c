@@ -6,6 +6,20 @@
 
 extern int printf(const char*, ...);
 
+typedef struct {
+    u8 octets[4];
+} IPv4;
+
+CY_FORMAT_PROC(format_ipv4)
+{
+    (void)opts;
+    const IPv4 *ip = arg;
+    cy_format_writef(
+        w, "%u.%u.%u.%u",
+        ip->octets[0], ip->octets[1], ip->octets[2], ip->octets[3]
+    );
+}
+
 int main(void)
 {
     int written = -1;
@@ -193,6 +207,27 @@ int main(void)
     u32 u = 24;
     cy_printf("sized int: %32 after-int: %u\n", &u, u);
     cy_printf("zero precision: %.0u\n", 0);
+    cy_printf("round-trip float: %r (%%g: %g)\n", 0.1 + 0.2, 0.1 + 0.2);
+    isize parsed_len;
+    f64 parsed = cy_str_to_f64("-0.30000000000000004e0xyz", &parsed_len);
+    cy_printf(
+        "parsed float: %r (len: %zd, exact: %s)\n",
+        parsed, parsed_len, (parsed == -(0.1 + 0.2)) ? "yes" : "no"
+    );
+
+    CyFormat compiled = cy_format_compile("compiled: `%-6s|%5.2f|%#x|%u16`");
+    len = cy_sprintf_compiled(buf, buf_size, &compiled, "fmt", f, 255, 80);
+    cy_printf("%s (len: %zd)\n", buf, len);
+    cy_format_free(&compiled);
+
+    IPv4 localhost = {{127, 0, 0, 1}};
+    cy_format_register("ip", format_ipv4);
+    cy_printf("custom spec: `%{ip}`\n", &localhost);
+
+    cy_log_thread_init(cy_heap_allocator(), 4096);
+    cy_log("deferred log: `%s` %d %{ip}\n", "hello", 42, &localhost);
+    cy_log_drain(cy_file_get_std_handle(CY_FILE_STD_OUT));
+    cy_log_thread_deinit();
 
     return 0;
 }
@@ -1,4 +1,5 @@
 #define CY_IMPLEMENTATION
+#define CY_TRACK_ALLOCATIONS
 #include "cy.h"
 
 #include "testutils.h"
@@ -136,6 +137,42 @@ static void test_arena_allocator(void)
         f64 size = arena.cur_block->size / KB;
         print_s("freed whole arena (Available size: %.2lfKB)", size);
     }
+    {
+        CyMemoryBlock *first_block = arena.cur_block;
+        (void)cy_alloc(a, 0x10);
+        isize offset = first_block->offset;
+
+        CyArenaTemp temp = cy_arena_temp_begin(&arena);
+        (void)cy_alloc(a, first_block->size);
+        TEST_ASSERT(
+            arena.cur_block != first_block, "expected arena to grow"
+        );
+
+        cy_arena_temp_end(temp);
+        TEST_ASSERT(
+            arena.cur_block == first_block && first_block->offset == offset,
+            "arena temp scope did not roll back"
+        );
+        print_s("rolled back arena temp scope (ofs: %zu)", offset);
+    }
+    {
+        CyArena *conflicts[1];
+        CyArenaTemp outer = cy_arena_scratch_begin(NULL, 0);
+        conflicts[0] = outer.arena;
+
+        CyArenaTemp inner = cy_arena_scratch_begin(conflicts, 1);
+        TEST_ASSERT(
+            inner.arena != outer.arena, "nested scratch arenas conflicted"
+        );
+
+        char *str = cy_alloc_string(cy_arena_allocator(inner.arena), "scratch");
+        print_s("allocated into scratch arena: '%s'", str);
+
+        cy_arena_scratch_end(inner);
+        cy_arena_scratch_end(outer);
+        cy_arena_scratch_release();
+        print_s("released scratch arenas");
+    }
 
     cy_arena_deinit(&arena);
     print_s("deinitialized arena");
@@ -201,6 +238,72 @@ static void test_stack_allocator(void)
         cy_free(a, buf);
         print_s("freed string from stack (LIFO check)");
     }
+    {
+        cy_free_all(a);
+
+        isize node_size = stack.state.first_node->size;
+        void *lo = cy_alloc(a, node_size / 2);
+        void *hi = cy_alloc(a, node_size);
+        TEST_ASSERT(
+            stack.state.stats.nodes == 2, "expected the stack to grow"
+        );
+
+        cy_free(a, lo);
+        print_s("freed across nodes out of order");
+
+        cy_free(a, hi);
+        CyStackStats stats = cy_stack_stats(&stack);
+        TEST_ASSERT(
+            stats.used == 0 && stats.pending_free == 0 && stats.nodes == 1,
+            "stack did not reclaim out-of-order free"
+        );
+        print_s(
+            "reclaimed stack (peak used: %.2lfKB, peak reserved: %.2lfKB)",
+            stats.peak_used / KB, stats.peak_reserved / KB
+        );
+    }
+    {
+        void *lo = cy_alloc(a, 64);
+        void *hi = cy_alloc(a, 64);
+        cy_free(a, lo);
+        cy_free(a, lo);
+        cy_free(a, hi);
+        cy_free(a, hi);
+
+        CyStackStats stats = cy_stack_stats(&stack);
+        TEST_ASSERT(
+            stats.used == 0 && stats.pending_free == 0,
+            "double free left memory pending"
+        );
+        print_s("ignored double frees");
+    }
+    {
+        isize node_size = stack.state.first_node->size;
+        (void)cy_alloc(a, node_size / 2);
+        void *hi = cy_alloc(a, node_size);
+        void *rest = a.proc(
+            a.data, CY_ALLOCATION_ALLOC_ALL, 0, CY_DEFAULT_ALIGNMENT,
+            NULL, 0, 0
+        );
+        TEST_ASSERT_NOT_NULL(rest, "unable to allocate the rest of the stack");
+
+        CyStackNode *node = stack.state.first_node;
+        CyStackStats stats = cy_stack_stats(&stack);
+        TEST_ASSERT(
+            stats.nodes == 1 && stats.reserved == node->size &&
+                stats.used == node->offset && stack.state.top == hi,
+            "stats out of sync after releasing nodes"
+        );
+
+        cy_free(stack.backing, rest);
+        cy_free(a, hi);
+        stats = cy_stack_stats(&stack);
+        TEST_ASSERT(
+            stats.used == 0 && stack.state.top == NULL,
+            "stack not empty after freeing the surviving allocation"
+        );
+        print_s("released older nodes (%.2lfKB left)", stats.reserved / KB);
+    }
 
     cy_stack_deinit(&stack);
     print_s("deinitialized stack");
@@ -227,11 +330,168 @@ static void test_pool_allocator(void)
 
     cy_free_all(a);
     print_s("freed all chunks in pool");
-    
+
+    {
+        f64 *items[8];
+        f64 **res = (f64**)cy_alloc_batch(a, f64, items, CY_ARRAY_LEN(items));
+        TEST_ASSERT_NOT_NULL(res, "unable to batch-allocate pool chunks");
+        TEST_ASSERT(
+            pool.free_list_head == NULL, "batch did not exhaust the pool"
+        );
+        print_s("batch-allocated %td pool chunks", CY_ARRAY_LEN(items));
+
+        cy_free(a, items[0]);
+        res = (f64**)cy_alloc_batch(a, f64, items, 2);
+        TEST_ASSERT(res == NULL, "batch should fail when the pool is short");
+        TEST_ASSERT(
+            pool.free_list_head != NULL, "failed batch modified the pool"
+        );
+        print_s("rejected oversized pool batch");
+    }
+
+    cy_free_all(a);
+
     cy_pool_deinit(&pool);
     print_s("deinitialized pool");
 }
 
+static const CyAllocSite *find_alloc_site(
+    const CyAllocTracker *tracker, i32 line
+) {
+    for (isize i = 0; i <= CY_ALLOC_TRACKER_MAX_SITES; i++) {
+        const CyAllocSite *site = &tracker->sites[i];
+        if (
+            site->file != NULL && site->line == line &&
+            cy_str_compare(site->file, __FILE__) == 0
+        ) {
+            return site;
+        }
+    }
+
+    return NULL;
+}
+
+static void test_tracking_allocator(void)
+{
+    cy_printf("%sTesting Tracking Allocator...%s\n", VT_BOLD, VT_RESET);
+
+    CyAllocTracker tracker = cy_alloc_tracker_init(cy_heap_allocator());
+    CyAllocator a = cy_alloc_tracker_allocator(&tracker);
+    print_s("initialized tracker");
+
+    i32 small_line = __LINE__ + 1;
+    void *small = cy_alloc(a, 0x100);
+    i32 big_line = __LINE__ + 1;
+    void *big = cy_alloc_align(a, 0x1000, 64);
+    TEST_ASSERT(
+        (uintptr)big % 64 == 0, "returned memory is not properly aligned"
+    );
+    TEST_ASSERT(
+        tracker.bytes_in_flight == 0x1100, "unexpected bytes in flight"
+    );
+    print_s("tracked allocations (%td bytes)", tracker.bytes_in_flight);
+
+    i32 resize_line = __LINE__ + 1;
+    big = cy_resize_align(a, big, 0x1000, 0x2000, 64);
+    TEST_ASSERT_NOT_NULL(big, "unable to resize tracked allocation");
+    cy_free(a, small);
+    TEST_ASSERT(
+        tracker.bytes_in_flight == 0x2000 && tracker.peak_bytes == 0x2100,
+        "unexpected bytes in flight after resize/free"
+    );
+    print_s("tracked resize and free (peak: %td bytes)", tracker.peak_bytes);
+
+    const CyAllocSite *small_site = find_alloc_site(&tracker, small_line);
+    const CyAllocSite *big_site = find_alloc_site(&tracker, big_line);
+    const CyAllocSite *resize_site = find_alloc_site(&tracker, resize_line);
+    TEST_ASSERT(
+        small_site != NULL && big_site != NULL && resize_site != NULL,
+        "call sites were not captured"
+    );
+    TEST_ASSERT(
+        small_site->allocs == 1 && small_site->bytes_total == 0x100 &&
+            small_site->bytes_in_flight == 0,
+        "wrong stats for the freed allocation's site"
+    );
+    TEST_ASSERT(
+        big_site->allocs == 1 && big_site->bytes_total == 0x1000 &&
+            big_site->bytes_in_flight == 0 && big_site->peak_bytes == 0x1000,
+        "wrong stats for the resized allocation's site"
+    );
+    TEST_ASSERT(
+        resize_site->allocs == 0 && resize_site->resizes == 1 &&
+            resize_site->bytes_in_flight == 0x2000,
+        "wrong stats for the resizing site"
+    );
+    TEST_ASSERT(
+        tracker.alloc_count == 2 && tracker.resize_count == 1,
+        "unexpected call counts"
+    );
+    print_s("captured allocation call sites");
+
+    cy_free(a, big);
+    cy_alloc_tracker_deinit(&tracker);
+    print_s("deinitialized tracker");
+
+    CyArena arena = cy_arena_init(cy_heap_allocator(), 0x4000);
+    tracker = cy_alloc_tracker_init(cy_arena_allocator(&arena));
+    a = cy_alloc_tracker_allocator(&tracker);
+
+    i32 arena_line = __LINE__ + 1;
+    u8 *bytes = cy_alloc(a, 0x400);
+    TEST_ASSERT_NOT_NULL(bytes, "unable to allocate from tracked arena");
+    cy_free_all(a);
+    TEST_ASSERT(
+        tracker.bytes_in_flight == 0, "bytes still in flight after free_all"
+    );
+
+    // NOTE(cya): reuses the arena memory released by free_all
+    bytes = cy_alloc(a, 0x400);
+    TEST_ASSERT_NOT_NULL(bytes, "unable to allocate after free_all");
+    cy_mem_set(bytes, 0x41, 0x400);
+    TEST_ASSERT_NOT_NULL(cy_alloc(a, 0x10), "unable to allocate after fill");
+    TEST_ASSERT(
+        bytes[0] == 0x41 && bytes[0x3FF] == 0x41,
+        "tracked allocation overwrote user data after free_all"
+    );
+
+    const CyAllocSite *arena_site = find_alloc_site(&tracker, arena_line);
+    TEST_ASSERT(
+        arena_site != NULL && arena_site->allocs == 1 &&
+            arena_site->bytes_in_flight == 0,
+        "site table was clobbered after free_all"
+    );
+    print_s("kept the site table across free_all");
+
+    cy_alloc_tracker_deinit(&tracker);
+    cy_arena_deinit(&arena);
+}
+
+static void test_c_strings(void)
+{
+    cy_printf("%sTesting C-Strings...%s\n", VT_BOLD, VT_RESET);
+
+    // NOTE(cya): virtual memory blocks end right before a guard page
+    CyMemoryBlock *block = cy_virtual_memory_alloc(4);
+    TEST_ASSERT_NOT_NULL(block, "unable to allocate virtual memory");
+
+    char *str = block->start;
+    cy_mem_copy(str, "abc", 4);
+
+    const char *other = "xyz-some-longer-literal-here-0123456789";
+    TEST_ASSERT(
+        cy_str_compare_n(str, other, 32) == 'a' - 'x',
+        "wrong result comparing against a longer string"
+    );
+    TEST_ASSERT(
+        cy_str_compare_n(str, "abc", 4) == 0 && cy_str_compare(str, other) < 0,
+        "wrong result comparing strings"
+    );
+    print_s("compared strings ending at a page boundary");
+
+    cy_virtual_memory_free(block);
+}
+
 static void test_cy_strings(void)
 {
     cy_printf("%sTesting CyStrings...%s\n", VT_BOLD, VT_RESET);
@@ -303,17 +563,604 @@ static void test_cy_strings(void)
 
     print_s("trimmed trailing whitespace from string, result: '%s'", str);
 
+    u64 parsed;
+    isize parsed_len;
+    CyStringView num = cy_string_view_create_c("18446744073709551615123");
+    CyParseError err = cy_string_view_to_u64(
+        cy_string_view_substring(num, 0, 20), 10, &parsed, &parsed_len
+    );
+    TEST_ASSERT(
+        err == CY_PARSE_ERROR_NONE && parsed == U64_MAX && parsed_len == 20,
+        "unable to parse number from view: %s", cy_parse_error_as_str(err)
+    );
+
+    err = cy_string_view_to_u64(num, 10, &parsed, &parsed_len);
+    TEST_ASSERT(
+        err == CY_PARSE_ERROR_OVERFLOW && parsed_len == num.len,
+        "overflow not reported: %s", cy_parse_error_as_str(err)
+    );
+
+    print_s("parsed integers from string views");
+
     cy_free_all(a);
     print_s("freed all strings");
 }
 
+static void test_char_sets(void)
+{
+    cy_printf("%sTesting Char Sets...%s\n", VT_BOLD, VT_RESET);
+
+    // NOTE(cya): long enough for a few SIMD blocks before the first match
+    char buf[200];
+    cy_mem_set(buf, ' ', cy_sizeof(buf));
+    buf[150] = 'x', buf[170] = 'y';
+    CyStringView text = cy_string_view_create_len(buf, cy_sizeof(buf));
+
+    CyCharSet spaces = cy_char_set_create(" \t");
+    CyCharSet xy = cy_char_set_create("xy");
+    CyCharSet alnum = cy_char_set_create(
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    );
+    TEST_ASSERT(
+        cy_char_set_has(&alnum, 'Z') && !cy_char_set_has(&alnum, ' '),
+        "wrong char set membership"
+    );
+    TEST_ASSERT(
+        cy_string_view_index_any(text, &xy) == 150 &&
+            cy_string_view_index_any(text, &alnum) == 150 &&
+            cy_string_view_last_index_any(text, &xy) == 170 &&
+            cy_string_view_last_index_any(text, &alnum) == 170,
+        "wrong index of the first/last char in the set"
+    );
+
+    CyStringView blank = cy_string_view_substring(text, 0, 150);
+    TEST_ASSERT(
+        cy_string_view_index_any(blank, &xy) == -1 &&
+            cy_string_view_last_index_any(blank, &alnum) == -1,
+        "found a char that's not in the string"
+    );
+    print_s("found chars from a set");
+
+    TEST_ASSERT(
+        cy_string_view_span(text, &spaces) == 150 &&
+            cy_string_view_span_not(text, &xy) == 150 &&
+            cy_string_view_span(blank, &spaces) == blank.len,
+        "wrong span lengths"
+    );
+
+    CyStringView trimmed = cy_string_view_trim(text, &spaces);
+    TEST_ASSERT(
+        trimmed.text == text.text + 150 && trimmed.len == 21,
+        "wrong trimmed string (%td chars)", trimmed.len
+    );
+    trimmed = cy_string_view_trim(blank, &spaces);
+    TEST_ASSERT(trimmed.len == 0, "blank string not trimmed to nothing");
+    print_s("spanned and trimmed with a set");
+
+    CyCharSet delims = cy_char_set_create(" ,\t");
+    CyStringView rest = cy_string_view_create_c("  foo,\tbar  ,baz, ");
+    const char *expected[] = {"foo", "bar", "baz"};
+    for (isize i = 0; i < CY_ARRAY_LEN(expected); i++) {
+        CyStringView token = cy_string_view_next_token(&rest, &delims);
+        TEST_ASSERT(
+            cy_string_view_are_equal(
+                token, cy_string_view_create_c(expected[i])
+            ),
+            "wrong token %td", i
+        );
+    }
+
+    TEST_ASSERT(
+        cy_string_view_next_token(&rest, &delims).len == 0,
+        "token found past the last one"
+    );
+    print_s("tokenized string");
+}
+
+static void test_string_search(void)
+{
+    cy_printf("%sTesting Substring Search...%s\n", VT_BOLD, VT_RESET);
+
+    CyStringView text = cy_string_view_create_c(
+        "the cat sat on the mat with the other cat, aaaa"
+    );
+    CyStringView cat = cy_string_view_create_c("cat");
+    CyStringView empty = cy_string_view_create_c("");
+    CyStringView missing = cy_string_view_create_c("dog");
+    TEST_ASSERT(
+        cy_string_view_index(text, cat) == 4 &&
+            cy_string_view_last_index(text, cat) == 38 &&
+            cy_string_view_count(text, cat) == 2,
+        "wrong index/last index/count of a word"
+    );
+    TEST_ASSERT(
+        cy_string_view_index(text, missing) == -1 &&
+            cy_string_view_last_index(text, missing) == -1 &&
+            cy_string_view_count(text, missing) == 0,
+        "found a word that's not in the string"
+    );
+    TEST_ASSERT(
+        cy_string_view_index(text, empty) == 0 &&
+            cy_string_view_last_index(text, empty) == text.len &&
+            cy_string_view_count(text, empty) == text.len + 1,
+        "wrong results for an empty needle"
+    );
+    TEST_ASSERT(
+        cy_string_view_count(text, cy_string_view_create_c("aa")) == 2,
+        "overlapping matches counted"
+    );
+    print_s("searched for short needles");
+
+    // NOTE(cya): the worst case for the SIMD filter (hands over to Two-Way)
+    char haystack[4096], needle[256];
+    cy_mem_set(haystack, 'a', cy_sizeof(haystack));
+    cy_mem_set(needle, 'a', cy_sizeof(needle));
+    needle[128] = 'b';
+    CyStringView hay = cy_string_view_create_len(
+        haystack, cy_sizeof(haystack)
+    );
+    CyStringView long_needle = cy_string_view_create_len(
+        needle, cy_sizeof(needle)
+    );
+    TEST_ASSERT(
+        cy_string_view_index(hay, long_needle) == -1 &&
+            cy_string_view_last_index(hay, long_needle) == -1,
+        "found a long needle that's not in the string"
+    );
+
+    haystack[1000] = 'b', haystack[3000] = 'b';
+    CyStringSearcher searcher = cy_string_searcher_create(long_needle);
+    TEST_ASSERT(
+        cy_string_searcher_index(&searcher, hay) == 1000 - 128 &&
+            cy_string_searcher_last_index(&searcher, hay) == 3000 - 128 &&
+            cy_string_searcher_count(&searcher, hay) == 2,
+        "wrong index/last index/count of a long needle"
+    );
+    print_s("searched for long needles");
+}
+
+typedef struct {
+    CyAhoCorasickMatch matches[16];
+    isize count;
+    isize limit; // NOTE(cya): stops the scan once it has this many
+} AhoCorasickMatches;
+
+static CY_AHO_CORASICK_MATCH_PROC(collect_aho_corasick_match)
+{
+    AhoCorasickMatches *m = user_data;
+    if (m->count < CY_ARRAY_LEN(m->matches)) {
+        m->matches[m->count++] = match;
+    }
+
+    return m->count < m->limit;
+}
+
+static b32 has_aho_corasick_match(
+    const AhoCorasickMatches *m, isize pattern, isize begin, isize end
+) {
+    for (isize i = 0; i < m->count; i++) {
+        CyAhoCorasickMatch match = m->matches[i];
+        if (
+            match.pattern == pattern && match.begin == begin &&
+            match.end == end
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void test_aho_corasick(void)
+{
+    cy_printf("%sTesting Aho-Corasick...%s\n", VT_BOLD, VT_RESET);
+
+    CyArena arena = cy_arena_init(cy_heap_allocator(), 0x4000);
+    CyStringView patterns[] = {
+        cy_string_view_create_c("he"),
+        cy_string_view_create_c("she"),
+        cy_string_view_create_c("his"),
+        cy_string_view_create_c("hers"),
+        cy_string_view_create_c(""),
+        cy_string_view_create_c("he"),
+        cy_string_view_create_c("e"),
+    };
+    CyAhoCorasick ac = cy_aho_corasick_create(
+        &arena, patterns, CY_ARRAY_LEN(patterns)
+    );
+    TEST_ASSERT_NOT_NULL(ac.table, "unable to build matcher");
+    print_s("built matcher for %td patterns", ac.pattern_count);
+
+    AhoCorasickMatches m = {.limit = ISIZE_MAX};
+    CyStringView text = cy_string_view_create_c("ushers");
+    TEST_ASSERT(
+        cy_aho_corasick_find_all(&ac, text, collect_aho_corasick_match, &m),
+        "scan stopped on its own"
+    );
+    TEST_ASSERT(
+        m.count == 5 &&
+            has_aho_corasick_match(&m, 1, 1, 4) &&
+            has_aho_corasick_match(&m, 0, 2, 4) &&
+            has_aho_corasick_match(&m, 5, 2, 4) &&
+            has_aho_corasick_match(&m, 6, 3, 4) &&
+            has_aho_corasick_match(&m, 3, 2, 6),
+        "wrong matches (%td found)", m.count
+    );
+    for (isize i = 1; i < m.count; i++) {
+        TEST_ASSERT(
+            m.matches[i - 1].end <= m.matches[i].end,
+            "matches not reported in order of where they end"
+        );
+    }
+
+    print_s("found overlapping and duplicate patterns");
+
+    m = (AhoCorasickMatches){.limit = ISIZE_MAX};
+    CyAhoCorasickStream stream = {0};
+    cy_aho_corasick_scan(
+        &ac, &stream, cy_string_view_create_c("xush"),
+        collect_aho_corasick_match, &m
+    );
+    TEST_ASSERT(m.count == 0, "match reported before it was complete");
+    cy_aho_corasick_scan(
+        &ac, &stream, cy_string_view_create_c("ers"),
+        collect_aho_corasick_match, &m
+    );
+    TEST_ASSERT(
+        m.count == 5 &&
+            has_aho_corasick_match(&m, 1, 2, 5) &&
+            has_aho_corasick_match(&m, 3, 3, 7),
+        "wrong matches across chunks (%td found)", m.count
+    );
+    print_s("found matches straddling chunks");
+
+    m = (AhoCorasickMatches){.limit = 1};
+    TEST_ASSERT(
+        !cy_aho_corasick_find_all(&ac, text, collect_aho_corasick_match, &m) &&
+            m.count == 1,
+        "scan didn't stop when asked to"
+    );
+    print_s("stopped scan early");
+
+    cy_arena_deinit(&arena);
+}
+
+static void test_string_split(void)
+{
+    cy_printf("%sTesting String Splitting...%s\n", VT_BOLD, VT_RESET);
+
+    const char *expected[] = {"a", "", "b", ""};
+    CyStringView text = cy_string_view_create_c("a,,b,");
+    CyCharSet set = cy_char_set_create(",;");
+    CyStringSplitIter iters[] = {
+        cy_string_split_by_byte(text, ','),
+        cy_string_split_by_separator(text, cy_string_view_create_c(",")),
+        cy_string_split_by_set(text, &set),
+    };
+    for (isize i = 0; i < CY_ARRAY_LEN(iters); i++) {
+        CyStringView token;
+        isize count = 0;
+        while (cy_string_split_next(&iters[i], &token)) {
+            TEST_ASSERT(
+                count < CY_ARRAY_LEN(expected) &&
+                    cy_string_view_are_equal(
+                        token, cy_string_view_create_c(expected[count])
+                    ),
+                "wrong token %td (split kind %td)", count, i
+            );
+            count += 1;
+        }
+
+        TEST_ASSERT(
+            count == CY_ARRAY_LEN(expected),
+            "wrong token count %td (split kind %td)", count, i
+        );
+    }
+
+    print_s("split on a byte, a separator and a set");
+
+    // NOTE(cya): fields of every length from 0 to 24 spanning several blocks
+    char buf[400];
+    isize len = 0, field_count = 25;
+    for (isize i = 0; i < field_count; i++) {
+        cy_mem_set(buf + len, 'x', i);
+        len += i;
+        buf[len++] = (i % 2 == 0) ? ';' : ',';
+    }
+
+    text = cy_string_view_create_len(buf, len - 1);
+    CyStringSplitIter iter = cy_string_split_by_set(text, &set);
+    CyStringView token;
+    isize count = 0;
+    while (cy_string_split_next(&iter, &token)) {
+        TEST_ASSERT(
+            token.len == count && cy_string_view_span_not(token, &set) == count,
+            "wrong token %td (%td chars)", count, token.len
+        );
+        count += 1;
+    }
+
+    TEST_ASSERT(count == field_count, "wrong token count %td", count);
+
+    // NOTE(cya): 12 of each delimiter (and every ';' has an 'x' after it)
+    CyStringSplitIter long_iters[] = {
+        cy_string_split_by_byte(text, ','),
+        cy_string_split_by_separator(text, cy_string_view_create_c(";x")),
+    };
+    for (isize i = 0; i < CY_ARRAY_LEN(long_iters); i++) {
+        count = 0;
+        while (cy_string_split_next(&long_iters[i], &token)) {
+            count += 1;
+        }
+
+        TEST_ASSERT(
+            count == 13, "wrong token count %td (split kind %td)", count, i
+        );
+    }
+
+    print_s("split %td bytes into %td tokens", text.len, field_count);
+}
+
+static void test_hashing(void)
+{
+    cy_printf("%sTesting Hashing...%s\n", VT_BOLD, VT_RESET);
+
+    u8 data[256];
+    for (isize i = 0; i < cy_sizeof(data); i++) {
+        data[i] = (u8)(i * 31 + 7);
+    }
+
+    // NOTE(cya): lengths around the 16 and 48-byte paths, in uneven pieces
+    isize pieces[] = {1, 3, 7, 15, 16, 17, 31, 47, 48, 49};
+    u64 seed = 0x9E3779B97F4A7C15;
+    for (isize len = 0; len <= cy_sizeof(data); len++) {
+        CyHashState state = cy_hash_state_init(seed);
+        isize fed = 0;
+        for (isize i = 0; fed < len; i = (i + 1) % CY_ARRAY_LEN(pieces)) {
+            isize piece = CY_MIN(pieces[i], len - fed);
+            cy_hash_update(&state, data + fed, piece);
+            fed += piece;
+        }
+
+        TEST_ASSERT(
+            cy_hash_final(&state) == cy_hash_bytes_seed(data, len, seed),
+            "streaming hash differs from one-shot hash (%td bytes)", len
+        );
+    }
+
+    TEST_ASSERT(
+        cy_hash_bytes(data, 16) != cy_hash_bytes(data + 1, 16) &&
+            cy_hash_bytes_seed(data, 16, 1) != cy_hash_bytes_seed(data, 16, 2),
+        "hash ignores its input"
+    );
+    print_s("hashed data in pieces");
+
+    const char *check = "123456789";
+    u32 expected = 0xE3069283;
+    TEST_ASSERT(
+        cy_crc32c(0, check, 9) == expected &&
+            ~cy__crc32c_sw(~(u32)0, (const u8*)check, 9) == expected,
+        "wrong CRC-32C check value"
+    );
+#if defined(CY__CRC32C_HW)
+    if (cy__cpu_has_sse42()) {
+        TEST_ASSERT(
+            ~cy__crc32c_hw(~(u32)0, (const u8*)check, 9) == expected,
+            "wrong CRC-32C check value (SSE4.2)"
+        );
+        TEST_ASSERT(
+            cy__crc32c_hw(0, data, 251) == cy__crc32c_sw(0, data, 251),
+            "SSE4.2 and table CRC-32C differ"
+        );
+    }
+#endif
+
+    u32 crc = 0;
+    for (isize i = 0; i < cy_sizeof(data); i += 37) {
+        crc = cy_crc32c(crc, data + i, CY_MIN(37, cy_sizeof(data) - i));
+    }
+
+    TEST_ASSERT(
+        crc == cy_crc32c(0, data, cy_sizeof(data)),
+        "chained CRC-32C differs from one-shot CRC-32C"
+    );
+    print_s("computed CRC-32C (check value 0x%08X)", expected);
+}
+
+static void test_hash_map(void)
+{
+    cy_printf("%sTesting Hash Map...%s\n", VT_BOLD, VT_RESET);
+
+    CyArena arena = cy_arena_init(cy_heap_allocator(), 0x1000);
+    CyAllocator a = cy_arena_allocator(&arena);
+
+    CyHashMap map = cy_hash_map_init_type(a, i32, i64);
+    for (i32 i = 0; i < 1000; i++) {
+        i64 value = (i64)i * i;
+        TEST_ASSERT_NOT_NULL(
+            cy_hash_map_put(&map, &i, &value), "unable to insert key %d", i
+        );
+    }
+
+    TEST_ASSERT(map.len == 1000, "unexpected map length: %td", map.len);
+    print_s("inserted %td keys", map.len);
+
+    for (i32 i = 0; i < 1000; i += 2) {
+        TEST_ASSERT(cy_hash_map_remove(&map, &i), "unable to remove key %d", i);
+    }
+    for (i32 i = 0; i < 1000; i++) {
+        i64 *value = (i64*)cy_hash_map_get(&map, &i);
+        b32 expected = (i % 2) != 0;
+        TEST_ASSERT(
+            (value != NULL) == expected && (!expected || *value == (i64)i * i),
+            "wrong lookup result for key %d", i
+        );
+    }
+
+    print_s("removed every even key, %td left", map.len);
+
+    CyHashMap words = cy_hash_map_init_string_keys(a, cy_sizeof(i32));
+    TEST_ASSERT(cy_hash_map_reserve(&words, 64), "unable to reserve map");
+
+    isize cap = words.cap;
+    CyStringView text = cy_string_view_create_c("a b c a b a");
+    CyStringSplitIter iter = cy_string_split_by_byte(text, ' ');
+    CyStringView word;
+    while (cy_string_split_next(&iter, &word)) {
+        i32 *count = (i32*)cy_hash_map_get_or_insert(&words, &word, NULL);
+        TEST_ASSERT_NOT_NULL(count, "unable to insert word");
+        *count += 1;
+    }
+
+    CyStringView key = cy_string_view_create_c("a");
+    i32 *count = (i32*)cy_hash_map_get(&words, &key);
+    TEST_ASSERT(
+        words.len == 3 && count != NULL && *count == 3,
+        "wrong word counts (%td unique)", words.len
+    );
+    TEST_ASSERT(words.cap == cap, "map grew after reserving");
+
+    print_s("counted words with string view keys");
+
+    cy_hash_map_deinit(&words);
+    cy_hash_map_deinit(&map);
+    cy_arena_deinit(&arena);
+}
+
+static void test_array(void)
+{
+    cy_printf("%sTesting Dynamic Arrays...%s\n", VT_BOLD, VT_RESET);
+
+    CyArena arena = cy_arena_init(cy_heap_allocator(), 0x1000);
+    CyAllocator a = cy_arena_allocator(&arena);
+
+    i32 *arr = cy_array_create(a, i32);
+    TEST_ASSERT_NOT_NULL(arr, "unable to create array");
+
+    i32 *first = arr;
+    for (i32 i = 0; i < 256; i++) {
+        TEST_ASSERT_NOT_NULL(cy_array_push(arr, i), "unable to push %d", i);
+    }
+
+    TEST_ASSERT(
+        cy_array_len(arr) == 256 && arr[255] == 255,
+        "unexpected array length: %td", cy_array_len(arr)
+    );
+    TEST_ASSERT(arr == first, "array moved while growing at the arena's end");
+    print_s("pushed %td items in place", cy_array_len(arr));
+
+    i32 items[] = {-1, -2, -3};
+    TEST_ASSERT_NOT_NULL(
+        cy_array_insert(arr, 1, items, CY_ARRAY_LEN(items)),
+        "unable to insert items"
+    );
+    TEST_ASSERT(
+        arr[0] == 0 && arr[1] == -1 && arr[3] == -3 && arr[4] == 1,
+        "wrong items after inserting"
+    );
+
+    cy_array_remove(arr, 1, CY_ARRAY_LEN(items));
+    cy_array_remove_swap(arr, 0);
+    TEST_ASSERT(
+        arr[0] == 255 && arr[1] == 1 && cy_array_pop(arr) == 254,
+        "wrong items after removing"
+    );
+
+    print_s("inserted and removed items");
+
+    TEST_ASSERT_NOT_NULL(cy_array_shrink(arr), "unable to shrink array");
+    TEST_ASSERT(
+        cy_array_cap(arr) == cy_array_len(arr),
+        "wrong capacity after shrinking: %td", cy_array_cap(arr)
+    );
+
+    print_s("shrunk array to %td items", cy_array_cap(arr));
+
+    cy_array_free(arr);
+    cy_arena_deinit(&arena);
+}
+
+static void test_interner(void)
+{
+    cy_printf("%sTesting String Interning...%s\n", VT_BOLD, VT_RESET);
+
+    CyArena arena = cy_arena_init(cy_heap_allocator(), 0x4000);
+    CyInterner interner = cy_interner_init(&arena);
+
+    CyStringView hello = cy_string_view_create_c("hello");
+    u32 id = cy_interner_intern(&interner, hello);
+    CyStringView interned = cy_interner_intern_view(&interner, hello);
+    TEST_ASSERT(id == 0, "first ID is %u", id);
+    TEST_ASSERT(
+        cy_interner_intern(&interner, cy_string_view_create_c("hello")) == id &&
+            cy_interner_get(&interner, id).text == interned.text &&
+            interned.text != hello.text,
+        "same text got a different ID or copy"
+    );
+    TEST_ASSERT(
+        cy_string_view_are_equal(interned, hello) &&
+            interned.text[interned.len] == '\0',
+        "interned copy differs or isn't NUL-terminated"
+    );
+    TEST_ASSERT(
+        cy_interner_find(&interner, cy_string_view_create_c("world")) ==
+            CY_INTERN_NONE && cy_interner_count(&interner) == 1,
+        "found a string that was never interned"
+    );
+    print_s("interned '%s' as ID %u", (const char*)interned.text, id);
+
+    // NOTE(cya): enough strings to grow the table a few times
+    isize count = 8 * CY__INTERN_MIN_CAP;
+    for (isize i = 1; i < count; i++) {
+        char buf[32];
+        isize len = cy_sprintf(buf, cy_sizeof(buf), "string #%td", i);
+        u32 new_id = cy_interner_intern(
+            &interner, cy_string_view_create_len(buf, len)
+        );
+        TEST_ASSERT(
+            new_id == (u32)i, "IDs aren't dense (%u for %td)", new_id, i
+        );
+    }
+    for (isize i = 1; i < count; i++) {
+        char buf[32];
+        isize len = cy_sprintf(buf, cy_sizeof(buf), "string #%td", i);
+        CyStringView str = cy_string_view_create_len(buf, len);
+        TEST_ASSERT(
+            cy_interner_find(&interner, str) == (u32)i &&
+                cy_string_view_are_equal(
+                    cy_interner_get(&interner, (u32)i), str
+                ),
+            "lost string #%td after growing", i
+        );
+    }
+
+    TEST_ASSERT(
+        cy_interner_count(&interner) == count &&
+            cy_interner_get(&interner, id).text == interned.text,
+        "interner changed after growing"
+    );
+    print_s("interned %td strings", count);
+
+    cy_arena_deinit(&arena);
+}
+
 int main(void)
 {
     test_page_allocator();
     test_arena_allocator();
     test_stack_allocator();
     test_pool_allocator();
+    test_tracking_allocator();
+    test_c_strings();
     test_cy_strings();
+    test_char_sets();
+    test_string_search();
+    test_aho_corasick();
+    test_string_split();
+    test_hashing();
+    test_hash_map();
+    test_interner();
+    test_array();
 
     return exit_code;
 }